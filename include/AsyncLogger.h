@@ -0,0 +1,165 @@
+#pragma once
+#include "SpscRing.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+enum class LogOverflowPolicy {
+    DROP,   // discard the record and count it
+    BLOCK   // spin until the background thread frees a slot
+};
+
+enum class LogArgType : std::uint8_t {
+    INT,
+    UINT,
+    DOUBLE,
+    TEXT
+};
+
+constexpr std::size_t LOG_MAX_ARGS = 8;
+constexpr std::size_t LOG_TEXT_BYTES = 168;
+
+// One log call: a pointer to the (literal) format string plus the raw argument
+// values. Strings are copied into the record's text area, truncated if needed.
+// Formatting happens on the background thread.
+struct LogRecord {
+    const char* format;
+    std::uint8_t argCount;
+    std::uint8_t textUsed;
+    LogArgType types[LOG_MAX_ARGS];
+    union Value {
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+        struct { std::uint8_t offset; std::uint8_t length; } text;
+    } values[LOG_MAX_ARGS];
+    char text[LOG_TEXT_BYTES];
+};
+static_assert(sizeof(LogRecord) == 256, "LogRecord should stay four cache lines");
+
+// Asynchronous logger. Each producing thread gets its own SPSC ring, so logging
+// is a handful of stores plus one release store; a background thread drains all
+// rings, formats "{}" / "{:.Nf}" placeholders and writes whole batches.
+class AsyncLogger {
+public:
+    static constexpr std::size_t RING_CAPACITY = 1024;  // records per thread
+    static constexpr std::size_t MAX_THREADS = 64;
+    using Ring = SpscRing<LogRecord, RING_CAPACITY>;
+    
+private:
+    struct ThreadRing {
+        Ring ring;
+        std::atomic<bool> inUse{false};
+    };
+    
+    std::unique_ptr<ThreadRing> rings[MAX_THREADS];
+    std::atomic<std::size_t> ringCount{0};
+    std::mutex registrationMutex;
+    
+    std::mutex outputMutex;
+    std::ostream* output;
+    
+    std::atomic<LogOverflowPolicy> policy{LogOverflowPolicy::BLOCK};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<std::uint64_t> passes{0};
+    std::atomic<bool> running{true};
+    std::thread worker;
+    
+    AsyncLogger();
+    
+    Ring* threadRing();
+    void run();
+    bool drainOnce(std::string& buffer);
+    static void formatRecord(const LogRecord& record, std::string& out);
+    
+    // Argument encoding
+    static void encode(LogRecord& r, std::string_view s) {
+        std::size_t room = LOG_TEXT_BYTES - r.textUsed;
+        std::size_t length = (s.size() < room) ? s.size() : room;
+        if (length > 255) length = 255;
+        std::memcpy(r.text + r.textUsed, s.data(), length);
+        r.types[r.argCount] = LogArgType::TEXT;
+        r.values[r.argCount].text = {r.textUsed, static_cast<std::uint8_t>(length)};
+        r.textUsed = static_cast<std::uint8_t>(r.textUsed + length);
+    }
+    static void encode(LogRecord& r, const char* s) { encode(r, std::string_view(s)); }
+    static void encode(LogRecord& r, const std::string& s) { encode(r, std::string_view(s)); }
+    
+    template <typename T>
+    static void encode(LogRecord& r, T value) {
+        static_assert(std::is_arithmetic_v<T>, "unsupported log argument type");
+        if constexpr (std::is_floating_point_v<T>) {
+            r.types[r.argCount] = LogArgType::DOUBLE;
+            r.values[r.argCount].d = value;
+        } else if constexpr (std::is_signed_v<T>) {
+            r.types[r.argCount] = LogArgType::INT;
+            r.values[r.argCount].i = value;
+        } else {
+            r.types[r.argCount] = LogArgType::UINT;
+            r.values[r.argCount].u = value;
+        }
+    }
+    
+    template <typename T>
+    static void encodeNext(LogRecord& r, const T& value) {
+        if (r.argCount == LOG_MAX_ARGS) return;
+        encode(r, value);
+        r.argCount++;
+    }
+    
+public:
+    ~AsyncLogger();
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+    
+    static AsyncLogger& instance();
+    
+    // format must be a string literal; it is read later by the background thread
+    template <std::size_t N, typename... Args>
+    void log(const char (&format)[N], const Args&... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "too many log arguments");
+        Ring* ring = threadRing();
+        if (ring == nullptr) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        
+        auto fill = [&](LogRecord& r) {
+            r.format = format;
+            r.argCount = 0;
+            r.textUsed = 0;
+            (encodeNext(r, args), ...);
+        };
+        while (!ring->tryEmplace(fill)) {
+            if (policy.load(std::memory_order_relaxed) == LogOverflowPolicy::DROP) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+    
+    // Wait until every record logged before this call has been written
+    void flush();
+    
+    void setPolicy(LogOverflowPolicy newPolicy) { policy.store(newPolicy); }
+    // Flushes, then redirects output (std::cout by default)
+    void setOutput(std::ostream& out);
+    // Pin the background thread to a housekeeping core; false if not permitted
+    bool pinWorker(int core);
+    
+    std::uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+};
+
+template <std::size_t N, typename... Args>
+inline void logAsync(const char (&format)[N], const Args&... args) {
+    AsyncLogger::instance().log(format, args...);
+}
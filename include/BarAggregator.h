@@ -0,0 +1,88 @@
+#pragma once
+#include "MarketEvents.h"
+#include "TickStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class Strategy;
+
+// How a bar series decides that a bar is complete
+enum class BarType : std::uint8_t {
+    TIME,    // fixed clock intervals, size in ns
+    TICK,    // every `size` trades
+    VOLUME   // once `size` shares have traded (the crossing trade stays in the bar)
+};
+
+struct BarSpec {
+    BarType type;
+    std::int64_t size;
+    
+    static BarSpec seconds(std::int64_t n) { return {BarType::TIME, n * NANOS_PER_SECOND}; }
+    static BarSpec minutes(std::int64_t n) { return {BarType::TIME, n * 60 * NANOS_PER_SECOND}; }
+    static BarSpec ticks(std::int64_t n) { return {BarType::TICK, n}; }
+    static BarSpec volume(std::int64_t n) { return {BarType::VOLUME, n}; }
+};
+
+// Builds OHLCV bars for every (symbol, spec) pair in O(1) per tick and keeps
+// the most recent completed bars of each series in a fixed ring. Completed
+// bars are also pushed to subscribers as they close. Time bars close on the
+// first tick of a later interval (or closeElapsed()); intervals without
+// trades produce no bar.
+class BarAggregator {
+public:
+    // spec is the bar's position in specs()
+    using BarHandler = std::function<void(const Bar& bar, std::size_t spec)>;
+    
+private:
+    // In-progress bar and ring cursor of one (symbol, spec) series
+    struct Series {
+        Bar current;
+        std::int64_t bucket = 0;      // time bars: interval index of current
+        std::uint64_t completed = 0;  // bars closed so far; ring slot = completed & mask
+    };
+    
+    std::vector<BarSpec> barSpecs;
+    std::size_t capacity;               // ring size per series, power of two
+    std::vector<Series> series;         // symbol-major: series[symbol * specs + slot]
+    std::vector<Bar> history;           // rings, series-major: history[index * capacity + n]
+    std::vector<BarHandler> handlers;
+    std::uint64_t totalCompleted = 0;
+    
+    // Catch-up cursor for update()
+    std::uint64_t sourceGeneration = 0;
+    std::size_t processed = 0;
+    
+    void complete(std::size_t index);
+    void open(Series& s, const Tick& tick, std::int64_t start);
+    
+public:
+    static constexpr std::size_t DEFAULT_HISTORY = 64;
+    
+    // historyPerSeries is rounded up to a power of two. Throws
+    // std::invalid_argument for a spec whose size is not positive.
+    explicit BarAggregator(std::vector<BarSpec> specs, std::size_t historyPerSeries = DEFAULT_HISTORY);
+    
+    void onTick(const Tick& tick);
+    // Close time bars whose interval ended at or before now, for quiet symbols
+    void closeElapsed(std::int64_t now);
+    void reset();
+    
+    // Catch up on rows of the store not seen yet; a replaced store starts over
+    void update(const TickStore& ticks);
+    
+    void subscribe(BarHandler handler) { handlers.push_back(std::move(handler)); }
+    void subscribe(Strategy& strategy);
+    
+    const std::vector<BarSpec>& specs() const { return barSpecs; }
+    std::size_t historyPerSeries() const { return capacity; }
+    std::uint64_t completedBars() const { return totalCompleted; }
+    
+    // Completed bars still held for one series (at most historyPerSeries())
+    std::size_t barCount(SymbolId symbol, std::size_t spec) const;
+    // ago = 0 is the most recently completed bar; requires ago < barCount()
+    const Bar& bar(SymbolId symbol, std::size_t spec, std::size_t ago = 0) const;
+    // The bar still being built, nullptr if the series has no open bar
+    const Bar* current(SymbolId symbol, std::size_t spec) const;
+};
@@ -0,0 +1,44 @@
+#pragma once
+#include "TickStore.h"
+#include <cstdint>
+#include <string>
+
+// Binary tick file layout (version 2, native little-endian):
+//
+//   TickFileHeader
+//   symbol dictionary: per symbol { uint32 rowCount; uint16 nameLength; char name[] }
+//   column blocks, each 64-byte aligned:
+//     int64  timestamps[rowCount]   (ns since midnight)
+//     uint32 symbolIds[rowCount]    (dictionary positions, translated to global IDs on load)
+//     int64  prices[rowCount]       (fixed-point Price, 1/10,000 units)
+//     int32  volumes[rowCount]
+//     uint32 symbolRows[rowCount]   (row numbers grouped by symbol, in dictionary order)
+//
+// Loading is a validated bulk copy of each block; no field is parsed.
+constexpr char TICK_FILE_MAGIC[8] = {'H', 'F', 'T', 'T', 'I', 'C', 'K', '\0'};
+// Version 1 stored prices as doubles and is no longer accepted
+constexpr std::uint32_t TICK_FILE_VERSION = 2;
+
+struct TickFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t symbolCount;
+    std::uint64_t rowCount;
+    std::uint64_t dictionaryOffset;
+    std::uint64_t timestampOffset;
+    std::uint64_t symbolIdOffset;
+    std::uint64_t priceOffset;
+    std::uint64_t volumeOffset;
+    std::uint64_t symbolRowsOffset;
+};
+
+bool writeBinaryTicks(const std::string& path, const TickStore& store);
+
+// Replaces the contents of store with the file's ticks
+bool loadBinaryTicks(const std::string& path, TickStore& store);
+
+// True if the file starts with the binary tick magic
+bool isBinaryTickFile(const std::string& path);
+
+// Convert a market_data.csv-style file to the binary format
+bool convertCsvToBinary(const std::string& csvPath, const std::string& binaryPath);
@@ -0,0 +1,70 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+constexpr std::int64_t NANOS_PER_SECOND = 1000000000LL;
+
+// Process-wide nanosecond clock. Timestamps are int64 nanoseconds since the
+// Unix epoch: anchored to CLOCK_REALTIME once at calibration, then advanced
+// by the invariant TSC at the CLOCK_MONOTONIC rate, so they never step
+// backwards and reading one is a single rdtsc plus a multiply. Without an
+// invariant TSC it falls back to clock_gettime(CLOCK_MONOTONIC).
+class Clock {
+private:
+    struct Calibration {
+        std::uint64_t baseTicks = 0;
+        std::int64_t baseNanos = 0;      // epoch ns at baseTicks
+        std::uint64_t nanosPerTick = 0;  // 32.32 fixed point
+        std::int64_t monotonicOffset = 0; // epoch ns minus CLOCK_MONOTONIC ns
+        bool tsc = false;
+    };
+    static Calibration state;
+    
+    static std::int64_t monotonicNanos() {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec * NANOS_PER_SECOND + ts.tv_nsec;
+    }
+    
+public:
+    // Measures the TSC rate against CLOCK_MONOTONIC over roughly the given
+    // interval. Runs once during static initialization; call again to
+    // re-anchor (not thread-safe against concurrent readers).
+    static void calibrate(std::int64_t intervalNanos = 20000000);
+    
+    // Raw cycle counter; only differences are meaningful
+    static std::uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+        if (state.tsc) return __rdtsc();
+#endif
+        return static_cast<std::uint64_t>(monotonicNanos());
+    }
+    
+    static std::int64_t ticksToNanos(std::uint64_t tickDelta) {
+        if (!state.tsc) return static_cast<std::int64_t>(tickDelta);
+        return static_cast<std::int64_t>((static_cast<unsigned __int128>(tickDelta) * state.nanosPerTick) >> 32);
+    }
+    
+    // Nanoseconds since the Unix epoch
+    static std::int64_t now() {
+        if (!state.tsc) return monotonicNanos() + state.monotonicOffset;
+        return state.baseNanos + ticksToNanos(ticks() - state.baseTicks);
+    }
+    
+    static bool usingTsc() { return state.tsc; }
+    static double ticksPerMicrosecond() {
+        return state.tsc ? 1000.0 * 4294967296.0 / static_cast<double>(state.nanosPerTick) : 1000.0;
+    }
+};
+
+// "YYYY-MM-DD HH:MM:SS.nnnnnnnnn" in local time, for display and logs only
+std::string formatTimestamp(std::int64_t epochNanos);
+
+// "HH:MM:SS[.fraction]" <-> nanoseconds since midnight (market data times)
+bool parseTimeOfDay(std::string_view text, std::int64_t& nanos);
+std::string formatTimeOfDay(std::int64_t nanos);
@@ -3,7 +3,9 @@
 #include <vector>
 #include <map>
 #include <functional>
+#include "FlatIdMap.h"
 #include "MarketData.h"
+#include "MemoryPool.h"
 #include "Order.h"
 
 struct ExchangeCredentials {
@@ -13,33 +15,51 @@ struct ExchangeCredentials {
     bool sandboxMode = true; // Start in test mode
 };
 
+// Display form of an exchange order, built on demand by getOpenOrders();
+// the exchange itself keeps open orders as pooled Order records
 struct ExchangeOrder {
-    std::string exchangeOrderId;
-    std::string symbol;
+    OrderId exchangeOrderId;
+    SymbolId symbol;
     std::string side; // "buy" or "sell"
     double quantity;
-    double price;
-    std::string status; // "open", "filled", "cancelled"
-    std::string timestamp;
+    double filledQuantity;
+    Price price;
+    std::string status; // OrderStatus name, e.g. "ACKED" or "PARTIALLY_FILLED"
+    std::int64_t timestamp; // ns since epoch (Clock::now)
+};
+
+// Execution report for one fill of an exchange order
+struct VenueFill {
+    OrderId exchangeOrderId;
+    std::int64_t quantity;
+    Price price;
 };
 
 // Base class for all exchange connections
 class ExchangeAPI {
 public:
+    using FillHandler = std::function<void(const VenueFill&)>;
+    
     virtual ~ExchangeAPI() = default;
     
     // Authentication
     virtual bool authenticate(const ExchangeCredentials& creds) = 0;
     
     // Market data
-    virtual bool getMarketPrice(const std::string& symbol, double& price) = 0;
+    virtual bool getMarketPrice(const std::string& symbol, Price& price) = 0;
     virtual bool subscribeToMarketData(const std::string& symbol) = 0;
     
     // Order management
-    virtual std::string placeOrder(const std::string& symbol, const std::string& side, 
-                                 double quantity, double price) = 0;
-    virtual bool cancelOrder(const std::string& orderId) = 0;
+    // Exchange-assigned ID of the new order, INVALID_ORDER_ID if it was rejected
+    virtual OrderId placeOrder(const std::string& symbol, const std::string& side, 
+                               double quantity, Price price) = 0;
+    virtual bool cancelOrder(OrderId orderId) = 0;
+    // Change size and/or price of a working order in place, keeping its ID
+    virtual bool amendOrder(OrderId orderId, double quantity, Price price) = 0;
     virtual std::vector<ExchangeOrder> getOpenOrders() = 0;
+    // Called for every execution, possibly before placeOrder has returned
+    // the order's ID (nullptr stops the reports)
+    void setFillHandler(FillHandler handler) { fillHandler = std::move(handler); }
     
     // Account info
     virtual bool getAccountBalance(std::map<std::string, double>& balances) = 0;
@@ -51,26 +71,45 @@ public:
 protected:
     std::string lastError;
     bool connected = false;
+    FillHandler fillHandler;
 };
 
 // Simulated exchange for testing (before connecting to real exchanges)
 class SimulatedExchange : public ExchangeAPI {
 private:
-    std::map<std::string, double> accountBalances;
-    std::vector<ExchangeOrder> openOrders;
-    std::map<std::string, double> marketPrices;
-    int nextOrderId = 1;
+    // Per-asset simulation state, indexed by SymbolId (cash is an asset too)
+    struct Instrument {
+        Price funds;              // the cash instrument, exact to the Price scale
+        std::int64_t shares = 0;  // everything else, whole shares
+        bool held = false;        // reported by getAccountBalance
+        Price marketPrice;
+        bool quoted = false;      // has a market price
+        Price tickSize = Price::fromRaw(Price::SCALE / 100);
+    };
+    std::vector<Instrument> instruments;
+    const SymbolId cash;
+    MemoryPool<Order, 1 << 16> orderPool;
+    FlatIdMap<Order*> openOrders;   // keyed by exchange order ID
+    bool immediateFills = true;     // fill every order in full on placement
+    
+    Instrument& instrument(SymbolId symbol);
+    // The open order behind an exchange order ID, nullptr if none
+    Order* findOpen(OrderId orderId);
+    void close(Order* order);
     
 public:
     SimulatedExchange();
+    SimulatedExchange(const SimulatedExchange&) = delete;
+    SimulatedExchange& operator=(const SimulatedExchange&) = delete;
     
     bool authenticate(const ExchangeCredentials& creds) override;
-    bool getMarketPrice(const std::string& symbol, double& price) override;
+    bool getMarketPrice(const std::string& symbol, Price& price) override;
     bool subscribeToMarketData(const std::string& symbol) override;
     
-    std::string placeOrder(const std::string& symbol, const std::string& side, 
-                          double quantity, double price) override;
-    bool cancelOrder(const std::string& orderId) override;
+    OrderId placeOrder(const std::string& symbol, const std::string& side, 
+                       double quantity, Price price) override;
+    bool cancelOrder(OrderId orderId) override;
+    bool amendOrder(OrderId orderId, double quantity, Price price) override;
     std::vector<ExchangeOrder> getOpenOrders() override;
     
     bool getAccountBalance(std::map<std::string, double>& balances) override;
@@ -78,6 +117,11 @@ public:
     std::string getLastError() const override;
     
     // Simulation helpers
-    void setMarketPrice(const std::string& symbol, double price);
-    void simulateOrderFill(const std::string& orderId);
+    void setMarketPrice(const std::string& symbol, Price price);
+    void setTickSize(const std::string& symbol, Price tickSize);
+    void setCash(Price amount);
+    void setShares(const std::string& symbol, std::int64_t shares);
+    void setImmediateFills(bool enabled) { immediateFills = enabled; }
+    // Execute part of an open order (quantity 0 means all of what is left)
+    bool simulateOrderFill(OrderId orderId, double quantity = 0);
 };
@@ -17,11 +17,11 @@ public:
     bool isConnected() const;
     
     // Live market data
-    bool getLivePrice(const std::string& symbol, double& price);
+    bool getLivePrice(const std::string& symbol, Price& price);
     
     // Live order execution
-    std::string executeLiveOrder(const std::string& symbol, const std::string& side, 
-                               double quantity, double price);
+    OrderId executeLiveOrder(const std::string& symbol, const std::string& side, 
+                             double quantity, Price price);
     
     // Account management
     void showAccountBalance();
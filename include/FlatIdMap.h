@@ -0,0 +1,123 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Open-addressing hash map from 64-bit IDs to small values: one flat slot
+// array, linear probing and backward-shift deletion, so lookups touch one or
+// two cache lines and erasing leaves no tombstones. Capacity is a power of
+// two and doubles at 50% load. UINT64_MAX is reserved as the empty key.
+template <typename V>
+class FlatIdMap {
+public:
+    static constexpr std::uint64_t EMPTY_KEY = UINT64_MAX;
+    
+private:
+    struct Slot {
+        std::uint64_t key;
+        V value;
+    };
+    
+    std::vector<Slot> slots;
+    std::size_t mask;
+    std::size_t count = 0;
+    
+    // 64-bit finalizer from MurmurHash3; sequential IDs spread over all slots
+    static std::size_t hash(std::uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return static_cast<std::size_t>(key);
+    }
+    
+    std::size_t slotOf(std::uint64_t key) const {
+        std::size_t i = hash(key) & mask;
+        while (slots[i].key != key && slots[i].key != EMPTY_KEY) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+    
+    void rehash(std::size_t capacity) {
+        std::vector<Slot> old(capacity, Slot{EMPTY_KEY, V()});
+        old.swap(slots);
+        mask = capacity - 1;
+        for (const Slot& slot : old) {
+            if (slot.key != EMPTY_KEY) slots[slotOf(slot.key)] = slot;
+        }
+    }
+    
+public:
+    explicit FlatIdMap(std::size_t initialCapacity = 1024) {
+        std::size_t capacity = 16;
+        while (capacity < initialCapacity) capacity *= 2;
+        slots.assign(capacity, Slot{EMPTY_KEY, V()});
+        mask = capacity - 1;
+    }
+    
+    // nullptr when the key is absent
+    V* find(std::uint64_t key) {
+        if (key == EMPTY_KEY) return nullptr;
+        Slot& slot = slots[slotOf(key)];
+        return slot.key == key ? &slot.value : nullptr;
+    }
+    const V* find(std::uint64_t key) const {
+        if (key == EMPTY_KEY) return nullptr;
+        const Slot& slot = slots[slotOf(key)];
+        return slot.key == key ? &slot.value : nullptr;
+    }
+    
+    // false (and no change) when the key is already present
+    bool insert(std::uint64_t key, V value) {
+        if ((count + 1) * 2 > slots.size()) rehash(slots.size() * 2);
+        Slot& slot = slots[slotOf(key)];
+        if (slot.key == key) return false;
+        slot.key = key;
+        slot.value = std::move(value);
+        count++;
+        return true;
+    }
+    
+    bool erase(std::uint64_t key) {
+        if (key == EMPTY_KEY) return false;
+        std::size_t hole = slotOf(key);
+        if (slots[hole].key != key) return false;
+        
+        // Shift later members of the probe run back so no lookup hits a gap
+        std::size_t next = (hole + 1) & mask;
+        while (slots[next].key != EMPTY_KEY) {
+            std::size_t home = hash(slots[next].key) & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                slots[hole] = std::move(slots[next]);
+                hole = next;
+            }
+            next = (next + 1) & mask;
+        }
+        slots[hole].key = EMPTY_KEY;
+        count--;
+        return true;
+    }
+    
+    void reserve(std::size_t entries) {
+        std::size_t capacity = slots.size();
+        while (entries * 2 > capacity) capacity *= 2;
+        if (capacity != slots.size()) rehash(capacity);
+    }
+    
+    void clear() {
+        for (Slot& slot : slots) slot.key = EMPTY_KEY;
+        count = 0;
+    }
+    
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    
+    // Visit every entry as fn(key, value), in slot order
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const Slot& slot : slots) {
+            if (slot.key != EMPTY_KEY) fn(slot.key, slot.value);
+        }
+    }
+};
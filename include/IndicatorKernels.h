@@ -0,0 +1,57 @@
+#pragma once
+#include "Price.h"
+#include <cstddef>
+#include <cstdint>
+
+// Instruction sets the batch kernels are built for. SCALAR is plain C++
+// compiled for the x86-64 baseline, so it runs on any machine regardless of
+// the -march the rest of the program was built with.
+enum class SimdLevel {
+    SCALAR,
+    AVX2,
+    AVX512
+};
+
+const char* simdLevelName(SimdLevel level);
+
+// One set of batch indicator kernels over contiguous columns. Fixed-point
+// inputs are raw Price units (Price::raw()). Series outputs have n entries;
+// rolling outputs are 0.0 until the window has filled, like RollingWindow.
+struct IndicatorKernels {
+    SimdLevel level;
+    
+    double (*sum)(const double* x, std::size_t n);
+    std::int64_t (*sumFixed)(const std::int64_t* raw, std::size_t n);
+    void (*minMax)(const double* x, std::size_t n, double& low, double& high);
+    void (*minMaxFixed)(const std::int64_t* raw, std::size_t n, std::int64_t& low, std::int64_t& high);
+    // Volume-weighted average price (0.0 when the volume is zero)
+    double (*vwap)(const double* price, const int* volume, std::size_t n);
+    double (*vwapFixed)(const std::int64_t* raw, const int* volume, std::size_t n);
+    // out[i] = x[i + 1] / x[i] - 1, n - 1 entries
+    void (*returns)(const double* x, std::size_t n, double* out);
+    void (*rollingMean)(const double* x, std::size_t n, std::size_t window, double* out);
+    // Population standard deviation over each window
+    void (*rollingStddev)(const double* x, std::size_t n, std::size_t window, double* out);
+    // out[0] = x[0], out[i] = out[i - 1] + alpha * (x[i] - out[i - 1])
+    void (*ema)(const double* x, std::size_t n, double alpha, double* out);
+    // Price::toDouble() over a whole column
+    void (*toDouble)(const std::int64_t* raw, std::size_t n, double* out);
+};
+
+// Highest level both the CPU and this build support (checked once)
+SimdLevel bestSimdLevel();
+bool simdLevelSupported(SimdLevel level);
+
+// Kernels for a specific level (falls back to SCALAR if unsupported)
+const IndicatorKernels& indicatorKernels(SimdLevel level);
+// Kernels for bestSimdLevel()
+const IndicatorKernels& indicatorKernels();
+
+// Price columns are stored as bare int64s (see the static_assert in Price.h)
+inline const std::int64_t* rawPrices(const Price* prices) {
+    return reinterpret_cast<const std::int64_t*>(prices);
+}
+
+inline Price sumPrices(const Price* prices, std::size_t n) {
+    return Price::fromRaw(indicatorKernels().sumFixed(rawPrices(prices), n));
+}
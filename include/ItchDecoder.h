@@ -0,0 +1,215 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+// NASDAQ TotalView-ITCH 5.0 style messages as stored in capture files: every
+// message is preceded by a 2-byte big-endian length. Fields are big-endian and
+// read straight out of the (usually mmapped) buffer through thin views, so
+// decoding never copies a message. Prices have 4 implied decimals, the same
+// scale as Price, and timestamps are 6-byte ns since midnight.
+namespace itch {
+
+inline std::uint16_t be16(const char* p) {
+    std::uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return __builtin_bswap16(v);
+}
+inline std::uint32_t be32(const char* p) {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return __builtin_bswap32(v);
+}
+inline std::uint64_t be48(const char* p) {
+    return (static_cast<std::uint64_t>(be16(p)) << 32) | be32(p + 2);
+}
+inline std::uint64_t be64(const char* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return __builtin_bswap64(v);
+}
+
+// Space-padded alpha field without the padding
+inline std::string_view alpha(const char* p, std::size_t width) {
+    while (width > 0 && p[width - 1] == ' ') width--;
+    return std::string_view(p, width);
+}
+
+// Header shared by every message
+struct MessageView {
+    const char* data;
+    
+    explicit MessageView(const char* message) : data(message) {}
+    char type() const { return data[0]; }
+    std::uint16_t stockLocate() const { return be16(data + 1); }
+    std::uint16_t trackingNumber() const { return be16(data + 3); }
+    std::int64_t timestamp() const { return static_cast<std::int64_t>(be48(data + 5)); }
+};
+
+struct SystemEvent : MessageView {  // 'S'
+    static constexpr std::size_t LENGTH = 12;
+    using MessageView::MessageView;
+    char eventCode() const { return data[11]; }
+};
+
+struct StockDirectory : MessageView {  // 'R'
+    static constexpr std::size_t LENGTH = 39;
+    using MessageView::MessageView;
+    std::string_view stock() const { return alpha(data + 11, 8); }
+    std::uint32_t roundLotSize() const { return be32(data + 21); }
+};
+
+struct AddOrder : MessageView {  // 'A'
+    static constexpr std::size_t LENGTH = 36;
+    using MessageView::MessageView;
+    std::uint64_t orderRef() const { return be64(data + 11); }
+    bool isBuy() const { return data[19] == 'B'; }
+    std::uint32_t shares() const { return be32(data + 20); }
+    std::string_view stock() const { return alpha(data + 24, 8); }
+    std::uint32_t price() const { return be32(data + 32); }
+};
+
+struct AddOrderMpid : AddOrder {  // 'F'
+    static constexpr std::size_t LENGTH = 40;
+    using AddOrder::AddOrder;
+    std::string_view attribution() const { return alpha(data + 36, 4); }
+};
+
+struct OrderExecuted : MessageView {  // 'E'
+    static constexpr std::size_t LENGTH = 31;
+    using MessageView::MessageView;
+    std::uint64_t orderRef() const { return be64(data + 11); }
+    std::uint32_t executedShares() const { return be32(data + 19); }
+    std::uint64_t matchNumber() const { return be64(data + 23); }
+};
+
+struct OrderExecutedWithPrice : OrderExecuted {  // 'C'
+    static constexpr std::size_t LENGTH = 36;
+    using OrderExecuted::OrderExecuted;
+    bool printable() const { return data[31] == 'Y'; }
+    std::uint32_t executionPrice() const { return be32(data + 32); }
+};
+
+struct OrderCancel : MessageView {  // 'X'
+    static constexpr std::size_t LENGTH = 23;
+    using MessageView::MessageView;
+    std::uint64_t orderRef() const { return be64(data + 11); }
+    std::uint32_t cancelledShares() const { return be32(data + 19); }
+};
+
+struct OrderDelete : MessageView {  // 'D'
+    static constexpr std::size_t LENGTH = 19;
+    using MessageView::MessageView;
+    std::uint64_t orderRef() const { return be64(data + 11); }
+};
+
+struct OrderReplace : MessageView {  // 'U'
+    static constexpr std::size_t LENGTH = 35;
+    using MessageView::MessageView;
+    std::uint64_t originalOrderRef() const { return be64(data + 11); }
+    std::uint64_t newOrderRef() const { return be64(data + 19); }
+    std::uint32_t shares() const { return be32(data + 27); }
+    std::uint32_t price() const { return be32(data + 31); }
+};
+
+struct Trade : MessageView {  // 'P', executions against non-displayed orders
+    static constexpr std::size_t LENGTH = 44;
+    using MessageView::MessageView;
+    std::uint64_t orderRef() const { return be64(data + 11); }
+    bool isBuy() const { return data[19] == 'B'; }
+    std::uint32_t shares() const { return be32(data + 20); }
+    std::string_view stock() const { return alpha(data + 24, 8); }
+    std::uint32_t price() const { return be32(data + 32); }
+    std::uint64_t matchNumber() const { return be64(data + 36); }
+};
+
+// No-op handlers. Derive from this and hide the ones you need; the decoder
+// calls them on the derived type, so there is no virtual dispatch.
+struct Handler {
+    void onSystemEvent(const SystemEvent&) {}
+    void onStockDirectory(const StockDirectory&) {}
+    void onAddOrder(const AddOrder&) {}
+    void onAddOrderMpid(const AddOrderMpid&) {}
+    void onOrderExecuted(const OrderExecuted&) {}
+    void onOrderExecutedWithPrice(const OrderExecutedWithPrice&) {}
+    void onOrderCancel(const OrderCancel&) {}
+    void onOrderDelete(const OrderDelete&) {}
+    void onOrderReplace(const OrderReplace&) {}
+    void onTrade(const Trade&) {}
+    void onOther(const MessageView&) {}  // every other message type
+};
+
+// Message type -> (minimum length, handler thunk), built at compile time
+template <typename H>
+struct DispatchTable {
+    struct Entry {
+        std::uint16_t length;  // 0 = type without a view
+        void (*handle)(H&, const char*);
+    };
+    
+    template <typename Msg, auto Method>
+    static constexpr Entry entry() {
+        return {static_cast<std::uint16_t>(Msg::LENGTH), [](H& h, const char* p) { (h.*Method)(Msg(p)); }};
+    }
+    
+    static constexpr std::array<Entry, 256> build() {
+        std::array<Entry, 256> table{};
+        for (Entry& e : table) {
+            e = {0, [](H& h, const char* p) { h.onOther(MessageView(p)); }};
+        }
+        table['S'] = entry<SystemEvent, &H::onSystemEvent>();
+        table['R'] = entry<StockDirectory, &H::onStockDirectory>();
+        table['A'] = entry<AddOrder, &H::onAddOrder>();
+        table['F'] = entry<AddOrderMpid, &H::onAddOrderMpid>();
+        table['E'] = entry<OrderExecuted, &H::onOrderExecuted>();
+        table['C'] = entry<OrderExecutedWithPrice, &H::onOrderExecutedWithPrice>();
+        table['X'] = entry<OrderCancel, &H::onOrderCancel>();
+        table['D'] = entry<OrderDelete, &H::onOrderDelete>();
+        table['U'] = entry<OrderReplace, &H::onOrderReplace>();
+        table['P'] = entry<Trade, &H::onTrade>();
+        return table;
+    }
+    
+    static constexpr std::array<Entry, 256> table = build();
+};
+
+struct DecodeResult {
+    std::uint64_t messages = 0;
+    std::uint64_t unknown = 0;    // types passed to onOther()
+    std::uint64_t malformed = 0;  // shorter than their type requires (skipped)
+    std::size_t bytesConsumed = 0;
+    bool complete = false;        // false if the buffer ends mid-message
+};
+
+// Decode every length-prefixed message in [begin, end)
+template <typename H>
+DecodeResult decode(const char* begin, const char* end, H& handler) {
+    DecodeResult result;
+    const char* p = begin;
+    while (end - p >= 2) {
+        const std::size_t length = be16(p);
+        if (static_cast<std::size_t>(end - p) - 2 < length) break;
+        const char* message = p + 2;
+        p += 2 + length;
+        
+        if (length == 0) {
+            result.malformed++;
+            continue;
+        }
+        const auto& entry = DispatchTable<H>::table[static_cast<unsigned char>(message[0])];
+        if (length < entry.length) {
+            result.malformed++;
+            continue;
+        }
+        result.unknown += (entry.length == 0);
+        entry.handle(handler, message);
+        result.messages++;
+    }
+    result.bytesConsumed = static_cast<std::size_t>(p - begin);
+    result.complete = (p == end);
+    return result;
+}
+
+} // namespace itch
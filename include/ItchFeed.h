@@ -0,0 +1,60 @@
+#pragma once
+#include "ItchDecoder.h"
+#include "L3OrderBook.h"
+#include "TickStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Builds platform state from a decoded ITCH stream: an L3OrderBook per stock
+// (with its L2 view) and a TickStore row for every printable execution and
+// trade. Stocks are interned into the tick store's symbol table the first
+// time a directory entry or add order names them.
+class ItchBookBuilder : public itch::Handler {
+private:
+    TickStore& ticks;
+    Price tickSize;
+    std::vector<SymbolId> locateSymbols;  // by stock locate, INVALID_SYMBOL until named
+    std::vector<std::unique_ptr<L3OrderBook>> books;  // by SymbolId
+    std::uint64_t rejected = 0;  // events the book refused (unknown refs, off-tick prices)
+    
+    SymbolId nameLocate(std::uint16_t locate, std::string_view stock);
+    SymbolId symbolOf(std::uint16_t locate) const;
+    L3OrderBook* bookOf(std::uint16_t locate);
+    void addOrder(const itch::AddOrder& message);
+    void recordTrade(std::int64_t timestamp, SymbolId symbol, Price price, std::uint32_t shares);
+    
+public:
+    explicit ItchBookBuilder(TickStore& tickStore, Price bookTickSize = Price::fromRaw(Price::SCALE / 100));
+    
+    void onStockDirectory(const itch::StockDirectory& message);
+    void onAddOrder(const itch::AddOrder& message) { addOrder(message); }
+    void onAddOrderMpid(const itch::AddOrderMpid& message) { addOrder(message); }
+    void onOrderExecuted(const itch::OrderExecuted& message);
+    void onOrderExecutedWithPrice(const itch::OrderExecutedWithPrice& message);
+    void onOrderCancel(const itch::OrderCancel& message);
+    void onOrderDelete(const itch::OrderDelete& message);
+    void onOrderReplace(const itch::OrderReplace& message);
+    void onTrade(const itch::Trade& message);
+    
+    // nullptr for symbols without orders
+    const L3OrderBook* book(SymbolId symbol) const;
+    const L3OrderBook* book(std::string_view symbol) const { return book(ticks.symbolTable().find(symbol)); }
+    std::uint64_t rejectedEvents() const { return rejected; }
+};
+
+// mmap an ITCH file and decode all of it into builder.
+// Returns false if the file cannot be opened or ends mid-message.
+bool loadItchFile(const std::string& path, ItchBookBuilder& builder, itch::DecodeResult* result = nullptr);
+
+// Capture files are recognised by their .itch extension (the format has no magic)
+bool isItchFile(const std::string& path);
+
+// Write a synthetic capture: a start-of-messages event, a directory entry per
+// symbol, then `messages` order-flow messages interleaved across the symbols
+// (adds with and without MPID, executions with and without price, cancels,
+// deletes and replaces), each symbol driven by its own SyntheticOrderFlow.
+bool generateItchFile(const std::string& path, std::size_t messages, std::size_t symbols = 8, unsigned seed = 1);
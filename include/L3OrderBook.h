@@ -0,0 +1,124 @@
+#pragma once
+#include "Clock.h"
+#include "FlatIdMap.h"
+#include "MarketEvents.h"
+#include "MemoryPool.h"
+#include "OrderBook.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct L3Level;
+
+// One resting order, linked into its price level's FIFO queue
+struct L3Order {
+    std::uint64_t id;
+    std::int64_t timestamp;  // ns, when it joined the queue
+    Price price;
+    std::int64_t quantity;   // open shares
+    BookSide side;
+    L3Order* prev;
+    L3Order* next;
+    L3Level* level;
+};
+
+// All orders at one price of one side, oldest first
+struct L3Level {
+    Price price;
+    BookSide side;
+    std::int64_t quantity;   // sum of the orders' open shares
+    std::uint32_t orders;
+    L3Order* head;
+    L3Order* tail;
+};
+
+// Order-by-order book for one symbol. Orders and levels come from pools, each
+// level keeps its orders in an intrusive FIFO list, and flat hash maps index
+// orders by ID and levels by price, so every event is O(1). The L2 view is
+// kept in an OrderBook, updated with the new level total on every change.
+class L3OrderBook {
+private:
+    MemoryPool<L3Order, 1 << 16> orderPool;
+    MemoryPool<L3Level, 1 << 16> levelPool;
+    FlatIdMap<L3Order*> orderIndex;
+    FlatIdMap<L3Level*> levelIndex;  // keyed by levelKey(side, price)
+    OrderBook aggregate;
+    std::uint64_t executedShares = 0;
+    
+    static std::uint64_t levelKey(BookSide side, Price price) {
+        return (static_cast<std::uint64_t>(price.raw()) << 1) | (side == BookSide::ASK ? 1 : 0);
+    }
+    
+    L3Level* levelFor(BookSide side, Price price);
+    void link(L3Order* order, L3Level* level);
+    // Take shares off an order; unlinks and frees it when nothing is left
+    void reduce(L3Order* order, std::int64_t shares);
+    
+public:
+    explicit L3OrderBook(Price tickSize = Price::fromRaw(Price::SCALE / 100),
+                         std::size_t levelsPerSide = OrderBook::DEFAULT_LEVELS);
+    L3OrderBook(const L3OrderBook&) = delete;
+    L3OrderBook& operator=(const L3OrderBook&) = delete;
+    
+    // Each returns false (and changes nothing) for unknown or duplicate IDs,
+    // non-positive sizes and prices off the tick grid
+    bool add(std::uint64_t id, BookSide side, Price price, std::int64_t quantity, std::int64_t timestamp = 0);
+    bool cancel(std::uint64_t id, std::int64_t shares);   // partial cancel, removes at zero
+    bool remove(std::uint64_t id);
+    bool execute(std::uint64_t id, std::int64_t shares);
+    // Same ID: a size decrease at the same price keeps queue priority,
+    // anything else sends the order to the back of its new level
+    bool modify(std::uint64_t id, Price price, std::int64_t quantity, std::int64_t timestamp = 0);
+    bool replace(std::uint64_t id, std::uint64_t newId, Price price, std::int64_t quantity, std::int64_t timestamp = 0);
+    bool apply(const OrderBookEvent& event);
+    void clear();
+    
+    // nullptr for unknown IDs
+    const L3Order* find(std::uint64_t id) const;
+    const L3Level* level(BookSide side, Price price) const;
+    // Shares queued ahead of an order at its level (-1 for unknown IDs)
+    std::int64_t queueAhead(std::uint64_t id) const;
+    
+    std::size_t orderCount() const { return orderIndex.size(); }
+    std::uint64_t sharesExecuted() const { return executedShares; }
+    
+    // Aggregated L2 view, always in step with the orders
+    const OrderBook& levels() const { return aggregate; }
+};
+
+// Synthetic order flow for one symbol: adds, cancels, deletes, executions and
+// replaces within 25 ticks either side of `centre`, with the live order count
+// kept near `liveOrders`. Every event refers to an order that is live at that
+// point, and bids stay below asks so the book never crosses.
+class SyntheticOrderFlow {
+private:
+    struct LiveOrder {
+        std::uint64_t id;
+        BookSide side;
+        Price price;
+        std::int64_t shares;
+    };
+    
+    static constexpr Price TICK = Price::fromRaw(Price::SCALE / 100);
+    
+    std::vector<LiveOrder> live;
+    SymbolId symbol;
+    std::size_t targetLive;
+    unsigned seed;
+    std::int64_t midTicks;
+    std::uint64_t nextId = 1;
+    std::int64_t timestamp;  // ns since midnight, from 09:30
+    
+    unsigned random();
+    Price priceFor(BookSide side, unsigned r) const;
+    
+public:
+    explicit SyntheticOrderFlow(SymbolId symbolId = 0, std::size_t liveOrders = 5000, unsigned randomSeed = 1,
+                                Price centre = Price::fromRaw(100 * Price::SCALE));
+    
+    OrderBookEvent next();
+};
+
+// `count` events of one SyntheticOrderFlow
+void synthesizeOrderFlow(std::size_t count, std::vector<OrderBookEvent>& out, SymbolId symbol = 0,
+                         std::size_t liveOrders = 5000, unsigned seed = 1);
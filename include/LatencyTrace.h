@@ -0,0 +1,149 @@
+#pragma once
+#include "Clock.h"
+#include "OrderId.h"
+#include "SpscRing.h"
+#include "SymbolTable.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+
+// Points on the tick-to-trade path, in the order a tick passes them
+enum class TraceStage : std::uint8_t {
+    FEED_RECEIVE,       // tick handed to the pipeline
+    STRATEGY_DECISION,  // strategy finished with the tick
+    RISK_CHECK,         // pre-trade risk answered
+    GATEWAY_SEND,       // order recorded locally, about to leave for the venue
+    EXCHANGE_ACK,       // venue answered (ack or reject)
+    COUNT
+};
+
+constexpr std::size_t TRACE_STAGES = static_cast<std::size_t>(TraceStage::COUNT);
+
+// One tick, or one order it led to, on its way through the pipeline. Stamps
+// are raw Clock::ticks() values so stamping is a single rdtsc; 0 marks a
+// stage the record never reached (a tick without orders stops at the
+// decision, a risk reject at the check).
+struct alignas(64) TraceRecord {
+    std::uint64_t stamps[TRACE_STAGES] = {};
+    OrderId orderId = INVALID_ORDER_ID;  // local order, INVALID for ticks that led to none
+    SymbolId symbol = INVALID_SYMBOL;
+    
+    void stamp(TraceStage stage) { stamps[static_cast<std::size_t>(stage)] = Clock::ticks(); }
+    bool reached(TraceStage stage) const { return stamps[static_cast<std::size_t>(stage)] != 0; }
+};
+static_assert(sizeof(TraceRecord) == 64, "TraceRecord should stay one cache line");
+
+// Log-linear latency histogram in nanoseconds: exact below 64ns, then 32
+// sub-buckets per power of two (about 3% resolution) up to ~18 minutes.
+// Fixed size, so recording never allocates.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr std::size_t BUCKETS = 64 + 35 * 32;
+    
+private:
+    std::array<std::uint64_t, BUCKETS> counts{};
+    std::uint64_t total = 0;
+    std::int64_t minimum = 0;
+    std::int64_t maximum = 0;
+    double sum = 0.0;
+    
+    static std::size_t bucketOf(std::int64_t nanos);
+    static std::int64_t bucketLow(std::size_t bucket);
+    
+public:
+    void record(std::int64_t nanos);
+    void merge(const LatencyHistogram& other);
+    void clear() { *this = LatencyHistogram(); }
+    
+    std::uint64_t count() const { return total; }
+    std::int64_t min() const { return minimum; }
+    std::int64_t max() const { return maximum; }
+    double mean() const { return total ? sum / total : 0.0; }
+    // Upper edge of the bucket holding the p-quantile, capped at the maximum seen
+    std::int64_t percentile(double p) const;
+    
+    // Visit non-empty buckets as fn(lowNanos, highNanos, count), fastest first
+    template <typename Fn>
+    void forEachBucket(Fn&& fn) const {
+        for (std::size_t i = 0; i < BUCKETS; i++) {
+            if (counts[i] != 0) fn(bucketLow(i), bucketLow(i + 1) - 1, counts[i]);
+        }
+    }
+};
+
+// Latency between two stages of a record
+struct TraceSpan {
+    const char* name;
+    TraceStage from;
+    TraceStage to;
+};
+
+constexpr TraceSpan TRACE_SPANS[] = {
+    {"feed_to_decision", TraceStage::FEED_RECEIVE, TraceStage::STRATEGY_DECISION},
+    {"decision_to_risk", TraceStage::STRATEGY_DECISION, TraceStage::RISK_CHECK},
+    {"risk_to_send", TraceStage::RISK_CHECK, TraceStage::GATEWAY_SEND},
+    {"send_to_ack", TraceStage::GATEWAY_SEND, TraceStage::EXCHANGE_ACK},
+    {"tick_to_trade", TraceStage::FEED_RECEIVE, TraceStage::GATEWAY_SEND},
+    {"tick_to_ack", TraceStage::FEED_RECEIVE, TraceStage::EXCHANGE_ACK},
+};
+constexpr std::size_t TRACE_SPAN_COUNT = sizeof(TRACE_SPANS) / sizeof(TRACE_SPANS[0]);
+
+// Collects trace records from any number of threads. Each submitting thread
+// gets its own SPSC ring, so submit() is one copy and a release store and
+// never blocks; a full ring drops the record and counts it. collect() drains
+// every ring into per-span histograms and is meant for a housekeeping thread
+// or the gaps between bursts.
+class LatencyTracer {
+public:
+    static constexpr std::size_t RING_CAPACITY = 4096;  // records per thread
+    static constexpr std::size_t MAX_THREADS = 64;
+    using Ring = SpscRing<TraceRecord, RING_CAPACITY>;
+    
+private:
+    struct ThreadRing {
+        Ring ring;
+        std::atomic<bool> inUse{false};
+    };
+    
+    std::unique_ptr<ThreadRing> rings[MAX_THREADS];
+    std::atomic<std::size_t> ringCount{0};
+    std::mutex registrationMutex;
+    
+    std::mutex collectMutex;  // one consumer at a time; guards everything below
+    std::array<LatencyHistogram, TRACE_SPAN_COUNT> spans;
+    std::uint64_t tickRecords = 0;   // records without an order
+    std::uint64_t orderRecords = 0;
+    std::atomic<std::uint64_t> dropped{0};
+    
+    LatencyTracer() = default;
+    Ring* threadRing();
+    void aggregate(const TraceRecord& record);
+    
+public:
+    LatencyTracer(const LatencyTracer&) = delete;
+    LatencyTracer& operator=(const LatencyTracer&) = delete;
+    
+    static LatencyTracer& instance();
+    
+    // Producer side; false if the record was dropped
+    bool submit(const TraceRecord& record);
+    // Drain all rings into the histograms; returns the number of records taken
+    std::size_t collect();
+    // Drain and discard everything, then start from empty histograms
+    void reset();
+    
+    // Snapshot of one span's histogram (call collect() first)
+    LatencyHistogram span(std::size_t index);
+    std::uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    
+    // Human-readable table of every span
+    void report(std::ostream& out);
+    // JSON: record counts, then per span the summary and its non-empty
+    // buckets as [lowNs, highNs, count]
+    void dump(std::ostream& out);
+};
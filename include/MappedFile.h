@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file.
+// The mapping is released when the object goes out of scope.
+class MappedFile {
+private:
+    const char* mapped = nullptr;
+    std::size_t length = 0;
+    bool opened = false;
+    
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+    
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    
+    // Map the file; an empty file opens successfully with size() == 0
+    bool open(const std::string& path);
+    void close();
+    
+    bool isOpen() const { return opened; }
+    const char* data() const { return mapped; }
+    const char* end() const { return mapped + length; }
+    std::size_t size() const { return length; }
+};
@@ -1,16 +1,42 @@
 #pragma once
+#include "Price.h"
+#include "SymbolTable.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 using namespace std;
 
+class TickStore;
+class RollingIndicatorEngine;
+class TickIndex;
+class OrderBookManager;
+
 struct MarketData {
-    string Time;
-    string Abb;
-    double price;
+    int64_t Time;  // ns since midnight
+    SymbolId Abb = INVALID_SYMBOL;  // global ID, symbolName() for the ticker
+    Price price;
     int volume;
 };
-bool loadData(vector<MarketData>& data);
+// Default location of the sample tick file, relative to the build directory
+inline const string DEFAULT_MARKET_DATA_PATH = "../src/market_data/market_data.csv";
+
+bool loadData(vector<MarketData>& data, const string& path = DEFAULT_MARKET_DATA_PATH);
+// Original ifstream/stringstream loader, kept as the benchmark baseline
+bool loadDataStream(vector<MarketData>& data, const string& path = DEFAULT_MARKET_DATA_PATH);
+// Accepts CSV, the binary tick format or a compressed tick archive (both
+// detected from the file header), or an ITCH capture (.itch, executions and
+// trades only; the overload below keeps its books)
+bool loadData(TickStore& ticks, const string& path = DEFAULT_MARKET_DATA_PATH);
+// Same, and seeds the books: an ITCH capture keeps the books its order flow
+// built, trade-only formats start from the depth their trades imply
+bool loadData(TickStore& ticks, OrderBookManager& books, const string& path);
 double calculateMovingAverage(const vector<MarketData>& data, const string& symbol, int periods);
+double calculateMovingAverage(const TickStore& ticks, const string& symbol, int periods);
 void showPriceData(const vector<MarketData>& data, const string& symbol);
+void showPriceData(const TickStore& ticks, const string& symbol);
+// Count, volume, VWAP and TWAP of one symbol with from <= time < to; index catches up on ticks first
+void showRangeStats(TickIndex& index, const TickStore& ticks, const string& symbol, int64_t from, int64_t to);
 void generateSignal(const vector<MarketData>& data, const string& symbol);
+// indicators must track the 2- and 3-period windows; it catches up on ticks first
+void generateSignal(RollingIndicatorEngine& indicators, const TickStore& ticks, const string& symbol);
 void showMenu();
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include "Order.h"
+#include "Price.h"
+#include "SymbolTable.h"
+#include <cstdint>
+
+// One trade print delivered to strategies
+struct Tick {
+    std::int64_t timestamp;  // ns
+    SymbolId symbol;
+    Price price;
+    int volume;
+};
+
+enum class BookSide : std::uint8_t {
+    BID,
+    ASK
+};
+
+// Level-2 depth change: the total quantity now resting at one price level
+// of one side (0 removes the level)
+struct BookUpdate {
+    std::int64_t timestamp;  // ns
+    SymbolId symbol;
+    BookSide side;
+    Price price;
+    std::int64_t quantity;
+};
+
+enum class OrderEventType : std::uint8_t {
+    ADD,
+    CANCEL,   // reduce a resting order by `quantity`
+    DELETE,   // remove a resting order
+    EXECUTE,  // `quantity` of a resting order traded
+    REPLACE   // remove orderId, add newOrderId with a new price and size
+};
+
+// Order-by-order (L3) market data message
+struct OrderBookEvent {
+    std::int64_t timestamp;  // ns
+    SymbolId symbol;
+    OrderEventType type;
+    BookSide side;           // ADD only; other events use the resting order's side
+    std::uint64_t orderId;
+    std::uint64_t newOrderId;  // REPLACE only
+    Price price;             // ADD and REPLACE; EXECUTE: the resting order's price
+    std::int64_t quantity;
+};
+
+// OHLCV bar of one symbol (see BarAggregator)
+struct Bar {
+    std::int64_t start;    // ns: interval start for time bars, first trade otherwise
+    std::int64_t end;      // ns of the last trade in the bar
+    SymbolId symbol;
+    std::uint32_t ticks;   // trades in the bar, 0 while no bar is open
+    Price open;
+    Price high;
+    Price low;
+    Price close;
+    std::int64_t volume;
+};
+
+// Execution report for an order a strategy asked for
+struct Fill {
+    OrderId orderId;
+    SymbolId symbol;
+    OrderType side;
+    int quantity;
+    Price price;
+    std::int64_t timestamp;  // ns
+};
+
+// An order a strategy wants placed; risk checks and routing happen downstream
+struct OrderIntent {
+    SymbolId symbol;
+    OrderType side;
+    int quantity;
+    Price price;
+};
@@ -1,51 +1,126 @@
 #pragma once
+#include "FlatIdMap.h"
+#include "MemoryPool.h"
+#include "OrderId.h"
+#include "OrderState.h"
+#include "Price.h"
+#include "SymbolTable.h"
+#include <cstddef>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
-#include <ctime>
+#include <cstdint>
 
-enum class OrderType {
+class OrderJournal;
+
+enum class OrderType : std::uint8_t {
     BUY,
     SELL
 };
 
-enum class OrderStatus {
-    PENDING,
-    FILLED,
-    CANCELLED
-};
-
-class Order {
-private:
-    static int nextOrderId;  // Auto-increment order IDs
-    
+// Hot order record: exactly one cache line, no owning members, so orders are
+// copied with memcpy and live in pools and flat arrays without touching the
+// heap. Names and formatted times are derived only when an order is shown.
+class alignas(64) Order {
 public:
-    int orderId;
-    std::string symbol;
+    std::int64_t timestamp;  // ns since epoch (Clock::now)
+    Price price;
+    std::int64_t quantity;        // current order size, including what has filled
+    std::int64_t filledQuantity;  // cumulative
+    OrderId orderId;
+    SymbolId symbol;
     OrderType type;
-    int quantity;
-    double price;
     OrderStatus status;
-    std::string timestamp;
+    // Intrusive links for whichever container owns the order (unset otherwise)
+    Order* prev = nullptr;
+    Order* next = nullptr;
     
-    // Constructor
-    Order(const std::string& symbol, OrderType type, int quantity, double price);
+    // Constructor; orders without an explicit ID take the next local one
+    Order(OrderId orderId, SymbolId symbol, OrderType type, std::int64_t quantity, Price price);
+    Order(SymbolId symbol, OrderType type, std::int64_t quantity, Price price)
+        : Order(nextOrderId(), symbol, type, quantity, price) {}
+    Order(std::string_view symbol, OrderType type, std::int64_t quantity, Price price)
+        : Order(internSymbol(symbol), type, quantity, price) {}
+    Order(std::string_view symbol, OrderType type, std::int64_t quantity, double price)
+        : Order(internSymbol(symbol), type, quantity, Price::fromDouble(price)) {}
+    
+    std::int64_t leaves() const { return quantity - filledQuantity; }
+    
+    // Move through the shared state table; false (order untouched) if the
+    // event is not allowed in the current status
+    bool onEvent(OrderEvent event);
+    // Record an execution: FILL when it takes the remaining quantity, PARTIAL_FILL otherwise
+    bool onFill(std::int64_t fillQuantity);
+    // Replace size and price in place under the same ID, via PENDING_REPLACE.
+    // Shrinking at the same price keeps the order's time priority; a new
+    // price or a larger size re-stamps it, as a venue would requeue it, with
+    // `stampAt` when given (journal replay) or the current time.
+    bool amend(std::int64_t newQuantity, Price newPrice, std::int64_t stampAt = 0);
     
     // Display order details
     void displayOrder() const;
     
     // Get order type as string
-    std::string getTypeString() const;
-    std::string getStatusString() const;
+    std::string_view getTypeString() const;
+    std::string_view getStatusString() const;
 };
 
-// Order Manager class
+static_assert(sizeof(Order) == 64 && std::is_trivially_copyable_v<Order>,
+              "Order must stay one trivially copyable cache line");
+
+// Keeps live orders in pooled slots indexed by ID and linked per symbol, so
+// lookup, cancel and fill are O(1) and a symbol's orders are walked without
+// touching anyone else's. Orders that reach a terminal status are copied to
+// an append-only archive and their slot is reused, which keeps the live
+// working set small no matter how long the session runs.
 class OrderManager {
 private:
-    std::vector<Order> orders;
+    // Live orders of one symbol, linked through Order::prev/next in placement order
+    struct SymbolOrders {
+        Order* head = nullptr;
+        Order* tail = nullptr;
+        std::size_t count = 0;
+    };
+    
+    MemoryPool<Order, 1 << 16> pool;
+    FlatIdMap<Order*> liveIndex;
+    std::vector<SymbolOrders> bySymbol;    // indexed by SymbolId
+    std::vector<Order> archive;            // terminal orders, in the order they finished
+    FlatIdMap<std::size_t> archiveIndex;   // orderId -> position in archive
+    std::vector<std::vector<std::uint32_t>> archivedBySymbol;  // archive positions per SymbolId
+    OrderJournal* journal = nullptr;       // optional write-ahead log of every change
+    
+    // Append a new live order to its symbol's list and the index
+    void link(Order* order);
+    // Report a change the journal could not take; always false
+    bool refuseUnjournaled(OrderId orderId) const;
+    // Unlink a live order that reached a terminal status, archive it and free the slot
+    void retire(Order* order);
     
 public:
-    // Place a new order
-    void placeOrder(const std::string& symbol, OrderType type, int quantity, double price);
+    OrderManager() = default;
+    OrderManager(const OrderManager&) = delete;
+    OrderManager& operator=(const OrderManager&) = delete;
+    
+    // Place a new order; returns its ID (INVALID_ORDER_ID if it could not be journaled)
+    OrderId placeOrder(SymbolId symbol, OrderType type, std::int64_t quantity, Price price);
+    OrderId placeOrder(std::string_view symbol, OrderType type, std::int64_t quantity, Price price) {
+        return placeOrder(internSymbol(symbol), type, quantity, price);
+    }
+    
+    // Re-create an order from the journal with its original ID and time,
+    // quietly; false if an order with that ID is live
+    bool restoreOrder(OrderId orderId, SymbolId symbol, OrderType type, std::int64_t quantity, Price price,
+                      std::int64_t timestamp);
+    
+    // Make room for `orders` more archived orders up front (bulk loads, replay)
+    void reserveArchive(std::size_t orders);
+    
+    // Journal every change from now on (nullptr stops it). Changes are
+    // journaled before they are applied, and refused when the journal
+    // cannot take them.
+    void attachJournal(OrderJournal* orderJournal) { journal = orderJournal; }
     
     // Show all orders
     void showAllOrders() const;
@@ -53,6 +128,32 @@ public:
     // Show orders for specific symbol
     void showOrdersForSymbol(const std::string& symbol) const;
     
-    // Cancel an order by ID
-    bool cancelOrder(int orderId);
+    // Cancel or fill a live order by ID; false if it is unknown, already done
+    // or the state machine does not allow it. fillOrder without a quantity
+    // fills whatever is left.
+    bool cancelOrder(OrderId orderId);
+    bool fillOrder(OrderId orderId);
+    bool fillOrder(OrderId orderId, std::int64_t quantity);
+    // Amend size and price in place; the order keeps its ID and its place in the symbol's list
+    bool amendOrder(OrderId orderId, std::int64_t quantity, Price price, std::int64_t stampAt = 0);
+    // Any other venue answer (ack, reject, cancel/replace responses); terminal orders are archived
+    bool applyEvent(OrderId orderId, OrderEvent event);
+    
+    // Live or archived order, nullptr for unknown IDs
+    const Order* findOrder(OrderId orderId) const;
+    
+    std::size_t liveCount() const { return liveIndex.size(); }
+    std::size_t liveCount(SymbolId symbol) const {
+        return (symbol < bySymbol.size()) ? bySymbol[symbol].count : 0;
+    }
+    const std::vector<Order>& archivedOrders() const { return archive; }
+    
+    // Visit the live orders of one symbol, oldest first
+    template <typename Fn>
+    void forEachLive(SymbolId symbol, Fn&& fn) const {
+        if (symbol >= bySymbol.size()) return;
+        for (const Order* order = bySymbol[symbol].head; order != nullptr; order = order->next) {
+            fn(*order);
+        }
+    }
 };
@@ -0,0 +1,115 @@
+#pragma once
+#include "MarketEvents.h"
+#include "Price.h"
+#include "SymbolTable.h"
+#include "TickStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+struct BookLevel {
+    Price price;
+    std::int64_t quantity;
+};
+
+// Level-2 book for one symbol. Each side is a flat array of aggregate
+// quantities indexed by price in ticks over a fixed window of levels, plus an
+// occupancy bitmap so the next best level is found 64 levels at a time.
+// Updates inside the window are O(1). An update that improves a side past the
+// window re-centres it on the touch; levels deeper than the window are not kept.
+class OrderBook {
+public:
+    static constexpr std::size_t DEFAULT_LEVELS = 4096;
+    
+private:
+    struct SideLevels {
+        std::vector<std::int64_t> quantity;  // per slot, 0 = empty
+        std::vector<std::uint64_t> occupied; // one bit per slot
+        std::int64_t best = -1;              // slot of the touch, -1 when empty
+        std::size_t levels = 0;              // occupied slots
+    };
+    
+    Price tick;
+    std::size_t capacity;       // slots per side (power of two)
+    std::int64_t baseTick = 0;  // price of slot 0, in ticks
+    SideLevels bids;
+    SideLevels asks;
+    std::uint64_t dropped = 0;  // updates outside the window
+    
+    SideLevels& sideOf(BookSide side) { return side == BookSide::BID ? bids : asks; }
+    const SideLevels& sideOf(BookSide side) const { return side == BookSide::BID ? bids : asks; }
+    Price priceOf(std::int64_t slot) const { return tick * (baseTick + slot); }
+    
+    std::int64_t slotFor(BookSide side, std::int64_t tickIndex, bool adding);
+    void setSlot(BookSide side, std::int64_t slot, std::int64_t quantity);
+    void recentre(std::int64_t centreTick);
+    
+public:
+    explicit OrderBook(Price tickSize = Price::fromRaw(Price::SCALE / 100), std::size_t levels = DEFAULT_LEVELS);
+    
+    // Set the total quantity at a level (0 removes it). Returns false for
+    // off-tick prices, negative quantities and levels deeper than the window.
+    bool update(BookSide side, Price price, std::int64_t quantity);
+    bool apply(const BookUpdate& change) { return update(change.side, change.price, change.quantity); }
+    // Add delta to the quantity at a level (for order-by-order feeds)
+    bool adjust(BookSide side, Price price, std::int64_t delta);
+    void clear();
+    
+    bool hasBid() const { return bids.best >= 0; }
+    bool hasAsk() const { return asks.best >= 0; }
+    // Price() / 0 when the side is empty
+    Price bestBid() const { return hasBid() ? priceOf(bids.best) : Price(); }
+    Price bestAsk() const { return hasAsk() ? priceOf(asks.best) : Price(); }
+    std::int64_t bestBidQuantity() const { return hasBid() ? bids.quantity[bids.best] : 0; }
+    std::int64_t bestAskQuantity() const { return hasAsk() ? asks.quantity[asks.best] : 0; }
+    // Midpoint of the touch, or the only side present
+    Price mid() const;
+    Price spread() const { return (hasBid() && hasAsk()) ? bestAsk() - bestBid() : Price(); }
+    
+    std::int64_t quantityAt(BookSide side, Price price) const;
+    std::size_t levelCount(BookSide side) const { return sideOf(side).levels; }
+    
+    // Best `maxLevels` levels of one side, best first; returns how many were written
+    std::size_t depth(BookSide side, BookLevel* out, std::size_t maxLevels) const;
+    std::vector<BookLevel> depth(BookSide side, std::size_t maxLevels) const;
+    
+    Price tickSize() const { return tick; }
+    std::size_t windowLevels() const { return capacity; }
+    std::uint64_t droppedUpdates() const { return dropped; }
+};
+
+// One OrderBook per symbol, indexed by SymbolId and created on first update
+class OrderBookManager {
+private:
+    const SymbolTable* symbols;
+    std::vector<std::unique_ptr<OrderBook>> books;
+    Price tick;
+    std::size_t levels;
+    
+public:
+    explicit OrderBookManager(const SymbolTable& symbolNames, Price tickSize = Price::fromRaw(Price::SCALE / 100),
+                              std::size_t levelsPerSide = OrderBook::DEFAULT_LEVELS);
+    
+    bool apply(const BookUpdate& update) { return book(update.symbol).apply(update); }
+    OrderBook& book(SymbolId symbol);
+    // Replace a symbol's book with a copy of `levels` (its tick size and window included)
+    void assign(SymbolId symbol, const OrderBook& levels);
+    
+    // nullptr for symbols that never had an update
+    const OrderBook* find(SymbolId symbol) const;
+    const OrderBook* find(std::string_view symbol) const { return find(symbols->find(symbol)); }
+    
+    const SymbolTable& symbolTable() const { return *symbols; }
+};
+
+// Depth implied by a trade-only tape: after each trade, `levels` bid and ask
+// levels one tick apart around the trade price, replacing that symbol's
+// previous ladder. Lets the book path run on the tick files the platform loads.
+void synthesizeDepth(const TickStore& ticks, std::vector<BookUpdate>& out, std::size_t levels = 5,
+                     Price tickSize = Price::fromRaw(Price::SCALE / 100));
+// The books that feed leaves behind, applied straight to the manager: only
+// each symbol's last ladder, so memory does not grow with the tape
+void synthesizeDepth(const TickStore& ticks, OrderBookManager& books, std::size_t levels = 5,
+                     Price tickSize = Price::fromRaw(Price::SCALE / 100));
@@ -0,0 +1,158 @@
+#pragma once
+#include "Order.h"
+#include "OrderId.h"
+#include "OrderState.h"
+#include "Price.h"
+#include "SymbolTable.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class RiskManager;
+
+inline const std::string DEFAULT_JOURNAL_PATH = "order_journal.bin";
+
+enum class JournalKind : std::uint8_t {
+    SYMBOL,    // binds a SymbolId to its name for the records that follow
+    PLACE,     // new order: ID, side, quantity, price, timestamp
+    FILL,      // execution of `quantity` against an order
+    AMEND,     // new quantity and price, with the timestamp the order ended up with
+    EVENT,     // any other lifecycle event (ack, reject, cancel/replace answers)
+    POSITION   // a fill booked by the risk manager: side, quantity, price
+};
+
+// One journal entry, a cache line each. The checksum covers everything after
+// it and the sequence numbers run 1, 2, 3... without gaps, so recovery stops
+// at the first record that was torn by a crash or never written.
+struct alignas(64) JournalRecord {
+    std::uint64_t checksum;
+    std::uint64_t sequence;
+    std::int64_t timestamp;
+    SymbolId symbol;
+    JournalKind kind;
+    OrderType type;
+    OrderEvent event;
+    std::uint8_t nameLength;  // SYMBOL only
+    union {
+        struct {
+            OrderId orderId;
+            std::int64_t price;  // Price raw value
+            std::int64_t quantity;
+            std::int64_t reserved;
+        };
+        char name[32];  // SYMBOL only
+    };
+};
+static_assert(sizeof(JournalRecord) == 64 && std::is_trivially_copyable_v<JournalRecord>,
+              "JournalRecord should stay one trivially copyable cache line");
+
+struct JournalReplayStats {
+    std::size_t records = 0;
+    std::size_t orders = 0;     // PLACE records
+    std::size_t fills = 0;
+    std::size_t positions = 0;  // POSITION records
+    std::size_t rejected = 0;   // records the managers refused (should stay 0)
+    std::int64_t nanos = 0;
+};
+
+// Write-ahead journal of order events and fills in a preallocated, memory
+// mapped file. Appending a record is a memcpy into the mapping and a release
+// store, with no system call; a background thread msyncs the new pages every
+// flush interval, and doubles the file once more than half of it is used.
+// The file is mapped into an address range reserved up front, so growing
+// never moves it under the writer. Opening an existing journal finds the end
+// of its valid records, and replay() rebuilds an OrderManager and a
+// RiskManager's positions from them.
+//
+// A record that does not fit (the flusher could not grow the file in time,
+// or the disk is full) is not written: the record call returns false, the
+// journal is marked failed() and the drop counted, and the managers refuse
+// the change that could not be journaled.
+//
+// Records are appended by one thread, the one that owns the order manager;
+// only the flusher runs alongside it.
+class OrderJournal {
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = std::size_t(1) << 18;  // records (16 MB), grows from there
+    static constexpr std::size_t MAX_BYTES = std::size_t(1) << 36;        // address space reserved for growth
+    static constexpr std::size_t HEADER_SIZE = 64;
+    static constexpr std::size_t MAX_SYMBOL_LENGTH = 32;
+    
+private:
+    int fd = -1;
+    char* mapped = nullptr;                // start of the MAX_BYTES reservation
+    std::atomic<std::size_t> length{0};    // bytes of file mapped (header + record slots); grown by the flusher
+    
+    // Writer only
+    std::size_t writeOffset = 0;      // where the next record goes
+    std::size_t writeLimit = 0;       // last length seen; re-read only when a record does not fit
+    std::uint64_t nextSequence = 1;
+    std::vector<bool> declared;       // SymbolIds with a SYMBOL record in this session
+    std::uint64_t dropped = 0;
+    
+    std::atomic<std::size_t> published{0};  // end of the records the flusher may sync
+    std::size_t synced = 0;                 // guarded by syncMutex
+    std::mutex syncMutex;                   // one msync at a time (flusher and sync())
+    std::chrono::microseconds flushInterval{1000};
+    std::atomic<bool> running{false};
+    std::mutex wakeMutex;
+    std::condition_variable wake;           // cuts the flusher's sleep short on close
+    std::thread flusher;
+    
+    bool append(JournalRecord& record);
+    bool declare(SymbolId symbol);
+    bool grow();
+    void growIfNeeded();
+    void syncPublished();
+    void run();
+    
+public:
+    OrderJournal() = default;
+    ~OrderJournal();
+    
+    OrderJournal(const OrderJournal&) = delete;
+    OrderJournal& operator=(const OrderJournal&) = delete;
+    
+    // Open or create the journal, preallocating room for `capacity` records,
+    // and start the flusher. An existing journal keeps its records; anything
+    // after the last valid one is cleared so new records follow on.
+    bool open(const std::string& path, std::size_t capacity = DEFAULT_CAPACITY,
+              std::chrono::microseconds flushEvery = std::chrono::microseconds(1000));
+    // Stop the flusher, sync everything and unmap
+    void close();
+    bool isOpen() const { return mapped != nullptr; }
+    
+    // Hot path, called by the managers the journal is attached to; false
+    // when the record could not be written
+    bool recordPlace(const Order& order);
+    bool recordFill(OrderId orderId, std::int64_t quantity);
+    bool recordAmend(const Order& order);
+    bool recordEvent(OrderId orderId, OrderEvent event);
+    bool recordPosition(const Order& fill);
+    // Room for `records` more without waiting for the flusher to grow the file
+    bool canAppend(std::size_t records);
+    
+    // Block until every record appended so far is on disk
+    void sync();
+    
+    // Apply the journal's records to managers that have no journal attached
+    // yet (attach this one afterwards to carry on writing). Local order IDs
+    // are reserved past the highest one found, so new orders cannot collide
+    // with recovered ones.
+    JournalReplayStats replay(OrderManager& orders, RiskManager& risk) const;
+    
+    std::uint64_t recordCount() const { return nextSequence - 1; }
+    std::size_t capacity() const {
+        const std::size_t bytes = length.load(std::memory_order_acquire);
+        return bytes ? (bytes - HEADER_SIZE) / sizeof(JournalRecord) : 0;
+    }
+    // Some record could not be written since open(); sticky
+    bool failed() const { return dropped != 0; }
+    std::uint64_t droppedCount() const { return dropped; }
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Order lifecycle shared by the local order manager and the exchange layer
+enum class OrderStatus : std::uint8_t {
+    NEW,               // created, not yet acknowledged by the venue
+    ACKED,             // resting, nothing filled
+    PARTIALLY_FILLED,  // resting, some quantity filled
+    FILLED,
+    PENDING_CANCEL,    // cancel sent, fills may still arrive
+    CANCELLED,
+    REJECTED,
+    PENDING_REPLACE,   // amend sent, fills may still arrive
+    COUNT
+};
+
+// What can happen to an order; fills are split by whether they leave quantity behind
+enum class OrderEvent : std::uint8_t {
+    ACK,
+    REJECT,
+    PARTIAL_FILL,
+    FILL,
+    CANCEL_REQUEST,
+    CANCEL_ACK,
+    CANCEL_REJECT,
+    REPLACE_REQUEST,
+    REPLACE_ACK,
+    REPLACE_REJECT,
+    COUNT
+};
+
+namespace order_state {
+
+constexpr std::size_t STATES = static_cast<std::size_t>(OrderStatus::COUNT);
+constexpr std::size_t EVENTS = static_cast<std::size_t>(OrderEvent::COUNT);
+constexpr std::uint8_t NONE = 0xFF;  // event not allowed in this state
+
+// Transition table, one row per state and one column per event. Answers to a
+// pending cancel or replace return to ACKED; Order::onEvent turns that into
+// PARTIALLY_FILLED when something has already been filled.
+constexpr std::array<std::array<std::uint8_t, EVENTS>, STATES> makeTable() {
+    std::array<std::array<std::uint8_t, EVENTS>, STATES> table{};
+    for (auto& row : table) row.fill(NONE);
+    auto allow = [&table](OrderStatus from, OrderEvent event, OrderStatus to) {
+        table[static_cast<std::size_t>(from)][static_cast<std::size_t>(event)] = static_cast<std::uint8_t>(to);
+    };
+    using S = OrderStatus;
+    using E = OrderEvent;
+    
+    allow(S::NEW, E::ACK, S::ACKED);
+    allow(S::NEW, E::REJECT, S::REJECTED);
+    allow(S::NEW, E::PARTIAL_FILL, S::PARTIALLY_FILLED);  // fills may overtake the ack
+    allow(S::NEW, E::FILL, S::FILLED);
+    allow(S::NEW, E::CANCEL_REQUEST, S::PENDING_CANCEL);
+    
+    for (S working : {S::ACKED, S::PARTIALLY_FILLED}) {
+        allow(working, E::PARTIAL_FILL, S::PARTIALLY_FILLED);
+        allow(working, E::FILL, S::FILLED);
+        allow(working, E::CANCEL_REQUEST, S::PENDING_CANCEL);
+        allow(working, E::REPLACE_REQUEST, S::PENDING_REPLACE);
+    }
+    
+    allow(S::PENDING_CANCEL, E::ACK, S::PENDING_CANCEL);
+    allow(S::PENDING_CANCEL, E::REJECT, S::REJECTED);
+    allow(S::PENDING_CANCEL, E::PARTIAL_FILL, S::PENDING_CANCEL);
+    allow(S::PENDING_CANCEL, E::FILL, S::FILLED);
+    allow(S::PENDING_CANCEL, E::CANCEL_ACK, S::CANCELLED);
+    allow(S::PENDING_CANCEL, E::CANCEL_REJECT, S::ACKED);
+    
+    allow(S::PENDING_REPLACE, E::PARTIAL_FILL, S::PENDING_REPLACE);
+    allow(S::PENDING_REPLACE, E::FILL, S::FILLED);
+    allow(S::PENDING_REPLACE, E::REPLACE_ACK, S::ACKED);
+    allow(S::PENDING_REPLACE, E::REPLACE_REJECT, S::ACKED);
+    return table;
+}
+
+inline constexpr auto TABLE = makeTable();
+
+} // namespace order_state
+
+// Next status for an event; false when the event is not allowed in `from`
+constexpr bool nextOrderStatus(OrderStatus from, OrderEvent event, OrderStatus& to) {
+    const std::uint8_t next = order_state::TABLE[static_cast<std::size_t>(from)][static_cast<std::size_t>(event)];
+    if (next == order_state::NONE) return false;
+    to = static_cast<OrderStatus>(next);
+    return true;
+}
+
+constexpr bool isTerminal(OrderStatus status) {
+    return status == OrderStatus::FILLED || status == OrderStatus::CANCELLED || status == OrderStatus::REJECTED;
+}
+
+// Terminal states accept no events at all
+static_assert([] {
+    for (OrderStatus status : {OrderStatus::FILLED, OrderStatus::CANCELLED, OrderStatus::REJECTED}) {
+        for (std::uint8_t next : order_state::TABLE[static_cast<std::size_t>(status)]) {
+            if (next != order_state::NONE) return false;
+        }
+    }
+    return true;
+}());
@@ -1,12 +1,13 @@
 #pragma once
-#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include "Order.h"
 
 class PerformanceTimer {
 private:
-    std::chrono::high_resolution_clock::time_point startTime;
+    std::uint64_t startTicks;
     std::string operationName;
     
 public:
@@ -21,7 +22,25 @@ public:
     static void measureDataLoad();
     static void measureSignalGeneration();
     static void measureOrderPlacement();
+    // Replay a synthetic session through strategy, risk, order manager and
+    // simulated venue with per-stage tracing; prints the latency report and
+    // writes the JSON dump to dumpPath
+    static void traceTickToTrade(std::size_t ticks = 200000, const std::string& dumpPath = "tick_to_trade_latency.json");
     static void measureCPUAffinity();
     static void measureCacheOptimization();
     static void verifyMultiThreading();  // New verification method
+    static void measureTickLoader(std::size_t rows = 10000000);
+    static void measureBinaryTickLoad(std::size_t rows = 10000000);
+    static void measureTickArchive(std::size_t rows = 10000000);
+    static void measureParallelTickLoad(std::size_t rows = 20000000);
+    static void measureIndicatorKernels(std::size_t count = 10000000);
+    static void measureOrderBook(std::size_t updates = 10000000);
+    static void measureL3Replay(std::size_t events = 5000000);
+    static void measureOrderManager(std::size_t orders = 1000000);
+    static void measureOrderIds(std::size_t idsPerThread = 10000000);
+    static void measureOrderJournal(std::size_t orders = 1000000);
+    static void measureItchDecode(std::size_t messages = 10000000);
+    static void measureReplayJitter(std::size_t events = 100000);
+    static void measureBarAggregation(std::size_t ticks = 10000000, std::size_t symbols = 5000);
+    static void measureRangeQueries(std::size_t ticks = 10000000, std::size_t queries = 1000000);
 };
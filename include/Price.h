@@ -0,0 +1,90 @@
+#pragma once
+#include <compare>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+// Fixed-point price: a signed 64-bit count of 1/10,000 currency units (the
+// resolution of exchange "price(4)" fields). Sums, comparisons and notionals
+// are exact integer operations; doubles only appear at input and display edges.
+class Price {
+private:
+    std::int64_t units = 0;
+    
+public:
+    static constexpr std::int64_t SCALE = 10000;
+    
+    constexpr Price() = default;
+    
+    static constexpr Price fromRaw(std::int64_t raw) {
+        Price p;
+        p.units = raw;
+        return p;
+    }
+    // Rounds to the nearest 1/10,000
+    static constexpr Price fromDouble(double value) {
+        return fromRaw(static_cast<std::int64_t>(value * SCALE + (value < 0 ? -0.5 : 0.5)));
+    }
+    
+    constexpr std::int64_t raw() const { return units; }
+    constexpr double toDouble() const { return static_cast<double>(units) / SCALE; }
+    
+    constexpr Price& operator+=(Price other) { units += other.units; return *this; }
+    constexpr Price& operator-=(Price other) { units -= other.units; return *this; }
+    
+    friend constexpr Price operator+(Price a, Price b) { return fromRaw(a.units + b.units); }
+    friend constexpr Price operator-(Price a, Price b) { return fromRaw(a.units - b.units); }
+    friend constexpr Price operator-(Price a) { return fromRaw(-a.units); }
+    
+    // Notional of a whole-unit quantity
+    friend constexpr Price operator*(Price p, std::int64_t quantity) { return fromRaw(p.units * quantity); }
+    friend constexpr Price operator*(std::int64_t quantity, Price p) { return fromRaw(p.units * quantity); }
+    
+    // Average over n, rounded half away from zero
+    friend constexpr Price operator/(Price p, std::int64_t n) {
+        std::int64_t quotient = p.units / n;
+        std::int64_t remainder = p.units % n;
+        if (2 * (remainder < 0 ? -remainder : remainder) >= (n < 0 ? -n : n)) {
+            quotient += ((p.units < 0) != (n < 0)) ? -1 : 1;
+        }
+        return fromRaw(quotient);
+    }
+    
+    // Notional of a fractional quantity (exact while |raw * factor| < 2^53)
+    constexpr Price scaled(double factor) const {
+        double v = static_cast<double>(units) * factor;
+        return fromRaw(static_cast<std::int64_t>(v + (v < 0 ? -0.5 : 0.5)));
+    }
+    
+    friend constexpr bool operator==(Price a, Price b) = default;
+    friend constexpr auto operator<=>(Price a, Price b) = default;
+    
+    constexpr Price abs() const { return fromRaw(units < 0 ? -units : units); }
+    
+    // Per-symbol tick sizes are Prices too (e.g. 0.01 = fromRaw(100))
+    constexpr bool isOnTick(Price tickSize) const {
+        return tickSize.units <= 0 || units % tickSize.units == 0;
+    }
+    constexpr Price roundToTick(Price tickSize) const {
+        if (tickSize.units <= 0) return *this;
+        std::int64_t half = tickSize.units / 2;
+        std::int64_t adjusted = units + (units < 0 ? -half : half);
+        return fromRaw(adjusted / tickSize.units * tickSize.units);
+    }
+};
+
+static_assert(sizeof(Price) == sizeof(std::int64_t) && std::is_trivially_copyable_v<Price>,
+              "Price must stay a bare int64 so columns can be stored and copied raw");
+static_assert(Price::fromDouble(150.25).raw() == 1502500);
+static_assert(Price::fromDouble(0.015).roundToTick(Price::fromRaw(100)) == Price::fromDouble(0.02));
+static_assert(Price::fromRaw(7) / 2 == Price::fromRaw(4) && Price::fromRaw(-7) / 2 == Price::fromRaw(-4));
+
+// Exact decimal parse ("150.25", "-3", "0.00005"); digits past the fourth
+// decimal are rounded. Returns false on anything that is not a plain decimal.
+bool parsePrice(std::string_view text, Price& out);
+
+// Prints like a double so existing report formats are unchanged
+inline std::ostream& operator<<(std::ostream& os, Price p) {
+    return os << p.toDouble();
+}
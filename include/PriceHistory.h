@@ -0,0 +1,87 @@
+#pragma once
+#include "IndicatorKernels.h"
+#include "Price.h"
+#include "SymbolTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Fixed-capacity ring of the most recent prices of one symbol.
+// Capacity must be a power of two. The ring is cache-line aligned so two
+// symbols never share a line.
+template <std::size_t Capacity>
+class alignas(64) PriceRing {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+    
+    Price prices[Capacity] = {};
+    std::uint64_t pushed = 0;
+    
+public:
+    static constexpr std::size_t capacity() { return Capacity; }
+    
+    void push(Price price) {
+        prices[pushed & MASK] = price;
+        pushed++;
+    }
+    
+    void clear() { pushed = 0; }
+    
+    std::size_t size() const { return pushed < Capacity ? static_cast<std::size_t>(pushed) : Capacity; }
+    bool empty() const { return pushed == 0; }
+    
+    // ago = 0 is the most recent price
+    Price at(std::size_t ago) const { return prices[(pushed - 1 - ago) & MASK]; }
+    Price latest() const { return at(0); }
+    
+    // Exact sum of the newest n prices (n <= size()). The window is at most two
+    // contiguous runs of the array, each summed by the batch kernel.
+    Price sumLast(std::size_t n) const {
+        const std::size_t end = pushed & MASK;  // one past the newest slot
+        if (n <= end) {
+            return sumPrices(prices + end - n, n);
+        }
+        const std::size_t start = (end - n) & MASK;
+        return sumPrices(prices + start, Capacity - start) + sumPrices(prices, end);
+    }
+    
+    // Average of the newest n prices, 0.0 when fewer than n are held
+    double average(std::size_t n) const {
+        if (n == 0 || n > size()) return 0.0;
+        return sumLast(n).toDouble() / n;
+    }
+};
+
+constexpr std::size_t PRICE_HISTORY_CAPACITY = 256;
+
+// Recent-price rings for every symbol, indexed by SymbolId
+class PriceHistory {
+public:
+    using Ring = PriceRing<PRICE_HISTORY_CAPACITY>;
+    
+private:
+    std::vector<Ring> rings;
+    
+public:
+    void update(SymbolId symbol, Price price) {
+        if (symbol >= rings.size()) {
+            rings.resize(symbol + 1);  // only when a new symbol first appears
+        }
+        rings[symbol].push(price);
+    }
+    
+    void clear() { rings.clear(); }
+    
+    // nullptr if the symbol has no ticks yet
+    const Ring* ring(SymbolId symbol) const {
+        return (symbol < rings.size()) ? &rings[symbol] : nullptr;
+    }
+    
+    // 0.0 if periods exceeds the ticks held (or the ring capacity)
+    double movingAverage(SymbolId symbol, std::size_t periods) const {
+        const Ring* r = ring(symbol);
+        return r ? r->average(periods) : 0.0;
+    }
+};
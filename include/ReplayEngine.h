@@ -0,0 +1,101 @@
+#pragma once
+#include "MarketEvents.h"
+#include "Strategy.h"
+#include "SymbolTable.h"
+#include "TickStore.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class ReplayPacing {
+    ORIGINAL,             // recorded inter-arrival times
+    SCALED,               // recorded times divided by ReplayOptions::speed
+    AS_FAST_AS_POSSIBLE   // no waiting between events
+};
+
+struct ReplayOptions {
+    ReplayPacing pacing = ReplayPacing::AS_FAST_AS_POSSIBLE;
+    double speed = 1.0;                     // SCALED only: N x the recorded rate
+    int core = -1;                          // pin the replay thread to this core (-1 = unpinned)
+    std::int64_t spinThresholdNs = 200000;  // sleep until this close to an event, then spin
+};
+
+struct ReplayStats {
+    std::size_t events = 0;
+    double seconds = 0.0;  // wall time of the run
+    bool pinned = false;
+    bool stopped = false;  // stop() ended the run early
+    // How late each dispatch started against its intended time, in ns
+    // (all zero for AS_FAST_AS_POSSIBLE, which has no schedule)
+    std::int64_t jitterP50 = 0;
+    std::int64_t jitterP99 = 0;
+    std::int64_t jitterP999 = 0;
+    std::int64_t jitterMax = 0;
+    
+    double eventsPerSecond() const { return seconds > 0.0 ? events / seconds : 0.0; }
+};
+
+// One message of a loaded capture
+struct ReplayEvent {
+    bool isTick;
+    Tick tick;             // executions and trades
+    OrderBookEvent order;  // order-by-order book events
+    
+    std::int64_t timestamp() const { return isTick ? tick.timestamp : order.timestamp; }
+};
+
+// Plays recorded market data into subscribers on a fixed schedule: the rows
+// of a TickStore, or an ITCH capture (book events plus execution ticks).
+// Waiting sleeps until spinThresholdNs before each event and then spins on the
+// clock, and every dispatch records how late it started, so runs measure the
+// jitter the pipeline would see from a live feed.
+class ReplayEngine {
+public:
+    using TickHandler = std::function<void(const Tick&)>;
+    using OrderEventHandler = std::function<void(const OrderBookEvent&)>;
+    
+private:
+    const TickStore* ticks = nullptr;
+    std::vector<ReplayEvent> capture;
+    std::vector<TickHandler> tickHandlers;
+    std::vector<OrderEventHandler> orderHandlers;
+    
+    std::thread worker;
+    ReplayStats workerStats;
+    std::atomic<bool> stopRequested{false};
+    
+    ReplayStats replay(const ReplayOptions& options);
+    template <typename Source>
+    ReplayStats play(const ReplayOptions& options, std::size_t count, Source&& source);
+    
+public:
+    ReplayEngine() = default;
+    explicit ReplayEngine(const TickStore& store) : ticks(&store) {}
+    ~ReplayEngine();
+    
+    ReplayEngine(const ReplayEngine&) = delete;
+    ReplayEngine& operator=(const ReplayEngine&) = delete;
+    
+    // Replay the rows of a store (kept by reference; must outlive the engine)
+    void setSource(const TickStore& store);
+    // Replay an ITCH capture instead; symbols are interned in globalSymbols()
+    bool loadCapture(const std::string& path);
+    std::size_t size() const;
+    
+    void subscribeTicks(TickHandler handler) { tickHandlers.push_back(std::move(handler)); }
+    void subscribeOrderEvents(OrderEventHandler handler) { orderHandlers.push_back(std::move(handler)); }
+    // Ticks go to strategy.onTick(); the strategy must outlive the engine
+    void subscribe(Strategy& strategy);
+    
+    // Replay on the calling thread (pinned to options.core if set)
+    ReplayStats run(const ReplayOptions& options);
+    // Replay on a new thread; join() waits for it and returns its stats
+    void start(const ReplayOptions& options);
+    ReplayStats join();
+    // Ask a running replay to finish after the current event
+    void stop() { stopRequested.store(true, std::memory_order_relaxed); }
+};
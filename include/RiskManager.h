@@ -1,22 +1,29 @@
 #pragma once
 #include "Order.h"
 #include "MarketData.h"
+#include "TickStore.h"
+#include "OrderBook.h"
 #include <vector>
-#include <map>
+
+class OrderJournal;
 
 struct Position {
-    std::string symbol;
+    SymbolId symbol = INVALID_SYMBOL;  // INVALID_SYMBOL while flat
     int quantity;        // Positive = long, negative = short
-    double avgPrice;     // Average purchase price
-    double currentPrice; // Current market price
-    double unrealizedPnL; // Profit/Loss
+    Price avgPrice;      // Average purchase price
+    Price currentPrice;  // Current market price
+    Price unrealizedPnL; // Profit/Loss
 };
 
 class RiskManager {
 private:
-    std::map<std::string, Position> positions;
-    double maxPositionSize;
-    double maxTotalExposure;
+    std::vector<Position> positions;  // indexed by SymbolId
+    std::size_t openPositions = 0;
+    Price maxPositionSize;
+    Price maxTotalExposure;
+    double maxBookDeviation = 0.10;            // max distance of a limit price from the book mid
+    const OrderBookManager* books = nullptr;   // optional, enables the price collar
+    OrderJournal* journal = nullptr;           // optional, records every booked fill
     
 public:
     RiskManager(double maxPosSize = 10000.0, double maxExposure = 50000.0);
@@ -26,16 +33,27 @@ public:
     
     // Update current market prices and calculate P&L
     void updateMarketPrices(const std::vector<MarketData>& marketData);
+    void updateMarketPrices(const TickStore& ticks);
+    // Mark positions at the mid of their order book
+    void updateMarketPrices(const OrderBookManager& orderBooks);
+    
+    // Read books for price checks; orders priced further than maxDeviation
+    // (a fraction of the mid) from their symbol's mid are rejected
+    void attachOrderBooks(const OrderBookManager* orderBooks, double maxDeviation = 0.10);
+    
+    // Journal every fill booked from now on (nullptr stops it)
+    void attachJournal(OrderJournal* orderJournal) { journal = orderJournal; }
     
     // Check if order passes risk limits
-    bool validateOrder(const Order& order, double currentPrice);
+    bool validateOrder(const Order& order, Price currentPrice);
     
     // Display all positions
     void showPositions() const;
     
     // Calculate total portfolio value
-    double getTotalExposure() const;
+    Price getTotalExposure() const;
     
-    // Get position for specific symbol
-    Position* getPosition(const std::string& symbol);
+    // Get position for specific symbol (nullptr when flat)
+    Position* getPosition(SymbolId symbol);
+    Position* getPosition(std::string_view symbol) { return getPosition(findSymbolId(symbol)); }
 };
@@ -0,0 +1,76 @@
+#pragma once
+#include "MarketData.h"
+#include "SymbolTable.h"
+#include "TickStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// SMA, EMA and variance over the last `window` prices, updated in O(1) per tick.
+// The SMA uses a compensated running sum, the variance a sliding Welford update.
+class RollingWindow {
+private:
+    std::vector<double> values;  // ring of the prices inside the window
+    std::size_t head = 0;        // slot of the oldest price once full
+    std::size_t count = 0;       // prices seen, capped at the window size
+    
+    double sum = 0.0;
+    double compensation = 0.0;   // Neumaier correction term for sum
+    double mean = 0.0;
+    double m2 = 0.0;             // sum of squared deviations from mean
+    
+    double alpha;
+    double emaValue = 0.0;
+    bool emaSeeded = false;
+    
+    void addToSum(double x);
+    
+public:
+    explicit RollingWindow(std::size_t window);
+    
+    void update(double price);
+    void reset();
+    
+    std::size_t size() const { return values.size(); }
+    bool ready() const { return count == values.size(); }
+    
+    // 0.0 until the window is full, like calculateMovingAverage
+    double sma() const { return ready() ? (sum + compensation) / values.size() : 0.0; }
+    // Seeded with the first price, alpha = 2 / (window + 1)
+    double ema() const { return emaValue; }
+    // Population variance of the prices currently in the window
+    double variance() const;
+    double stddev() const;
+};
+
+// Rolling windows for every (symbol, window size) pair.
+// Feed it tick by tick with onTick(), or let it catch up on a TickStore or row
+// vector with update(), which only processes rows it has not seen yet.
+class RollingIndicatorEngine {
+private:
+    std::vector<std::size_t> windowSizes;
+    std::vector<RollingWindow> stats;  // symbol-major: stats[symbol * windowSizes.size() + slot]
+    
+    // Catch-up cursor for update()
+    std::uint64_t sourceGeneration = 0;
+    const MarketData* sourceRows = nullptr;
+    std::size_t processed = 0;
+    
+    int slotOf(std::size_t window) const;
+    
+public:
+    explicit RollingIndicatorEngine(std::vector<std::size_t> windows);
+    
+    void onTick(SymbolId symbol, double price);
+    void reset();
+    
+    void update(const TickStore& ticks);
+    void update(const std::vector<MarketData>& rows);
+    
+    // nullptr for unknown symbols or window sizes that were not configured
+    const RollingWindow* window(SymbolId symbol, std::size_t windowSize) const;
+    
+    double sma(SymbolId symbol, std::size_t windowSize) const;
+    double ema(SymbolId symbol, std::size_t windowSize) const;
+    double stddev(SymbolId symbol, std::size_t windowSize) const;
+};
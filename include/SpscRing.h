@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Bounded single-producer / single-consumer ring buffer.
+// Capacity must be a power of two. Producer and consumer indices live on
+// separate cache lines, and each side caches the other's index so the shared
+// line is only touched when the ring looks full (or empty).
+template <typename T, std::size_t Capacity>
+class SpscRing {
+    static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    
+private:
+    static constexpr std::size_t MASK = Capacity - 1;
+    
+    alignas(64) std::atomic<std::size_t> head{0};  // next slot to write
+    std::size_t cachedTail = 0;                     // producer's copy of tail
+    alignas(64) std::atomic<std::size_t> tail{0};  // next slot to read
+    std::size_t cachedHead = 0;                     // consumer's copy of head
+    alignas(64) T slots[Capacity];
+    
+public:
+    static constexpr std::size_t capacity() { return Capacity; }
+    
+    // Producer: construct the next element in place with fill(T&)
+    template <typename Fill>
+    bool tryEmplace(Fill&& fill) {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        if (h - cachedTail == Capacity) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h - cachedTail == Capacity) return false;  // full
+        }
+        fill(slots[h & MASK]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+    
+    bool tryPush(const T& item) {
+        return tryEmplace([&item](T& slot) { slot = item; });
+    }
+    
+    // Consumer: hand up to maxItems elements to consume(const T&), oldest first
+    template <typename Consume>
+    std::size_t consume(Consume&& consumeOne, std::size_t maxItems = Capacity) {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        std::size_t available = cachedHead - t;
+        if (available < maxItems) {
+            cachedHead = head.load(std::memory_order_acquire);
+            available = cachedHead - t;
+            if (available == 0) return 0;  // empty
+        }
+        std::size_t n = (available < maxItems) ? available : maxItems;
+        for (std::size_t i = 0; i < n; i++) {
+            consumeOne(slots[(t + i) & MASK]);
+        }
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+    
+    bool tryPop(T& out) {
+        return consume([&out](const T& item) { out = item; }, 1) == 1;
+    }
+    
+    // Approximate when called concurrently with the other side
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+    std::size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+};
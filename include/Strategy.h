@@ -1,22 +1,59 @@
 #pragma once
-#include "MarketData.h"
+#include "MarketEvents.h"
+#include "OrderBook.h"
+#include "RollingIndicators.h"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
 
+// Event-driven strategy interface. Strategies keep their own incremental state,
+// react to each event in constant time and queue order intents for the caller.
 class Strategy {
+protected:
+    std::vector<OrderIntent> intents;
+    
+    void emit(const OrderIntent& intent) { intents.push_back(intent); }
+    
 public:
     virtual ~Strategy() = default;
-    virtual int generateSignal(const std::vector<MarketData>& data, const std::string& symbol) = 0;
+    
+    virtual void onTick(const Tick& tick) = 0;
+    virtual void onFill(const Fill& fill) { (void)fill; }
+    // Called after a depth update has been applied to the symbol's book
+    virtual void onBook(const BookUpdate& update, const OrderBook& book) { (void)update; (void)book; }
+    // Called when a bar closes; series indexes the aggregator's specs()
+    virtual void onBar(const Bar& bar, std::size_t series) { (void)bar; (void)series; }
+    virtual void onTimer(std::int64_t now) { (void)now; }
     virtual std::string getStratName() const = 0;
+    
+    // Intents queued since the last clearIntents(); the buffer is reused
+    const std::vector<OrderIntent>& pendingIntents() const { return intents; }
+    void clearIntents() { intents.clear(); }
 };
 
+// Go long when the short SMA is above the long SMA, short when below.
+// An intent is emitted whenever the signal of a symbol changes, sized to move
+// the filled position to +/- orderQuantity (or flat on HOLD).
 class MovingAvgStrat : public Strategy {
 private:
     int shortP;
     int longP;
+    int orderQuantity;
+    RollingIndicatorEngine indicators;  // SMAs for both periods, updated per tick
+    std::vector<int> lastSignal;        // per symbol
+    std::vector<int> positions;         // per symbol, from fills
     
 public:
-    MovingAvgStrat(int short_P, int long_P);
-    int generateSignal(const std::vector<MarketData>& data, const std::string& symbol) override;
+    MovingAvgStrat(int short_P, int long_P, int orderQty = 100);
+    
+    void onTick(const Tick& tick) override;
+    void onFill(const Fill& fill) override;
     std::string getStratName() const override;
-};
\ No newline at end of file
+    
+    // 1 = buy, -1 = sell, 0 = hold (also while either window is still filling)
+    int signal(SymbolId symbol) const;
+    double shortAverage(SymbolId symbol) const { return indicators.sma(symbol, shortP); }
+    double longAverage(SymbolId symbol) const { return indicators.sma(symbol, longP); }
+    int position(SymbolId symbol) const;
+};
@@ -0,0 +1,158 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using SymbolId = std::uint32_t;
+constexpr SymbolId INVALID_SYMBOL = UINT32_MAX;
+
+// FNV-1a over the ticker bytes with a murmur finalizer, so the low bits used
+// as a slot index depend on every character. Usable at compile time.
+constexpr std::uint64_t symbolHash(std::string_view name, std::uint64_t seed = 0) {
+    std::uint64_t h = 0xcbf29ce484222325ULL ^ (seed * 0x9e3779b97f4a7c15ULL);
+    for (char c : name) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Collision-free hash over a ticker universe fixed at build time. The
+// constructor searches for a seed that puts every name in its own slot, so a
+// lookup is one hash and one string compare. A universe with duplicates (or
+// no usable seed) fails to compile when the table is declared constexpr.
+template <std::size_t N>
+class PerfectSymbolHash {
+public:
+    static constexpr std::size_t SLOTS = std::bit_ceil(N * 2);
+    
+private:
+    static constexpr std::uint64_t MAX_SEEDS = 1 << 16;
+    
+    std::array<std::string_view, N> names{};
+    std::array<SymbolId, SLOTS> slots{};
+    std::uint64_t seed = 0;
+    
+    constexpr bool place() {
+        slots.fill(INVALID_SYMBOL);
+        for (std::size_t i = 0; i < N; i++) {
+            std::size_t slot = symbolHash(names[i], seed) & (SLOTS - 1);
+            if (slots[slot] != INVALID_SYMBOL) return false;
+            slots[slot] = static_cast<SymbolId>(i);
+        }
+        return true;
+    }
+    
+public:
+    constexpr explicit PerfectSymbolHash(const std::array<std::string_view, N>& universe) : names(universe) {
+        for (seed = 0; seed < MAX_SEEDS; seed++) {
+            if (place()) return;
+        }
+        throw "no collision-free seed for this symbol universe";
+    }
+    
+    // Position of name in the universe, INVALID_SYMBOL if it is not a member
+    constexpr SymbolId find(std::string_view name) const {
+        SymbolId id = slots[symbolHash(name, seed) & (SLOTS - 1)];
+        return (id != INVALID_SYMBOL && names[id] == name) ? id : INVALID_SYMBOL;
+    }
+    
+    constexpr std::string_view name(SymbolId id) const { return names[id]; }
+    static constexpr std::size_t size() { return N; }
+};
+
+// Tickers known at build time. Tables made with SymbolTable::withKnownSymbols()
+// give them IDs 0..N-1 in this order, so knownSymbol() is a compile-time ID.
+inline constexpr std::array<std::string_view, 8> KNOWN_SYMBOL_NAMES = {
+    "AAPL", "MSFT", "GOOG", "AMZN", "TSLA", "NVDA", "META", "NFLX"
+};
+inline constexpr PerfectSymbolHash KNOWN_SYMBOLS(KNOWN_SYMBOL_NAMES);
+
+constexpr SymbolId knownSymbol(std::string_view name) { return KNOWN_SYMBOLS.find(name); }
+
+static_assert(knownSymbol("AAPL") == 0 && knownSymbol("NFLX") == 7 && knownSymbol("IBM") == INVALID_SYMBOL);
+
+// Interns ticker strings to dense integer IDs (0, 1, 2, ...) so per-symbol
+// state can live in flat arrays indexed by ID.
+class SymbolTable {
+private:
+    std::deque<std::string> names;   // deque: name() references survive growth
+    std::vector<SymbolId> slots;     // open addressing over names, power-of-two size
+    bool knownPrefix = false;        // IDs 0..N-1 are KNOWN_SYMBOLS
+    
+    // Slot holding name, or the empty slot where it would go
+    std::size_t slotFor(std::string_view name) const {
+        const std::size_t mask = slots.size() - 1;
+        std::size_t slot = symbolHash(name) & mask;
+        while (slots[slot] != INVALID_SYMBOL && names[slots[slot]] != name) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+    
+    void grow() {
+        slots.assign(slots.empty() ? 16 : slots.size() * 2, INVALID_SYMBOL);
+        for (SymbolId id = 0; id < names.size(); id++) {
+            slots[slotFor(names[id])] = id;
+        }
+    }
+    
+public:
+    // Table whose first IDs are the build-time universe
+    static SymbolTable withKnownSymbols() {
+        SymbolTable table;
+        for (std::string_view name : KNOWN_SYMBOL_NAMES) {
+            table.intern(name);
+        }
+        table.knownPrefix = true;
+        return table;
+    }
+    
+    // Returns the existing ID or assigns the next one
+    SymbolId intern(std::string_view name) {
+        SymbolId id = find(name);
+        if (id != INVALID_SYMBOL) return id;
+        
+        if ((names.size() + 1) * 2 > slots.size()) grow();
+        id = static_cast<SymbolId>(names.size());
+        names.emplace_back(name);
+        slots[slotFor(name)] = id;
+        return id;
+    }
+    
+    // Returns INVALID_SYMBOL for unknown tickers
+    SymbolId find(std::string_view name) const {
+        if (knownPrefix) {
+            SymbolId id = KNOWN_SYMBOLS.find(name);
+            if (id != INVALID_SYMBOL) return id;
+        }
+        return slots.empty() ? INVALID_SYMBOL : slots[slotFor(name)];
+    }
+    
+    // Empty for IDs this table never assigned
+    const std::string& name(SymbolId id) const {
+        static const std::string none;
+        return (id < names.size()) ? names[id] : none;
+    }
+    std::size_t size() const { return names.size(); }
+};
+
+// The process-wide table: market data, orders, positions and the exchange all
+// use its IDs, so an ID means the same ticker everywhere. Intern while loading
+// on one thread; find() and name() are safe to share once the universe is in.
+inline SymbolTable& globalSymbols() {
+    static SymbolTable table = SymbolTable::withKnownSymbols();
+    return table;
+}
+
+inline SymbolId internSymbol(std::string_view name) { return globalSymbols().intern(name); }
+inline SymbolId findSymbolId(std::string_view name) { return globalSymbols().find(name); }
+inline const std::string& symbolName(SymbolId id) { return globalSymbols().name(id); }
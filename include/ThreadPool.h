@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pin the calling thread to one core (sched_setaffinity, as in
+// PerformanceMonitor::measureCPUAffinity). False if the core is not available.
+bool pinCurrentThread(int core);
+
+// Fixed set of worker threads fed from one job queue. Meant for coarse
+// batch work (per-chunk parsing, per-symbol rebuilds), not per-tick tasks.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable allDone;
+    std::size_t unfinished = 0;
+    bool stopping = false;
+    
+    void workerLoop();
+    
+public:
+    // 0 = one worker per hardware thread
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    std::size_t size() const { return workers.size(); }
+    
+    void submit(std::function<void()> job);
+    
+    // Blocks until every submitted job has finished
+    void wait();
+    
+    // Runs fn(0) .. fn(count - 1) on the pool and waits for all of them
+    template <typename Fn>
+    void parallelFor(std::size_t count, Fn&& fn) {
+        for (std::size_t i = 0; i < count; i++) {
+            submit([&fn, i]() { fn(i); });
+        }
+        wait();
+    }
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include "MappedFile.h"
+#include "TickStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compressed tick archive layout (version 1, native little-endian):
+//
+//   TickArchiveHeader
+//   symbol dictionary: per symbol { uint16 nameLength; char name[] }
+//   block index: ArchiveBlock[blockCount]
+//   blocks, each 64-byte aligned and decodable on its own, four byte streams:
+//     timestamps  zigzag varint delta from the previous row (the first from firstTimestamp)
+//     symbols     varint dictionary position
+//     prices      zigzag varint delta, in priceTick units, from the same symbol's
+//                 previous price in the block (0 before its first row)
+//     volumes     varint
+//
+// A block covers up to blockRows consecutive rows of the store. The index keeps
+// each block's time span, so a time range decodes only the blocks it touches.
+constexpr char TICK_ARCHIVE_MAGIC[8] = {'H', 'F', 'T', 'A', 'R', 'C', 'H', '\0'};
+constexpr std::uint32_t TICK_ARCHIVE_VERSION = 1;
+constexpr std::uint32_t DEFAULT_ARCHIVE_BLOCK_ROWS = 65536;
+
+struct TickArchiveHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t symbolCount;
+    std::uint64_t rowCount;
+    std::uint32_t blockRows;
+    std::uint32_t blockCount;
+    std::uint64_t dictionaryOffset;
+    std::uint64_t indexOffset;
+};
+
+struct ArchiveBlock {
+    std::int64_t firstTimestamp;  // ns, base of the timestamp deltas
+    std::int64_t minTimestamp;
+    std::int64_t maxTimestamp;
+    std::int64_t priceTick;       // raw Price units per price step (GCD of the block's prices)
+    std::uint64_t firstRow;
+    std::uint64_t offset;         // file offset of the timestamp stream
+    std::uint32_t rows;
+    std::uint32_t timestampBytes;
+    std::uint32_t symbolBytes;
+    std::uint32_t priceBytes;
+    std::uint32_t volumeBytes;
+    std::uint32_t reserved;
+    
+    std::uint64_t bytes() const {
+        return static_cast<std::uint64_t>(timestampBytes) + symbolBytes + priceBytes + volumeBytes;
+    }
+};
+
+bool writeTickArchive(const std::string& path, const TickStore& store,
+                      std::uint32_t blockRows = DEFAULT_ARCHIVE_BLOCK_ROWS);
+
+// True if the file starts with the archive magic
+bool isTickArchive(const std::string& path);
+
+// Compress any file loadData() accepts into an archive
+bool archiveTicks(const std::string& inputPath, const std::string& archivePath);
+
+// Read side of an archive. The file stays mapped and blocks are decoded on
+// demand into reusable column buffers, one stream at a time, so keeping the
+// archive around costs page cache, not heap.
+class TickArchive {
+private:
+    MappedFile file;
+    TickArchiveHeader header = {};
+    std::vector<SymbolId> symbols;     // dictionary position -> global ID
+    std::vector<ArchiveBlock> blocks;
+    bool timeOrdered = true;           // block maxima never decrease (time-sorted store)
+    
+    // Decode scratch, reused across blocks
+    std::vector<std::int64_t> timestamps;
+    std::vector<SymbolId> symbolIds;
+    std::vector<Price> prices;
+    std::vector<int> volumes;
+    std::vector<std::uint32_t> archiveSymbols;
+    std::vector<std::int64_t> lastSteps;
+    
+    bool decode(const ArchiveBlock& block);
+    
+public:
+    // Validates the header, dictionary and index; symbols are interned globally
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+    
+    std::uint64_t rowCount() const { return header.rowCount; }
+    std::size_t compressedBytes() const { return file.size(); }
+    const std::vector<ArchiveBlock>& index() const { return blocks; }
+    
+    // First block whose rows may reach timestamp (blocks.size() if none);
+    // a binary search when the archive was written from a time-sorted store,
+    // a scan otherwise
+    std::size_t findBlock(std::int64_t timestamp) const;
+    
+    // Append one block's rows to the store
+    bool appendBlock(std::size_t block, TickStore& store);
+    // Replace the store's contents with every row
+    bool load(TickStore& store);
+    // Replace the store's contents with rows where from <= timestamp < to
+    bool loadRange(std::int64_t from, std::int64_t to, TickStore& store);
+};
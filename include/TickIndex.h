@@ -0,0 +1,75 @@
+#pragma once
+#include "MarketEvents.h"
+#include "TickStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Aggregates over the trades of one symbol with from <= timestamp < to
+struct RangeStats {
+    std::size_t count = 0;
+    std::int64_t volume = 0;
+    double vwap = 0.0;   // 0 when the range has no volume
+    double twap = 0.0;   // price in force over the range, 0 before the first trade
+    Price first;         // first and last trade in the range (count > 0)
+    Price last;
+};
+
+// Per-symbol time index over tick history. Every symbol keeps its trade times
+// sorted next to prefix sums of volume, price x volume and price x time held,
+// so count, volume, VWAP and TWAP over any time range cost two searches and a
+// few subtractions instead of a scan. Prefix sums are exact integers; doubles
+// only appear in the returned averages.
+//
+// Feed it from a TickStore with update() or tick by tick from a strategy's
+// onTick(). In-order trades append in O(1); a trade older than its symbol's
+// latest is inserted in place and costs O(later trades of that symbol).
+class TickIndex {
+private:
+    using Wide = __int128;  // price x ns over a session overflows int64
+    
+    // Arrays of one symbol; volumeSum and notionalSum have one entry more than times
+    struct Series {
+        std::vector<std::int64_t> times;
+        std::vector<Price> prices;
+        std::vector<std::int64_t> volumeSum;  // volumeSum[i] = volumes of trades 0..i-1
+        std::vector<Wide> notionalSum;        // raw price x volume
+        std::vector<Wide> areaSum;            // areaSum[i] = raw price x ns in force from times[0] to times[i]
+    };
+    
+    std::vector<Series> series;  // indexed by SymbolId
+    std::size_t totalTicks = 0;
+    
+    // Catch-up cursor for update()
+    std::uint64_t sourceGeneration = 0;
+    std::size_t processed = 0;
+    
+    const Series* find(SymbolId symbol) const;
+    // Integral of the price in force from the first trade up to timestamp
+    static Wide areaUntil(const Series& s, std::int64_t timestamp);
+    
+public:
+    void append(std::int64_t timestamp, SymbolId symbol, Price price, int volume);
+    void onTick(const Tick& tick) { append(tick.timestamp, tick.symbol, tick.price, tick.volume); }
+    void reset();
+    
+    // Catch up on rows of the store not seen yet; a replaced store starts over
+    void update(const TickStore& ticks);
+    
+    std::size_t size() const { return totalTicks; }
+    std::size_t size(SymbolId symbol) const;
+    
+    // Position of the first trade of symbol at or after timestamp (size(symbol) if none)
+    std::size_t lowerBound(SymbolId symbol, std::int64_t timestamp) const;
+    // Last trade price at or before timestamp; false if the symbol had not traded yet
+    bool priceAt(SymbolId symbol, std::int64_t timestamp, Price& price) const;
+    
+    RangeStats query(SymbolId symbol, std::int64_t from, std::int64_t to) const;
+    std::size_t count(SymbolId symbol, std::int64_t from, std::int64_t to) const;
+    std::int64_t volume(SymbolId symbol, std::int64_t from, std::int64_t to) const;
+    double vwap(SymbolId symbol, std::int64_t from, std::int64_t to) const;
+    // The last trade's price holds until the next trade; the range is clipped
+    // to [first trade, last trade] of the symbol, and a single instant yields
+    // the price in force then
+    double twap(SymbolId symbol, std::int64_t from, std::int64_t to) const;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include "MarketData.h"
+#include "TickStore.h"
+#include <string>
+#include <vector>
+#include <cstddef>
+
+class ThreadPool;
+
+// Parse "timestamp,symbol,price,volume" rows (prices straight to fixed point) from a CSV buffer whose first line is
+// the header. Rows are appended to data; malformed rows (including unparsable
+// timestamps) are skipped.
+// Returns the number of rows appended.
+std::size_t parseTickCsv(const char* begin, const char* end, std::vector<MarketData>& data);
+// Same, straight into the columnar store
+std::size_t parseTickCsv(const char* begin, const char* end, TickStore& store);
+
+// Parallel parse: the body is split on newline boundaries into one chunk per
+// pool thread, chunks are parsed concurrently, and the rows are appended in
+// timestamp order (ties keep file order). Symbol IDs match a sequential load.
+std::size_t parseTickCsvParallel(const char* begin, const char* end, TickStore& store, ThreadPool& pool);
+
+// Count data rows (lines after the header) so storage can be reserved up front
+std::size_t countTickRows(const char* begin, const char* end);
+
+// mmap the CSV file at path and parse it in place (no line copies, no stringstream)
+bool loadTicksMapped(const std::string& path, std::vector<MarketData>& data);
+bool loadTicksMapped(const std::string& path, TickStore& store);
+
+// mmap + parseTickCsvParallel. The thread-count overload uses at most one
+// thread per 4 MB of file (0 = hardware_concurrency()) and parses small files
+// on the calling thread; either way rows come out in timestamp order.
+bool loadTicksParallel(const std::string& path, TickStore& store, ThreadPool& pool);
+bool loadTicksParallel(const std::string& path, TickStore& store, std::size_t threads = 0);
+
+// Write a synthetic tick file in the market_data.csv layout (used by benchmarks)
+bool generateTickCsv(const std::string& path, std::size_t rows);
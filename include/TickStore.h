@@ -0,0 +1,80 @@
+#pragma once
+#include "Clock.h"
+#include "MarketData.h"
+#include "MarketEvents.h"
+#include "PriceHistory.h"
+#include "SymbolTable.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Struct-of-arrays tick storage. Each field lives in its own contiguous column
+// so scans only touch the columns they need, and every symbol keeps the list
+// of its row numbers so per-symbol queries never visit other symbols' ticks.
+// Symbol IDs come from globalSymbols(), so they match orders and positions.
+class TickStore {
+private:
+    std::vector<std::int64_t> timestamps;  // ns since midnight
+    std::vector<SymbolId> symbolIds;
+    std::vector<Price> prices;
+    std::vector<int> volumes;
+    std::vector<std::vector<std::uint32_t>> symbolRows;  // indexed by SymbolId
+    PriceHistory history;  // last PRICE_HISTORY_CAPACITY prices per symbol
+    std::uint64_t storeGeneration;
+    
+    static std::uint64_t nextGeneration();
+    
+public:
+    TickStore();
+    
+    void reserve(std::size_t rows);
+    void clear();
+    
+    void append(std::int64_t timestamp, SymbolId symbol, Price price, int volume);
+    void append(std::int64_t timestamp, std::string_view symbol, Price price, int volume);
+    void append(const MarketData& md);
+    
+    // Bulk-load whole columns; symbols must already be interned
+    void assignColumns(const std::int64_t* timestampData, const SymbolId* symbolData,
+                       const Price* priceData, const int* volumeData, std::size_t rows);
+    void assignSymbolRows(SymbolId symbol, const std::uint32_t* rows, std::size_t count);
+    // Bulk-append rows whose symbols are already interned
+    void appendColumns(const std::int64_t* timestampData, const SymbolId* symbolData,
+                       const Price* priceData, const int* volumeData, std::size_t rows);
+    
+    // Build a store from the row-oriented representation
+    static TickStore fromRows(const std::vector<MarketData>& rows);
+    
+    // Changes whenever existing rows are replaced (clear/assign), never on append,
+    // so incremental consumers can tell "more rows" from "different rows"
+    std::uint64_t generation() const { return storeGeneration; }
+    
+    std::size_t size() const { return prices.size(); }
+    bool empty() const { return prices.empty(); }
+    
+    // Columns
+    const std::vector<std::int64_t>& timestampColumn() const { return timestamps; }
+    const std::vector<SymbolId>& symbolColumn() const { return symbolIds; }
+    const std::vector<Price>& priceColumn() const { return prices; }
+    const std::vector<int>& volumeColumn() const { return volumes; }
+    
+    // Row numbers of one symbol, in arrival order (empty for unknown IDs)
+    const std::vector<std::uint32_t>& rowsFor(SymbolId symbol) const;
+    
+    // Recent prices per symbol, kept up to date by append()
+    const PriceHistory& recentPrices() const { return history; }
+    
+    SymbolTable& symbolTable() { return globalSymbols(); }
+    const SymbolTable& symbolTable() const { return globalSymbols(); }
+    // INVALID_SYMBOL unless this store has rows for the ticker
+    SymbolId findSymbol(std::string_view name) const;
+    // Number of distinct symbols with at least one row
+    std::size_t symbolCount() const;
+    
+    // One row as a strategy event
+    Tick tick(std::size_t index) const { return {timestamps[index], symbolIds[index], prices[index], volumes[index]}; }
+    
+    // Reassemble one row (for display and legacy callers)
+    MarketData row(std::size_t index) const;
+};
@@ -0,0 +1,54 @@
+#pragma once
+#include "ExchangeAPI.h"
+#include "FlatIdMap.h"
+#include "LatencyTrace.h"
+#include "MarketEvents.h"
+#include "Order.h"
+#include "RiskManager.h"
+#include "Strategy.h"
+#include <cstddef>
+#include <vector>
+
+struct PipelineStats {
+    std::size_t ticks = 0;
+    std::size_t intents = 0;
+    std::size_t riskRejects = 0;
+    std::size_t localRejects = 0;  // refused by the order manager (journal full)
+    std::size_t venueRejects = 0;
+    std::size_t fills = 0;   // execution reports booked
+    std::size_t filled = 0;  // orders filled in full
+};
+
+// The tick-to-trade path in one place: a tick goes to the strategy, each
+// intent through the risk check into the local order book and out to the
+// venue, and the venue's answer comes back as an ack or a reject. Orders
+// stay ACKED until the venue reports executions; those are booked into the
+// order book, the positions and the strategy as they arrive. Every tick and
+// every order it produces leaves a TraceRecord in the LatencyTracer, stamped
+// at each stage it reached.
+class TradingPipeline {
+private:
+    Strategy& strategy;
+    RiskManager& risk;
+    OrderManager& orders;
+    ExchangeAPI& venue;
+    LatencyTracer& tracer;
+    PipelineStats counters;
+    FlatIdMap<OrderId> working;      // exchange order ID -> local order ID
+    std::vector<VenueFill> reports;  // executions not booked yet
+    
+    void route(OrderIntent intent, TraceRecord trace);
+    
+public:
+    TradingPipeline(Strategy& strategy, RiskManager& risk, OrderManager& orders, ExchangeAPI& venue,
+                    LatencyTracer& tracer = LatencyTracer::instance());
+    ~TradingPipeline();
+    TradingPipeline(const TradingPipeline&) = delete;
+    TradingPipeline& operator=(const TradingPipeline&) = delete;
+    
+    void onTick(const Tick& tick);
+    // Book the executions the venue reported since the last call; onTick
+    // does this first
+    void bookFills();
+    const PipelineStats& stats() const { return counters; }
+};
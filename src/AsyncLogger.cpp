@@ -0,0 +1,180 @@
+#include "AsyncLogger.h"
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <sched.h>
+#include <pthread.h>
+
+namespace {
+
+// Releases the calling thread's ring for reuse when the thread exits
+struct RingLease {
+    std::atomic<bool>* inUse = nullptr;
+    AsyncLogger::Ring* ring = nullptr;
+    
+    ~RingLease() {
+        if (inUse) inUse->store(false, std::memory_order_release);
+    }
+};
+
+thread_local RingLease lease;
+
+void appendDouble(std::string& out, double value, int precision) {
+    char buffer[64];
+    std::to_chars_result result = (precision >= 0)
+        ? std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, precision)
+        : std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr - buffer);
+}
+
+void appendArg(std::string& out, const LogRecord& record, std::size_t index, int precision) {
+    const LogRecord::Value& v = record.values[index];
+    char buffer[32];
+    switch (record.types[index]) {
+        case LogArgType::INT: {
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), v.i);
+            out.append(buffer, result.ptr - buffer);
+            break;
+        }
+        case LogArgType::UINT: {
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), v.u);
+            out.append(buffer, result.ptr - buffer);
+            break;
+        }
+        case LogArgType::DOUBLE:
+            appendDouble(out, v.d, precision);
+            break;
+        case LogArgType::TEXT:
+            out.append(record.text + v.text.offset, v.text.length);
+            break;
+    }
+}
+
+} // namespace
+
+AsyncLogger::AsyncLogger() : output(&std::cout) {
+    worker = std::thread([this]() { run(); });
+}
+
+AsyncLogger::~AsyncLogger() {
+    running.store(false, std::memory_order_release);
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+AsyncLogger& AsyncLogger::instance() {
+    static AsyncLogger logger;
+    return logger;
+}
+
+AsyncLogger::Ring* AsyncLogger::threadRing() {
+    if (lease.ring != nullptr) return lease.ring;
+    
+    // First log call on this thread: reuse a released ring or create one
+    std::lock_guard<std::mutex> lock(registrationMutex);
+    std::size_t count = ringCount.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; i++) {
+        bool expected = false;
+        if (rings[i]->inUse.compare_exchange_strong(expected, true)) {
+            lease.inUse = &rings[i]->inUse;
+            lease.ring = &rings[i]->ring;
+            return lease.ring;
+        }
+    }
+    if (count == MAX_THREADS) return nullptr;
+    
+    rings[count] = std::make_unique<ThreadRing>();
+    rings[count]->inUse.store(true);
+    ringCount.store(count + 1, std::memory_order_release);
+    lease.inUse = &rings[count]->inUse;
+    lease.ring = &rings[count]->ring;
+    return lease.ring;
+}
+
+bool AsyncLogger::drainOnce(std::string& buffer) {
+    bool any = false;
+    std::size_t count = ringCount.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < count; i++) {
+        any |= rings[i]->ring.consume([&buffer](const LogRecord& record) {
+            formatRecord(record, buffer);
+        }) > 0;
+    }
+    
+    if (any) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        output->write(buffer.data(), buffer.size());
+        output->flush();
+        buffer.clear();
+    }
+    return any;
+}
+
+void AsyncLogger::run() {
+    std::string buffer;
+    buffer.reserve(64 * 1024);
+    
+    while (running.load(std::memory_order_acquire)) {
+        bool any = drainOnce(buffer);
+        passes.fetch_add(1, std::memory_order_release);
+        if (!any) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+    // Write whatever was logged before shutdown
+    while (drainOnce(buffer)) {
+    }
+}
+
+void AsyncLogger::formatRecord(const LogRecord& record, std::string& out) {
+    std::size_t next = 0;
+    const char* p = record.format;
+    
+    while (*p) {
+        if (p[0] == '{' && p[1] == '}') {
+            if (next < record.argCount) appendArg(out, record, next++, -1);
+            p += 2;
+        } else if (p[0] == '{' && p[1] == ':' && p[2] == '.' && p[3] >= '0' && p[3] <= '9' &&
+                   p[4] == 'f' && p[5] == '}') {
+            if (next < record.argCount) appendArg(out, record, next++, p[3] - '0');
+            p += 6;
+        } else {
+            out.push_back(*p++);
+        }
+    }
+    out.push_back('\n');
+}
+
+void AsyncLogger::flush() {
+    if (worker.get_id() == std::this_thread::get_id()) return;
+    
+    // Wait for the rings to empty, then for two complete passes so the pass
+    // that consumed the last records has finished writing them
+    for (;;) {
+        bool empty = true;
+        std::size_t count = ringCount.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; i++) {
+            empty &= rings[i]->ring.empty();
+        }
+        if (empty) break;
+        std::this_thread::yield();
+    }
+    std::uint64_t start = passes.load(std::memory_order_acquire);
+    while (running.load(std::memory_order_acquire) && passes.load(std::memory_order_acquire) < start + 2) {
+        std::this_thread::yield();
+    }
+}
+
+void AsyncLogger::setOutput(std::ostream& out) {
+    flush();
+    std::lock_guard<std::mutex> lock(outputMutex);
+    output = &out;
+}
+
+bool AsyncLogger::pinWorker(int core) {
+    if (core < 0 || core >= CPU_SETSIZE) return false;
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core, &cpuset);
+    return pthread_setaffinity_np(worker.native_handle(), sizeof(cpu_set_t), &cpuset) == 0;
+}
@@ -0,0 +1,131 @@
+#include "BarAggregator.h"
+#include "Strategy.h"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace {
+
+void extend(Bar& bar, const Tick& tick) {
+    bar.high = std::max(bar.high, tick.price);
+    bar.low = std::min(bar.low, tick.price);
+    bar.close = tick.price;
+    bar.end = tick.timestamp;
+    bar.volume += tick.volume;
+    bar.ticks++;
+}
+
+} // namespace
+
+BarAggregator::BarAggregator(std::vector<BarSpec> specs, std::size_t historyPerSeries)
+    : barSpecs(std::move(specs)), capacity(std::bit_ceil(std::max<std::size_t>(historyPerSeries, 1))) {
+    // A zero-size time bar would divide by zero on the first tick
+    for (const BarSpec& spec : barSpecs) {
+        if (spec.size <= 0) throw std::invalid_argument("BarAggregator: bar size must be positive");
+    }
+}
+
+void BarAggregator::open(Series& s, const Tick& tick, std::int64_t start) {
+    s.current = {start, tick.timestamp, tick.symbol, 1, tick.price, tick.price, tick.price, tick.price, tick.volume};
+}
+
+void BarAggregator::complete(std::size_t index) {
+    Series& s = series[index];
+    Bar& slot = history[index * capacity + (s.completed & (capacity - 1))];
+    slot = s.current;
+    s.completed++;
+    s.current.ticks = 0;
+    totalCompleted++;
+    
+    const std::size_t spec = index % barSpecs.size();
+    for (const BarHandler& handler : handlers) {
+        handler(slot, spec);
+    }
+}
+
+void BarAggregator::onTick(const Tick& tick) {
+    const std::size_t perSymbol = barSpecs.size();
+    const std::size_t base = static_cast<std::size_t>(tick.symbol) * perSymbol;
+    
+    // Allocate series and rings only the first time a symbol shows up
+    if (series.size() < base + perSymbol) {
+        series.resize(base + perSymbol);
+        history.resize(series.size() * capacity);
+    }
+    
+    for (std::size_t i = 0; i < perSymbol; i++) {
+        const BarSpec& spec = barSpecs[i];
+        Series& s = series[base + i];
+        
+        if (spec.type == BarType::TIME) {
+            const std::int64_t bucket = tick.timestamp / spec.size;
+            if (s.current.ticks != 0 && bucket != s.bucket) complete(base + i);
+            if (s.current.ticks == 0) {
+                s.bucket = bucket;
+                open(s, tick, bucket * spec.size);
+            } else {
+                extend(s.current, tick);
+            }
+        } else {
+            if (s.current.ticks == 0) {
+                open(s, tick, tick.timestamp);
+            } else {
+                extend(s.current, tick);
+            }
+            const std::int64_t filled = (spec.type == BarType::TICK) ? s.current.ticks : s.current.volume;
+            if (filled >= spec.size) complete(base + i);
+        }
+    }
+}
+
+void BarAggregator::closeElapsed(std::int64_t now) {
+    for (std::size_t index = 0; index < series.size(); index++) {
+        const BarSpec& spec = barSpecs[index % barSpecs.size()];
+        const Series& s = series[index];
+        if (spec.type == BarType::TIME && s.current.ticks != 0 && now >= (s.bucket + 1) * spec.size) {
+            complete(index);
+        }
+    }
+}
+
+void BarAggregator::reset() {
+    series.clear();
+    history.clear();
+    totalCompleted = 0;
+    sourceGeneration = 0;
+    processed = 0;
+}
+
+void BarAggregator::update(const TickStore& ticks) {
+    if (ticks.generation() != sourceGeneration || ticks.size() < processed) {
+        reset();
+        sourceGeneration = ticks.generation();
+    }
+    
+    for (std::size_t row = processed; row < ticks.size(); row++) {
+        onTick(ticks.tick(row));
+    }
+    processed = ticks.size();
+}
+
+void BarAggregator::subscribe(Strategy& strategy) {
+    subscribe([&strategy](const Bar& bar, std::size_t spec) { strategy.onBar(bar, spec); });
+}
+
+std::size_t BarAggregator::barCount(SymbolId symbol, std::size_t spec) const {
+    const std::size_t index = static_cast<std::size_t>(symbol) * barSpecs.size() + spec;
+    if (symbol == INVALID_SYMBOL || index >= series.size()) return 0;
+    return static_cast<std::size_t>(std::min<std::uint64_t>(series[index].completed, capacity));
+}
+
+const Bar& BarAggregator::bar(SymbolId symbol, std::size_t spec, std::size_t ago) const {
+    const std::size_t index = static_cast<std::size_t>(symbol) * barSpecs.size() + spec;
+    const std::uint64_t n = series[index].completed - 1 - ago;
+    return history[index * capacity + (n & (capacity - 1))];
+}
+
+const Bar* BarAggregator::current(SymbolId symbol, std::size_t spec) const {
+    const std::size_t index = static_cast<std::size_t>(symbol) * barSpecs.size() + spec;
+    if (symbol == INVALID_SYMBOL || index >= series.size() || series[index].current.ticks == 0) return nullptr;
+    return &series[index].current;
+}
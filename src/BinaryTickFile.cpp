@@ -0,0 +1,200 @@
+#include "BinaryTickFile.h"
+#include "MappedFile.h"
+#include "TickLoader.h"
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+constexpr std::uint64_t BLOCK_ALIGNMENT = 64;
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+}
+
+void padTo(std::ofstream& out, std::uint64_t& written, std::uint64_t offset) {
+    static const char zeros[BLOCK_ALIGNMENT] = {};
+    out.write(zeros, offset - written);
+    written = offset;
+}
+
+template <typename T>
+void writeBlock(std::ofstream& out, std::uint64_t& written, const T* values, std::size_t count) {
+    out.write(reinterpret_cast<const char*>(values), count * sizeof(T));
+    written += count * sizeof(T);
+}
+
+bool blockFits(std::uint64_t offset, std::uint64_t bytes, std::size_t fileSize) {
+    return offset % BLOCK_ALIGNMENT == 0 && offset <= fileSize && bytes <= fileSize - offset;
+}
+
+} // namespace
+
+bool writeBinaryTicks(const std::string& path, const TickStore& store) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) return false;
+    
+    const SymbolTable& symbols = store.symbolTable();
+    const std::uint64_t rows = store.size();
+    
+    TickFileHeader header = {};
+    std::memcpy(header.magic, TICK_FILE_MAGIC, sizeof(header.magic));
+    header.version = TICK_FILE_VERSION;
+    header.symbolCount = static_cast<std::uint32_t>(symbols.size());
+    header.rowCount = rows;
+    header.dictionaryOffset = sizeof(TickFileHeader);
+    
+    std::uint64_t dictionaryBytes = 0;
+    for (SymbolId id = 0; id < symbols.size(); id++) {
+        dictionaryBytes += sizeof(std::uint32_t) + sizeof(std::uint16_t) + symbols.name(id).size();
+    }
+    header.timestampOffset = alignUp(header.dictionaryOffset + dictionaryBytes);
+    header.symbolIdOffset = alignUp(header.timestampOffset + rows * sizeof(std::int64_t));
+    header.priceOffset = alignUp(header.symbolIdOffset + rows * sizeof(SymbolId));
+    header.volumeOffset = alignUp(header.priceOffset + rows * sizeof(Price));
+    header.symbolRowsOffset = alignUp(header.volumeOffset + rows * sizeof(int));
+    
+    std::uint64_t written = 0;
+    writeBlock(out, written, &header, 1);
+    
+    for (SymbolId id = 0; id < symbols.size(); id++) {
+        const std::string& name = symbols.name(id);
+        std::uint32_t rowCount = static_cast<std::uint32_t>(store.rowsFor(id).size());
+        std::uint16_t nameLength = static_cast<std::uint16_t>(name.size());
+        writeBlock(out, written, &rowCount, 1);
+        writeBlock(out, written, &nameLength, 1);
+        writeBlock(out, written, name.data(), name.size());
+    }
+    
+    padTo(out, written, header.timestampOffset);
+    writeBlock(out, written, store.timestampColumn().data(), rows);
+    padTo(out, written, header.symbolIdOffset);
+    writeBlock(out, written, store.symbolColumn().data(), rows);
+    padTo(out, written, header.priceOffset);
+    writeBlock(out, written, store.priceColumn().data(), rows);
+    padTo(out, written, header.volumeOffset);
+    writeBlock(out, written, store.volumeColumn().data(), rows);
+    padTo(out, written, header.symbolRowsOffset);
+    for (SymbolId id = 0; id < symbols.size(); id++) {
+        const auto& symbolRows = store.rowsFor(id);
+        writeBlock(out, written, symbolRows.data(), symbolRows.size());
+    }
+    
+    return out.good();
+}
+
+bool loadBinaryTicks(const std::string& path, TickStore& store) {
+    MappedFile file;
+    if (!file.open(path) || file.size() < sizeof(TickFileHeader)) return false;
+    
+    TickFileHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, TICK_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TICK_FILE_VERSION) {
+        return false;
+    }
+    
+    const std::uint64_t rows = header.rowCount;
+    const std::size_t fileSize = file.size();
+    if (rows > UINT32_MAX ||
+        !blockFits(header.timestampOffset, rows * sizeof(std::int64_t), fileSize) ||
+        !blockFits(header.symbolIdOffset, rows * sizeof(SymbolId), fileSize) ||
+        !blockFits(header.priceOffset, rows * sizeof(Price), fileSize) ||
+        !blockFits(header.volumeOffset, rows * sizeof(int), fileSize) ||
+        !blockFits(header.symbolRowsOffset, rows * sizeof(std::uint32_t), fileSize)) {
+        return false;
+    }
+    // The dictionary sits between the header and the first column, and each
+    // entry takes at least its row count and name length
+    constexpr std::uint64_t MIN_ENTRY_BYTES = sizeof(std::uint32_t) + sizeof(std::uint16_t);
+    if (header.dictionaryOffset < sizeof(TickFileHeader) || header.dictionaryOffset > header.timestampOffset ||
+        header.symbolCount > (header.timestampOffset - header.dictionaryOffset) / MIN_ENTRY_BYTES) {
+        return false;
+    }
+    
+    // Read the dictionary before touching the store so a corrupt file leaves it intact
+    std::vector<std::string_view> names;
+    std::vector<std::uint32_t> rowCounts;
+    names.reserve(header.symbolCount);
+    rowCounts.reserve(header.symbolCount);
+    
+    const char* p = file.data() + header.dictionaryOffset;
+    const char* dictionaryEnd = file.data() + header.timestampOffset;
+    std::uint64_t indexedRows = 0;
+    for (std::uint32_t i = 0; i < header.symbolCount; i++) {
+        std::uint32_t rowCount;
+        std::uint16_t nameLength;
+        if (dictionaryEnd - p < static_cast<std::ptrdiff_t>(sizeof(rowCount) + sizeof(nameLength))) return false;
+        std::memcpy(&rowCount, p, sizeof(rowCount));
+        std::memcpy(&nameLength, p + sizeof(rowCount), sizeof(nameLength));
+        p += sizeof(rowCount) + sizeof(nameLength);
+        if (dictionaryEnd - p < nameLength) return false;
+        
+        names.emplace_back(p, nameLength);
+        rowCounts.push_back(rowCount);
+        indexedRows += rowCount;
+        p += nameLength;
+    }
+    if (indexedRows != rows) return false;
+    
+    // File IDs are the writer's global IDs; the column is used as-is only when
+    // they match this process's table, otherwise it is translated
+    std::vector<SymbolId> remap;
+    remap.reserve(names.size());
+    bool sameIds = true;
+    for (std::string_view name : names) {
+        remap.push_back(internSymbol(name));
+        sameIds = sameIds && remap.back() == remap.size() - 1;
+    }
+    const SymbolId* symbolData = reinterpret_cast<const SymbolId*>(file.data() + header.symbolIdOffset);
+    for (std::uint64_t i = 0; i < rows; i++) {
+        if (symbolData[i] >= names.size()) return false;
+    }
+    
+    // Every per-symbol row must be in range and hold that symbol, since the
+    // store seeds its price history through them
+    const std::uint32_t* symbolRowData = reinterpret_cast<const std::uint32_t*>(file.data() + header.symbolRowsOffset);
+    const std::uint32_t* symbolRows = symbolRowData;
+    for (SymbolId id = 0; id < rowCounts.size(); id++) {
+        for (std::uint32_t i = 0; i < rowCounts[id]; i++) {
+            if (symbolRows[i] >= rows || symbolData[symbolRows[i]] != id) return false;
+        }
+        symbolRows += rowCounts[id];
+    }
+    
+    std::vector<SymbolId> translated;
+    if (!sameIds) {
+        translated.resize(rows);
+        for (std::uint64_t i = 0; i < rows; i++) {
+            translated[i] = remap[symbolData[i]];
+        }
+        symbolData = translated.data();
+    }
+    
+    store.clear();
+    store.assignColumns(
+        reinterpret_cast<const std::int64_t*>(file.data() + header.timestampOffset),
+        symbolData,
+        reinterpret_cast<const Price*>(file.data() + header.priceOffset),
+        reinterpret_cast<const int*>(file.data() + header.volumeOffset),
+        rows);
+    
+    symbolRows = symbolRowData;
+    for (SymbolId id = 0; id < rowCounts.size(); id++) {
+        if (rowCounts[id] != 0) store.assignSymbolRows(remap[id], symbolRows, rowCounts[id]);
+        symbolRows += rowCounts[id];
+    }
+    return true;
+}
+
+bool isBinaryTickFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(TICK_FILE_MAGIC)];
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, TICK_FILE_MAGIC, sizeof(magic)) == 0;
+}
+
+bool convertCsvToBinary(const std::string& csvPath, const std::string& binaryPath) {
+    TickStore store;
+    return loadTicksMapped(csvPath, store) && writeBinaryTicks(binaryPath, store);
+}
@@ -0,0 +1,139 @@
+#include "Clock.h"
+#include <cstdio>
+#include <ctime>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+Clock::Calibration Clock::state;
+
+namespace {
+
+bool hasInvariantTsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) return false;
+    return (edx & (1u << 8)) != 0;  // CPUID.80000007H:EDX[8] = invariant TSC
+#else
+    return false;
+#endif
+}
+
+std::int64_t readClock(clockid_t id) {
+    timespec ts;
+    clock_gettime(id, &ts);
+    return ts.tv_sec * NANOS_PER_SECOND + ts.tv_nsec;
+}
+
+bool parseTwoDigits(const char* p, int& value) {
+    if (p[0] < '0' || p[0] > '9' || p[1] < '0' || p[1] > '9') return false;
+    value = (p[0] - '0') * 10 + (p[1] - '0');
+    return true;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// Pair a TSC reading with a clock reading, keeping the tightest bracket of
+// several attempts so a preemption between the two reads does not skew it
+void sampleTscAgainst(clockid_t id, std::uint64_t& tsc, std::int64_t& nanos) {
+    std::uint64_t best = UINT64_MAX;
+    for (int attempt = 0; attempt < 16; attempt++) {
+        std::uint64_t before = __rdtsc();
+        std::int64_t clockNanos = readClock(id);
+        std::uint64_t after = __rdtsc();
+        if (after - before < best) {
+            best = after - before;
+            tsc = before + (after - before) / 2;
+            nanos = clockNanos;
+        }
+    }
+}
+#endif
+
+// Runs calibration before main so every timestamp comes from one timeline
+const bool calibratedAtStartup = (Clock::calibrate(), true);
+
+} // namespace
+
+void Clock::calibrate(std::int64_t intervalNanos) {
+    Calibration next;
+    next.monotonicOffset = readClock(CLOCK_REALTIME) - readClock(CLOCK_MONOTONIC);
+    
+#if defined(__x86_64__) || defined(__i386__)
+    if (hasInvariantTsc()) {
+        std::uint64_t startTicks = 0, endTicks = 0;
+        std::int64_t startNanos = 0, endNanos = 0;
+        sampleTscAgainst(CLOCK_MONOTONIC, startTicks, startNanos);
+        while (readClock(CLOCK_MONOTONIC) - startNanos < intervalNanos) {
+        }
+        sampleTscAgainst(CLOCK_MONOTONIC, endTicks, endNanos);
+        
+        if (endTicks > startTicks) {
+            next.nanosPerTick = static_cast<std::uint64_t>(
+                (static_cast<unsigned __int128>(endNanos - startNanos) << 32) / (endTicks - startTicks));
+            next.baseTicks = endTicks;
+            next.baseNanos = endNanos + next.monotonicOffset;
+            next.tsc = next.nanosPerTick != 0;
+        }
+    }
+#endif
+    state = next;
+}
+
+std::string formatTimestamp(std::int64_t epochNanos) {
+    std::int64_t seconds = epochNanos / NANOS_PER_SECOND;
+    std::int64_t fraction = epochNanos % NANOS_PER_SECOND;
+    if (fraction < 0) {
+        seconds--;
+        fraction += NANOS_PER_SECOND;
+    }
+    
+    time_t wall = static_cast<time_t>(seconds);
+    tm local;
+    localtime_r(&wall, &local);
+    
+    char buffer[48];
+    std::size_t len = std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+    len += std::snprintf(buffer + len, sizeof(buffer) - len, ".%09lld", static_cast<long long>(fraction));
+    return std::string(buffer, len);
+}
+
+bool parseTimeOfDay(std::string_view text, std::int64_t& nanos) {
+    if (text.size() < 8 || text[2] != ':' || text[5] != ':') return false;
+    
+    int hh, mm, ss;
+    if (!parseTwoDigits(text.data(), hh) || !parseTwoDigits(text.data() + 3, mm) ||
+        !parseTwoDigits(text.data() + 6, ss)) {
+        return false;
+    }
+    if (hh > 23 || mm > 59 || ss > 60) return false;
+    
+    std::int64_t fraction = 0;
+    if (text.size() > 8) {
+        if (text[8] != '.' || text.size() == 9 || text.size() > 18) return false;
+        std::int64_t scale = NANOS_PER_SECOND;
+        for (std::size_t i = 9; i < text.size(); i++) {
+            if (text[i] < '0' || text[i] > '9') return false;
+            scale /= 10;
+            fraction += (text[i] - '0') * scale;
+        }
+    }
+    
+    nanos = ((hh * 60LL + mm) * 60LL + ss) * NANOS_PER_SECOND + fraction;
+    return true;
+}
+
+std::string formatTimeOfDay(std::int64_t nanos) {
+    std::int64_t seconds = nanos / NANOS_PER_SECOND;
+    std::int64_t fraction = nanos % NANOS_PER_SECOND;
+    
+    char buffer[32];
+    int len = std::snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d",
+                            static_cast<int>(seconds / 3600), static_cast<int>((seconds / 60) % 60),
+                            static_cast<int>(seconds % 60));
+    if (fraction != 0) {
+        len += std::snprintf(buffer + len, sizeof(buffer) - len, ".%09lld",
+                             static_cast<long long>(fraction));
+        while (buffer[len - 1] == '0') buffer[--len] = '\0';
+    }
+    return std::string(buffer, len);
+}
@@ -1,19 +1,38 @@
 #include "ExchangeAPI.h"
+#include "AsyncLogger.h"
+#include "Clock.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sstream>
 #include <random>
 #include <thread>
 #include <chrono>
 
-SimulatedExchange::SimulatedExchange() {
+namespace {
+
+// Balances are exact: cash in Price units, shares whole. Quantities arrive as
+// doubles, so they are bounded before the conversion, and notionals must fit
+// a Price.
+constexpr double MAX_ORDER_SHARES = 1e15;
+
+bool notionalFits(Price price, std::int64_t shares) {
+    const std::int64_t raw = price.raw() < 0 ? -price.raw() : price.raw();
+    return raw == 0 || shares <= INT64_MAX / raw;
+}
+
+} // namespace
+
+SimulatedExchange::SimulatedExchange() : cash(internSymbol("USD")) {
     // Initialize with some starting balances
-    accountBalances["USD"] = 10000.0;  // $10,000 starting cash
-    accountBalances["AAPL"] = 0.0;
-    accountBalances["MSFT"] = 0.0;
+    for (SymbolId asset : {cash, knownSymbol("AAPL"), knownSymbol("MSFT")}) {
+        instrument(asset).held = true;
+    }
+    instrument(cash).funds = Price::fromRaw(10000 * Price::SCALE);  // $10,000 starting cash
     
     // Set initial market prices
-    marketPrices["AAPL"] = 150.25;
-    marketPrices["MSFT"] = 280.15;
+    setMarketPrice("AAPL", Price::fromDouble(150.25));
+    setMarketPrice("MSFT", Price::fromDouble(280.15));
     
     connected = false;
 }
@@ -36,25 +55,26 @@ bool SimulatedExchange::authenticate(const ExchangeCredentials& creds) {
     return true;
 }
 
-bool SimulatedExchange::getMarketPrice(const std::string& symbol, double& price) {
+bool SimulatedExchange::getMarketPrice(const std::string& symbol, Price& price) {
     if (!connected) {
         lastError = "Not connected to exchange";
         return false;
     }
     
-    auto it = marketPrices.find(symbol);
-    if (it == marketPrices.end()) {
+    SymbolId id = findSymbolId(symbol);
+    if (id >= instruments.size() || !instruments[id].quoted) {
         lastError = "Symbol not found: " + symbol;
         return false;
     }
+    Instrument& listing = instruments[id];
     
     // Add small random price movement to simulate live market
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_real_distribution<> dis(-0.5, 0.5);
     
-    price = it->second + dis(gen);
-    marketPrices[symbol] = price; // Update stored price
+    price = (listing.marketPrice + Price::fromDouble(dis(gen))).roundToTick(listing.tickSize);
+    listing.marketPrice = price; // Update stored price
     
     return true;
 }
@@ -69,80 +89,130 @@ bool SimulatedExchange::subscribeToMarketData(const std::string& symbol) {
     return true;
 }
 
-std::string SimulatedExchange::placeOrder(const std::string& symbol, const std::string& side, 
-                                        double quantity, double price) {
+OrderId SimulatedExchange::placeOrder(const std::string& symbol, const std::string& side, 
+                                   double quantity, Price price) {
     if (!connected) {
         lastError = "Not connected to exchange";
-        return "";
+        return INVALID_ORDER_ID;
     }
     
-    // Generate order ID
-    std::string orderId = "SIM_" + std::to_string(nextOrderId++);
-    
-    // Create exchange order
-    ExchangeOrder order;
-    order.exchangeOrderId = orderId;
-    order.symbol = symbol;
-    order.side = side;
-    order.quantity = quantity;
-    order.price = price;
-    order.status = "open";
-    
-    // Get current timestamp
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    order.timestamp = std::ctime(&time_t);
+    const SymbolId id = internSymbol(symbol);
+    if (!price.isOnTick(instrument(id).tickSize)) {
+        lastError = "Price is not a multiple of the " + symbol + " tick size";
+        return INVALID_ORDER_ID;
+    }
+    if (quantity <= 0 || quantity != std::floor(quantity) || quantity > MAX_ORDER_SHARES) {
+        lastError = "Quantity must be a positive whole number of shares";
+        return INVALID_ORDER_ID;
+    }
+    const std::int64_t shares = static_cast<std::int64_t>(quantity);
+    if (!notionalFits(price, shares)) {
+        lastError = "Order notional out of range";
+        return INVALID_ORDER_ID;
+    }
     
     // Check if we have sufficient balance
-    double required = quantity * price;
-    if (side == "buy" && accountBalances["USD"] < required) {
+    if (side == "buy" && instrument(cash).funds < price * shares) {
         lastError = "Insufficient USD balance";
-        return "";
+        return INVALID_ORDER_ID;
     }
     
-    if (side == "sell" && accountBalances[symbol] < quantity) {
+    if (side == "sell" && instrument(id).shares < shares) {
         lastError = "Insufficient " + symbol + " balance";
-        return "";
+        return INVALID_ORDER_ID;
     }
     
-    openOrders.push_back(order);
+    const OrderType type = (side == "buy") ? OrderType::BUY : OrderType::SELL;
+    const OrderId orderId = nextOrderId(Venue::SIMULATED);
+    Order* order = orderPool.template allocate<Order>(orderId, id, type, shares, price);
+    order->onEvent(OrderEvent::ACK);
+    openOrders.insert(orderId, order);
     
-    std::cout << "📝 Order placed: " << orderId << " | " << side << " " 
-              << quantity << " " << symbol << " @ $" << price << std::endl;
+    logAsync("📝 Order placed: {} | {} {} {} @ ${}", orderId, side, quantity, symbol, price.toDouble());
     
-    // Simulate immediate fill (in real exchange, this would be partial/delayed)
-    simulateOrderFill(orderId);
+    // Marketable against the simulated price: fill in full right away unless
+    // the test harness wants orders to rest
+    if (immediateFills) {
+        simulateOrderFill(orderId);
+    }
     
     return orderId;
 }
 
-bool SimulatedExchange::cancelOrder(const std::string& orderId) {
+bool SimulatedExchange::cancelOrder(OrderId orderId) {
     if (!connected) {
         lastError = "Not connected to exchange";
         return false;
     }
     
-    for (auto& order : openOrders) {
-        if (order.exchangeOrderId == orderId && order.status == "open") {
-            order.status = "cancelled";
-            std::cout << "❌ Order cancelled: " << orderId << std::endl;
-            return true;
-        }
+    // Nothing is in flight inside the simulator, so the cancel is acknowledged at once
+    Order* order = findOpen(orderId);
+    if (order != nullptr && order->onEvent(OrderEvent::CANCEL_REQUEST)) {
+        order->onEvent(OrderEvent::CANCEL_ACK);
+        close(order);
+        logAsync("❌ Order cancelled: {}", orderId);
+        return true;
     }
     
-    lastError = "Order not found or already processed: " + orderId;
+    lastError = "Order not found or already processed: " + std::to_string(orderId);
     return false;
 }
 
-std::vector<ExchangeOrder> SimulatedExchange::getOpenOrders() {
-    std::vector<ExchangeOrder> result;
+bool SimulatedExchange::amendOrder(OrderId orderId, double quantity, Price price) {
+    if (!connected) {
+        lastError = "Not connected to exchange";
+        return false;
+    }
     
-    for (const auto& order : openOrders) {
-        if (order.status == "open") {
-            result.push_back(order);
-        }
+    Order* order = findOpen(orderId);
+    if (order == nullptr) {
+        lastError = "Order not found or already processed: " + std::to_string(orderId);
+        return false;
+    }
+    if (!price.isOnTick(instrument(order->symbol).tickSize)) {
+        lastError = "Price is not a multiple of the " + symbolName(order->symbol) + " tick size";
+        return false;
+    }
+    if (quantity <= 0 || quantity != std::floor(quantity) || quantity > MAX_ORDER_SHARES) {
+        lastError = "Quantity must be a positive whole number of shares";
+        return false;
     }
     
+    const std::int64_t newQuantity = static_cast<std::int64_t>(quantity);
+    if (!notionalFits(price, newQuantity)) {
+        lastError = "Order notional out of range";
+        return false;
+    }
+    const std::int64_t newLeaves = newQuantity - order->filledQuantity;
+    if (order->type == OrderType::BUY && instrument(cash).funds < price * newLeaves) {
+        lastError = "Insufficient USD balance";
+        return false;
+    }
+    if (order->type == OrderType::SELL && instrument(order->symbol).shares < newLeaves) {
+        lastError = "Insufficient " + symbolName(order->symbol) + " balance";
+        return false;
+    }
+    if (!order->amend(newQuantity, price)) {
+        lastError = "Amend rejected: order is " + std::string(order->getStatusString()) +
+                    " with " + std::to_string(order->filledQuantity) + " filled";
+        return false;
+    }
+    
+    logAsync("✏️ Order amended: {} | {} @ ${}", orderId, newQuantity, price.toDouble());
+    return true;
+}
+
+std::vector<ExchangeOrder> SimulatedExchange::getOpenOrders() {
+    std::vector<ExchangeOrder> result;
+    
+    openOrders.forEach([&result](OrderId orderId, const Order* order) {
+        result.push_back({orderId, order->symbol, order->type == OrderType::BUY ? "buy" : "sell",
+                          static_cast<double>(order->quantity), static_cast<double>(order->filledQuantity),
+                          order->price, std::string(order->getStatusString()), order->timestamp});
+    });
+    std::sort(result.begin(), result.end(), [](const ExchangeOrder& a, const ExchangeOrder& b) {
+        return a.timestamp < b.timestamp;
+    });
     return result;
 }
 
@@ -152,7 +222,12 @@ bool SimulatedExchange::getAccountBalance(std::map<std::string, double>& balance
         return false;
     }
     
-    balances = accountBalances;
+    balances.clear();
+    for (SymbolId id = 0; id < instruments.size(); id++) {
+        if (!instruments[id].held) continue;
+        balances[symbolName(id)] = (id == cash) ? instruments[id].funds.toDouble()
+                                                : static_cast<double>(instruments[id].shares);
+    }
     return true;
 }
 
@@ -164,27 +239,74 @@ std::string SimulatedExchange::getLastError() const {
     return lastError;
 }
 
-void SimulatedExchange::setMarketPrice(const std::string& symbol, double price) {
-    marketPrices[symbol] = price;
-}
-
-void SimulatedExchange::simulateOrderFill(const std::string& orderId) {
-    for (auto& order : openOrders) {
-        if (order.exchangeOrderId == orderId && order.status == "open") {
-            // Update balances
-            double amount = order.quantity * order.price;
-            
-            if (order.side == "buy") {
-                accountBalances["USD"] -= amount;
-                accountBalances[order.symbol] += order.quantity;
-            } else { // sell
-                accountBalances["USD"] += amount;
-                accountBalances[order.symbol] -= order.quantity;
-            }
-            
-            order.status = "filled";
-            std::cout << "✅ Order filled: " << orderId << std::endl;
-            break;
-        }
+void SimulatedExchange::setMarketPrice(const std::string& symbol, Price price) {
+    Instrument& listing = instrument(internSymbol(symbol));
+    listing.marketPrice = price;
+    listing.quoted = true;
+}
+
+void SimulatedExchange::setTickSize(const std::string& symbol, Price tickSize) {
+    instrument(internSymbol(symbol)).tickSize = tickSize;
+}
+
+void SimulatedExchange::setCash(Price amount) {
+    Instrument& account = instrument(cash);
+    account.funds = amount;
+    account.held = true;
+}
+
+void SimulatedExchange::setShares(const std::string& symbol, std::int64_t shares) {
+    Instrument& account = instrument(internSymbol(symbol));
+    account.shares = shares;
+    account.held = true;
+}
+
+SimulatedExchange::Instrument& SimulatedExchange::instrument(SymbolId symbol) {
+    if (symbol >= instruments.size()) {
+        instruments.resize(symbol + 1);
     }
+    return instruments[symbol];
+}
+
+Order* SimulatedExchange::findOpen(OrderId orderId) {
+    Order** order = openOrders.find(orderId);
+    return (order != nullptr) ? *order : nullptr;
+}
+
+void SimulatedExchange::close(Order* order) {
+    openOrders.erase(order->orderId);
+    orderPool.deallocate(order);
+}
+
+bool SimulatedExchange::simulateOrderFill(OrderId orderId, double quantity) {
+    Order* order = findOpen(orderId);
+    if (order == nullptr) return false;
+    const std::int64_t fillQuantity = (quantity > 0) ? static_cast<std::int64_t>(quantity) : order->leaves();
+    if (!order->onFill(fillQuantity)) return false;
+    
+    // Update balances
+    const Price amount = order->price * fillQuantity;
+    
+    Instrument& cashAccount = instrument(cash);
+    Instrument& asset = instrument(order->symbol);
+    if (order->type == OrderType::BUY) {
+        cashAccount.funds -= amount;
+        asset.shares += fillQuantity;
+    } else { // sell
+        cashAccount.funds += amount;
+        asset.shares -= fillQuantity;
+    }
+    cashAccount.held = true;
+    asset.held = true;
+    
+    if (fillHandler) {
+        fillHandler(VenueFill{orderId, fillQuantity, order->price});
+    }
+    if (order->status == OrderStatus::FILLED) {
+        close(order);
+        logAsync("✅ Order filled: {}", orderId);
+    } else {
+        logAsync("✅ Order partially filled: {} | {} of {}", orderId, order->filledQuantity, order->quantity);
+    }
+    return true;
 }
@@ -30,14 +30,14 @@ bool ExchangeManager::isConnected() const {
     return connected && exchange->isConnected();
 }
 
-bool ExchangeManager::getLivePrice(const std::string& symbol, double& price) {
+bool ExchangeManager::getLivePrice(const std::string& symbol, Price& price) {
     if (!isConnected()) {
         std::cout << "❌ Not connected to exchange" << std::endl;
         return false;
     }
     
     if (exchange->getMarketPrice(symbol, price)) {
-        std::cout << "💹 Live price for " << symbol << ": $" << std::fixed << std::setprecision(2) << price << std::endl;
+        std::cout << "💹 Live price for " << symbol << ": $" << std::fixed << std::setprecision(2) << price.toDouble() << std::endl;
         return true;
     } else {
         std::cout << "❌ Failed to get price: " << exchange->getLastError() << std::endl;
@@ -45,17 +45,17 @@ bool ExchangeManager::getLivePrice(const std::string& symbol, double& price) {
     }
 }
 
-std::string ExchangeManager::executeLiveOrder(const std::string& symbol, const std::string& side, 
-                                            double quantity, double price) {
+OrderId ExchangeManager::executeLiveOrder(const std::string& symbol, const std::string& side, 
+                                         double quantity, Price price) {
     if (!isConnected()) {
         std::cout << "❌ Not connected to exchange" << std::endl;
-        return "";
+        return INVALID_ORDER_ID;
     }
     
     std::cout << "\n🚀 Executing LIVE order..." << std::endl;
-    std::string orderId = exchange->placeOrder(symbol, side, quantity, price);
+    const OrderId orderId = exchange->placeOrder(symbol, side, quantity, price);
     
-    if (!orderId.empty()) {
+    if (orderId != INVALID_ORDER_ID) {
         std::cout << "✅ Live order executed successfully! Order ID: " << orderId << std::endl;
     } else {
         std::cout << "❌ Order execution failed: " << exchange->getLastError() << std::endl;
@@ -100,7 +100,8 @@ void ExchangeManager::showLiveOrders() {
     for (const auto& order : orders) {
         std::cout << "Order " << order.exchangeOrderId << " | " 
                   << order.side << " " << order.quantity << " " 
-                  << order.symbol << " @ $" << order.price 
+                  << symbolName(order.symbol) << " @ $" << order.price 
+                  << " | Filled: " << order.filledQuantity
                   << " | Status: " << order.status << std::endl;
     }
 }
@@ -0,0 +1,687 @@
+#include "IndicatorKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define HFT_SIMD_KERNELS 1
+#define SCALAR_TARGET __attribute__((target("arch=x86-64")))
+#define AVX2_TARGET __attribute__((target("avx2")))
+#define AVX512_TARGET __attribute__((target("avx512f,avx512dq")))
+#else
+#define SCALAR_TARGET
+#endif
+
+namespace {
+
+// Rolling sums are updated incrementally and re-anchored with an exact sum
+// this often, so floating-point drift cannot build up over long columns
+constexpr std::size_t REANCHOR_EVERY = 4096;
+
+// ---- Scalar (portable baseline) ----
+
+SCALAR_TARGET double scalarSum(const double* x, std::size_t n) {
+    double sum = 0.0;
+    for (std::size_t i = 0; i < n; i++) sum += x[i];
+    return sum;
+}
+
+SCALAR_TARGET std::int64_t scalarSumFixed(const std::int64_t* raw, std::size_t n) {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < n; i++) sum += raw[i];
+    return sum;
+}
+
+SCALAR_TARGET void scalarMinMax(const double* x, std::size_t n, double& low, double& high) {
+    low = std::numeric_limits<double>::infinity();
+    high = -std::numeric_limits<double>::infinity();
+    for (std::size_t i = 0; i < n; i++) {
+        low = std::min(low, x[i]);
+        high = std::max(high, x[i]);
+    }
+}
+
+SCALAR_TARGET void scalarMinMaxFixed(const std::int64_t* raw, std::size_t n, std::int64_t& low, std::int64_t& high) {
+    low = INT64_MAX;
+    high = INT64_MIN;
+    for (std::size_t i = 0; i < n; i++) {
+        low = std::min(low, raw[i]);
+        high = std::max(high, raw[i]);
+    }
+}
+
+SCALAR_TARGET double scalarVwap(const double* price, const int* volume, std::size_t n) {
+    double notional = 0.0;
+    double shares = 0.0;
+    for (std::size_t i = 0; i < n; i++) {
+        notional += price[i] * volume[i];
+        shares += volume[i];
+    }
+    return shares > 0.0 ? notional / shares : 0.0;
+}
+
+SCALAR_TARGET double scalarVwapFixed(const std::int64_t* raw, const int* volume, std::size_t n) {
+    std::int64_t notional = 0;
+    std::int64_t shares = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        notional += raw[i] * volume[i];
+        shares += volume[i];
+    }
+    return shares > 0 ? static_cast<double>(notional) / shares / Price::SCALE : 0.0;
+}
+
+SCALAR_TARGET void scalarReturns(const double* x, std::size_t n, double* out) {
+    for (std::size_t i = 0; i + 1 < n; i++) out[i] = x[i + 1] / x[i] - 1.0;
+}
+
+SCALAR_TARGET void scalarRollingMean(const double* x, std::size_t n, std::size_t window, double* out) {
+    if (window == 0) return;
+    std::fill(out, out + std::min(n, window - 1), 0.0);
+    double sum = 0.0;
+    for (std::size_t i = window - 1; i < n; i++) {
+        if ((i - (window - 1)) % REANCHOR_EVERY == 0) {
+            sum = scalarSum(x + i + 1 - window, window);
+        } else {
+            sum += x[i] - x[i - window];
+        }
+        out[i] = sum / window;
+    }
+}
+
+SCALAR_TARGET void scalarRollingStddev(const double* x, std::size_t n, std::size_t window, double* out) {
+    if (window == 0 || n == 0) return;
+    std::fill(out, out + std::min(n, window - 1), 0.0);
+    const double ref = x[0];  // shifting by a nearby value keeps sum-of-squares accurate
+    double sum = 0.0;
+    double sumSq = 0.0;
+    for (std::size_t i = window - 1; i < n; i++) {
+        if ((i - (window - 1)) % REANCHOR_EVERY == 0) {
+            sum = 0.0;
+            sumSq = 0.0;
+            for (std::size_t k = i + 1 - window; k <= i; k++) {
+                double y = x[k] - ref;
+                sum += y;
+                sumSq += y * y;
+            }
+        } else {
+            double in = x[i] - ref;
+            double outgoing = x[i - window] - ref;
+            sum += in - outgoing;
+            sumSq += in * in - outgoing * outgoing;
+        }
+        double mean = sum / window;
+        out[i] = std::sqrt(std::max(0.0, sumSq / window - mean * mean));
+    }
+}
+
+SCALAR_TARGET void scalarEma(const double* x, std::size_t n, double alpha, double* out) {
+    if (n == 0) return;
+    double y = x[0];
+    for (std::size_t i = 0; i < n; i++) {
+        y += alpha * (x[i] - y);
+        out[i] = y;
+    }
+}
+
+SCALAR_TARGET void scalarToDouble(const std::int64_t* raw, std::size_t n, double* out) {
+    for (std::size_t i = 0; i < n; i++) out[i] = static_cast<double>(raw[i]) / Price::SCALE;
+}
+
+#ifdef HFT_SIMD_KERNELS
+
+// ---- AVX2 (4 x double / int64 per register) ----
+
+AVX2_TARGET inline double hsum(__m256d v) {
+    __m128d low = _mm256_castpd256_pd128(v);
+    __m128d high = _mm256_extractf128_pd(v, 1);
+    low = _mm_add_pd(low, high);
+    return _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+}
+
+AVX2_TARGET inline std::int64_t hsum(__m256i v) {
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), v);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// Lanes moved up by one / two positions, zeros shifted in
+AVX2_TARGET inline __m256d shiftUp1(__m256d v) {
+    return _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(2, 1, 0, 0)), _mm256_setzero_pd(), 0b0001);
+}
+AVX2_TARGET inline __m256d shiftUp2(__m256d v) {
+    return _mm256_blend_pd(_mm256_permute4x64_pd(v, _MM_SHUFFLE(1, 0, 0, 0)), _mm256_setzero_pd(), 0b0011);
+}
+
+// Inclusive prefix sum across the four lanes
+AVX2_TARGET inline __m256d prefixSum(__m256d v) {
+    v = _mm256_add_pd(v, shiftUp1(v));
+    return _mm256_add_pd(v, shiftUp2(v));
+}
+
+AVX2_TARGET inline __m256d broadcastLast(__m256d v) {
+    return _mm256_permute4x64_pd(v, _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+// int64 -> double for |x| < 2^51 (always true for Price columns)
+AVX2_TARGET inline __m256d int64ToDouble(__m256i v) {
+    const __m256d magic = _mm256_set1_pd(6755399441055744.0);  // 2^52 + 2^51
+    __m256i biased = _mm256_add_epi64(v, _mm256_castpd_si256(magic));
+    return _mm256_sub_pd(_mm256_castsi256_pd(biased), magic);
+}
+
+AVX2_TARGET double avx2Sum(const double* x, std::size_t n) {
+    __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(x + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(x + i + 4));
+        acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(x + i + 8));
+        acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(x + i + 12));
+    }
+    for (; i + 4 <= n; i += 4) acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(x + i));
+    double sum = hsum(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+    for (; i < n; i++) sum += x[i];
+    return sum;
+}
+
+AVX2_TARGET std::int64_t avx2SumFixed(const std::int64_t* raw, std::size_t n) {
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw + i)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw + i + 4)));
+    }
+    std::int64_t sum = hsum(_mm256_add_epi64(acc0, acc1));
+    for (; i < n; i++) sum += raw[i];
+    return sum;
+}
+
+AVX2_TARGET void avx2MinMax(const double* x, std::size_t n, double& low, double& high) {
+    __m256d lo = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    __m256d hi = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        lo = _mm256_min_pd(lo, v);
+        hi = _mm256_max_pd(hi, v);
+    }
+    alignas(32) double los[4], his[4];
+    _mm256_store_pd(los, lo);
+    _mm256_store_pd(his, hi);
+    low = std::min(std::min(los[0], los[1]), std::min(los[2], los[3]));
+    high = std::max(std::max(his[0], his[1]), std::max(his[2], his[3]));
+    for (; i < n; i++) {
+        low = std::min(low, x[i]);
+        high = std::max(high, x[i]);
+    }
+}
+
+AVX2_TARGET void avx2MinMaxFixed(const std::int64_t* raw, std::size_t n, std::int64_t& low, std::int64_t& high) {
+    __m256i lo = _mm256_set1_epi64x(INT64_MAX);
+    __m256i hi = _mm256_set1_epi64x(INT64_MIN);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw + i));
+        lo = _mm256_blendv_epi8(lo, v, _mm256_cmpgt_epi64(lo, v));
+        hi = _mm256_blendv_epi8(hi, v, _mm256_cmpgt_epi64(v, hi));
+    }
+    alignas(32) std::int64_t los[4], his[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(los), lo);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(his), hi);
+    low = std::min(std::min(los[0], los[1]), std::min(los[2], los[3]));
+    high = std::max(std::max(his[0], his[1]), std::max(his[2], his[3]));
+    for (; i < n; i++) {
+        low = std::min(low, raw[i]);
+        high = std::max(high, raw[i]);
+    }
+}
+
+AVX2_TARGET double avx2Vwap(const double* price, const int* volume, std::size_t n) {
+    __m256d notional = _mm256_setzero_pd();
+    __m256d shares = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(volume + i)));
+        notional = _mm256_add_pd(notional, _mm256_mul_pd(_mm256_loadu_pd(price + i), v));
+        shares = _mm256_add_pd(shares, v);
+    }
+    double totalNotional = hsum(notional);
+    double totalShares = hsum(shares);
+    for (; i < n; i++) {
+        totalNotional += price[i] * volume[i];
+        totalShares += volume[i];
+    }
+    return totalShares > 0.0 ? totalNotional / totalShares : 0.0;
+}
+
+AVX2_TARGET double avx2VwapFixed(const std::int64_t* raw, const int* volume, std::size_t n) {
+    // AVX2 has no 64x64 multiply: raw * volume = low32 * volume + (high32 * volume) << 32
+    __m256i notional = _mm256_setzero_si256();
+    __m256i shares = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw + i));
+        __m256i v = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(volume + i)));
+        __m256i lowPart = _mm256_mul_epu32(p, v);
+        __m256i highPart = _mm256_slli_epi64(_mm256_mul_epi32(_mm256_srli_epi64(p, 32), v), 32);
+        notional = _mm256_add_epi64(notional, _mm256_add_epi64(lowPart, highPart));
+        shares = _mm256_add_epi64(shares, v);
+    }
+    std::int64_t totalNotional = hsum(notional);
+    std::int64_t totalShares = hsum(shares);
+    for (; i < n; i++) {
+        totalNotional += raw[i] * volume[i];
+        totalShares += volume[i];
+    }
+    return totalShares > 0 ? static_cast<double>(totalNotional) / totalShares / Price::SCALE : 0.0;
+}
+
+AVX2_TARGET void avx2Returns(const double* x, std::size_t n, double* out) {
+    if (n < 2) return;
+    const __m256d one = _mm256_set1_pd(1.0);
+    std::size_t i = 0;
+    for (; i + 5 <= n; i += 4) {
+        __m256d r = _mm256_div_pd(_mm256_loadu_pd(x + i + 1), _mm256_loadu_pd(x + i));
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(r, one));
+    }
+    for (; i + 1 < n; i++) out[i] = x[i + 1] / x[i] - 1.0;
+}
+
+AVX2_TARGET void avx2RollingMean(const double* x, std::size_t n, std::size_t window, double* out) {
+    if (window == 0) return;
+    std::fill(out, out + std::min(n, window - 1), 0.0);
+    const __m256d scale = _mm256_set1_pd(1.0 / window);
+    for (std::size_t start = window - 1; start < n; start += REANCHOR_EVERY) {
+        const std::size_t stop = std::min(n, start + REANCHOR_EVERY);
+        double sum = avx2Sum(x + start + 1 - window, window);
+        out[start] = sum / window;
+        
+        // sum(i) = sum(i - 1) + x[i] - x[i - window], four outputs per step
+        std::size_t i = start + 1;
+        __m256d carry = _mm256_set1_pd(sum);
+        for (; i + 4 <= stop; i += 4) {
+            __m256d delta = _mm256_sub_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(x + i - window));
+            __m256d sums = _mm256_add_pd(prefixSum(delta), carry);
+            _mm256_storeu_pd(out + i, _mm256_mul_pd(sums, scale));
+            carry = broadcastLast(sums);
+        }
+        sum = _mm256_cvtsd_f64(carry);
+        for (; i < stop; i++) {
+            sum += x[i] - x[i - window];
+            out[i] = sum / window;
+        }
+    }
+}
+
+AVX2_TARGET void avx2RollingStddev(const double* x, std::size_t n, std::size_t window, double* out) {
+    if (window == 0 || n == 0) return;
+    std::fill(out, out + std::min(n, window - 1), 0.0);
+    const double ref = x[0];
+    const __m256d refs = _mm256_set1_pd(ref);
+    const __m256d scale = _mm256_set1_pd(1.0 / window);
+    const __m256d zero = _mm256_setzero_pd();
+    for (std::size_t start = window - 1; start < n; start += REANCHOR_EVERY) {
+        const std::size_t stop = std::min(n, start + REANCHOR_EVERY);
+        double sum = 0.0;
+        double sumSq = 0.0;
+        for (std::size_t k = start + 1 - window; k <= start; k++) {
+            double y = x[k] - ref;
+            sum += y;
+            sumSq += y * y;
+        }
+        double mean = sum / window;
+        out[start] = std::sqrt(std::max(0.0, sumSq / window - mean * mean));
+        
+        std::size_t i = start + 1;
+        __m256d carry = _mm256_set1_pd(sum);
+        __m256d carrySq = _mm256_set1_pd(sumSq);
+        for (; i + 4 <= stop; i += 4) {
+            __m256d in = _mm256_sub_pd(_mm256_loadu_pd(x + i), refs);
+            __m256d outgoing = _mm256_sub_pd(_mm256_loadu_pd(x + i - window), refs);
+            __m256d sums = _mm256_add_pd(prefixSum(_mm256_sub_pd(in, outgoing)), carry);
+            __m256d sumsSq = _mm256_add_pd(
+                prefixSum(_mm256_sub_pd(_mm256_mul_pd(in, in), _mm256_mul_pd(outgoing, outgoing))), carrySq);
+            __m256d means = _mm256_mul_pd(sums, scale);
+            __m256d variance = _mm256_sub_pd(_mm256_mul_pd(sumsSq, scale), _mm256_mul_pd(means, means));
+            _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_max_pd(variance, zero)));
+            carry = broadcastLast(sums);
+            carrySq = broadcastLast(sumsSq);
+        }
+        sum = _mm256_cvtsd_f64(carry);
+        sumSq = _mm256_cvtsd_f64(carrySq);
+        for (; i < stop; i++) {
+            double in = x[i] - ref;
+            double outgoing = x[i - window] - ref;
+            sum += in - outgoing;
+            sumSq += in * in - outgoing * outgoing;
+            mean = sum / window;
+            out[i] = std::sqrt(std::max(0.0, sumSq / window - mean * mean));
+        }
+    }
+}
+
+AVX2_TARGET void avx2Ema(const double* x, std::size_t n, double alpha, double* out) {
+    if (n == 0) return;
+    // Lane k of a block: y[k] = sum_j b^(k-j) * a * x[j] + b^(k+1) * y[-1], b = 1 - a
+    const double b = 1.0 - alpha;
+    const __m256d a = _mm256_set1_pd(alpha);
+    const __m256d b1 = _mm256_set1_pd(b);
+    const __m256d b2 = _mm256_set1_pd(b * b);
+    const __m256d decay = _mm256_setr_pd(b, b * b, b * b * b, b * b * b * b);
+    __m256d previous = _mm256_set1_pd(x[0]);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d t = _mm256_mul_pd(a, _mm256_loadu_pd(x + i));
+        t = _mm256_add_pd(t, _mm256_mul_pd(b1, shiftUp1(t)));
+        t = _mm256_add_pd(t, _mm256_mul_pd(b2, shiftUp2(t)));
+        __m256d y = _mm256_add_pd(t, _mm256_mul_pd(decay, previous));
+        _mm256_storeu_pd(out + i, y);
+        previous = broadcastLast(y);
+    }
+    double y = _mm256_cvtsd_f64(previous);
+    for (; i < n; i++) {
+        y += alpha * (x[i] - y);
+        out[i] = y;
+    }
+}
+
+AVX2_TARGET void avx2ToDouble(const std::int64_t* raw, std::size_t n, double* out) {
+    const __m256d scale = _mm256_set1_pd(static_cast<double>(Price::SCALE));
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = int64ToDouble(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(raw + i)));
+        _mm256_storeu_pd(out + i, _mm256_div_pd(v, scale));
+    }
+    for (; i < n; i++) out[i] = static_cast<double>(raw[i]) / Price::SCALE;
+}
+
+// ---- AVX-512 (8 x double / int64 per register) ----
+
+// Lanes moved up by k positions, zeros shifted in
+template <int K>
+AVX512_TARGET inline __m512d shiftUp(__m512d v) {
+    const __m512i index = _mm512_setr_epi64(0 - K, 1 - K, 2 - K, 3 - K, 4 - K, 5 - K, 6 - K, 7 - K);
+    return _mm512_maskz_permutexvar_pd(static_cast<__mmask8>(0xFF << K), index, v);
+}
+
+AVX512_TARGET inline __m512d prefixSum(__m512d v) {
+    v = _mm512_add_pd(v, shiftUp<1>(v));
+    v = _mm512_add_pd(v, shiftUp<2>(v));
+    return _mm512_add_pd(v, shiftUp<4>(v));
+}
+
+AVX512_TARGET inline __m512d broadcastLast(__m512d v) {
+    return _mm512_permutexvar_pd(_mm512_set1_epi64(7), v);
+}
+
+AVX512_TARGET double avx512Sum(const double* x, std::size_t n) {
+    __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+    __m512d acc2 = _mm512_setzero_pd(), acc3 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(x + i));
+        acc1 = _mm512_add_pd(acc1, _mm512_loadu_pd(x + i + 8));
+        acc2 = _mm512_add_pd(acc2, _mm512_loadu_pd(x + i + 16));
+        acc3 = _mm512_add_pd(acc3, _mm512_loadu_pd(x + i + 24));
+    }
+    for (; i + 8 <= n; i += 8) acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(x + i));
+    __m512d acc = _mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3));
+    if (i < n) {
+        __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+        acc = _mm512_add_pd(acc, _mm512_maskz_loadu_pd(tail, x + i));
+    }
+    return _mm512_reduce_add_pd(acc);
+}
+
+AVX512_TARGET std::int64_t avx512SumFixed(const std::int64_t* raw, std::size_t n) {
+    __m512i acc0 = _mm512_setzero_si512(), acc1 = _mm512_setzero_si512();
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm512_add_epi64(acc0, _mm512_loadu_si512(raw + i));
+        acc1 = _mm512_add_epi64(acc1, _mm512_loadu_si512(raw + i + 8));
+    }
+    __m512i acc = _mm512_add_epi64(acc0, acc1);
+    for (; i < n; i += 8) {
+        __mmask8 lanes = (n - i >= 8) ? 0xFF : static_cast<__mmask8>((1u << (n - i)) - 1);
+        acc = _mm512_add_epi64(acc, _mm512_maskz_loadu_epi64(lanes, raw + i));
+    }
+    return _mm512_reduce_add_epi64(acc);
+}
+
+AVX512_TARGET void avx512MinMax(const double* x, std::size_t n, double& low, double& high) {
+    __m512d lo = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+    __m512d hi = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+    for (std::size_t i = 0; i < n; i += 8) {
+        __mmask8 lanes = (n - i >= 8) ? 0xFF : static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512d v = _mm512_maskz_loadu_pd(lanes, x + i);
+        lo = _mm512_mask_min_pd(lo, lanes, lo, v);
+        hi = _mm512_mask_max_pd(hi, lanes, hi, v);
+    }
+    low = _mm512_reduce_min_pd(lo);
+    high = _mm512_reduce_max_pd(hi);
+}
+
+AVX512_TARGET void avx512MinMaxFixed(const std::int64_t* raw, std::size_t n, std::int64_t& low, std::int64_t& high) {
+    __m512i lo = _mm512_set1_epi64(INT64_MAX);
+    __m512i hi = _mm512_set1_epi64(INT64_MIN);
+    for (std::size_t i = 0; i < n; i += 8) {
+        __mmask8 lanes = (n - i >= 8) ? 0xFF : static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512i v = _mm512_maskz_loadu_epi64(lanes, raw + i);
+        lo = _mm512_mask_min_epi64(lo, lanes, lo, v);
+        hi = _mm512_mask_max_epi64(hi, lanes, hi, v);
+    }
+    low = _mm512_reduce_min_epi64(lo);
+    high = _mm512_reduce_max_epi64(hi);
+}
+
+AVX512_TARGET double avx512Vwap(const double* price, const int* volume, std::size_t n) {
+    __m512d notional = _mm512_setzero_pd();
+    __m512d shares = _mm512_setzero_pd();
+    for (std::size_t i = 0; i < n; i += 8) {
+        __mmask8 lanes = (n - i >= 8) ? 0xFF : static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512d v = _mm512_cvtepi32_pd(_mm512_castsi512_si256(_mm512_maskz_loadu_epi32(lanes, volume + i)));
+        notional = _mm512_add_pd(notional, _mm512_mul_pd(_mm512_maskz_loadu_pd(lanes, price + i), v));
+        shares = _mm512_add_pd(shares, v);
+    }
+    double totalShares = _mm512_reduce_add_pd(shares);
+    return totalShares > 0.0 ? _mm512_reduce_add_pd(notional) / totalShares : 0.0;
+}
+
+AVX512_TARGET double avx512VwapFixed(const std::int64_t* raw, const int* volume, std::size_t n) {
+    __m512i notional = _mm512_setzero_si512();
+    __m512i shares = _mm512_setzero_si512();
+    for (std::size_t i = 0; i < n; i += 8) {
+        __mmask8 lanes = (n - i >= 8) ? 0xFF : static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512i v = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(_mm512_maskz_loadu_epi32(lanes, volume + i)));
+        notional = _mm512_add_epi64(notional, _mm512_mullo_epi64(_mm512_maskz_loadu_epi64(lanes, raw + i), v));
+        shares = _mm512_add_epi64(shares, v);
+    }
+    std::int64_t totalShares = _mm512_reduce_add_epi64(shares);
+    return totalShares > 0
+        ? static_cast<double>(_mm512_reduce_add_epi64(notional)) / totalShares / Price::SCALE
+        : 0.0;
+}
+
+AVX512_TARGET void avx512Returns(const double* x, std::size_t n, double* out) {
+    if (n < 2) return;
+    const __m512d one = _mm512_set1_pd(1.0);
+    for (std::size_t i = 0; i + 1 < n; i += 8) {
+        std::size_t count = std::min<std::size_t>(8, n - 1 - i);
+        __mmask8 lanes = static_cast<__mmask8>((1u << count) - 1);
+        __m512d r = _mm512_div_pd(_mm512_maskz_loadu_pd(lanes, x + i + 1),
+                                  _mm512_mask_loadu_pd(one, lanes, x + i));
+        _mm512_mask_storeu_pd(out + i, lanes, _mm512_sub_pd(r, one));
+    }
+}
+
+AVX512_TARGET void avx512RollingMean(const double* x, std::size_t n, std::size_t window, double* out) {
+    if (window == 0) return;
+    std::fill(out, out + std::min(n, window - 1), 0.0);
+    const __m512d scale = _mm512_set1_pd(1.0 / window);
+    for (std::size_t start = window - 1; start < n; start += REANCHOR_EVERY) {
+        const std::size_t stop = std::min(n, start + REANCHOR_EVERY);
+        double sum = avx512Sum(x + start + 1 - window, window);
+        out[start] = sum / window;
+        
+        std::size_t i = start + 1;
+        __m512d carry = _mm512_set1_pd(sum);
+        for (; i + 8 <= stop; i += 8) {
+            __m512d delta = _mm512_sub_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(x + i - window));
+            __m512d sums = _mm512_add_pd(prefixSum(delta), carry);
+            _mm512_storeu_pd(out + i, _mm512_mul_pd(sums, scale));
+            carry = broadcastLast(sums);
+        }
+        sum = _mm512_cvtsd_f64(carry);
+        for (; i < stop; i++) {
+            sum += x[i] - x[i - window];
+            out[i] = sum / window;
+        }
+    }
+}
+
+AVX512_TARGET void avx512RollingStddev(const double* x, std::size_t n, std::size_t window, double* out) {
+    if (window == 0 || n == 0) return;
+    std::fill(out, out + std::min(n, window - 1), 0.0);
+    const double ref = x[0];
+    const __m512d refs = _mm512_set1_pd(ref);
+    const __m512d scale = _mm512_set1_pd(1.0 / window);
+    const __m512d zero = _mm512_setzero_pd();
+    for (std::size_t start = window - 1; start < n; start += REANCHOR_EVERY) {
+        const std::size_t stop = std::min(n, start + REANCHOR_EVERY);
+        double sum = 0.0;
+        double sumSq = 0.0;
+        for (std::size_t k = start + 1 - window; k <= start; k++) {
+            double y = x[k] - ref;
+            sum += y;
+            sumSq += y * y;
+        }
+        double mean = sum / window;
+        out[start] = std::sqrt(std::max(0.0, sumSq / window - mean * mean));
+        
+        std::size_t i = start + 1;
+        __m512d carry = _mm512_set1_pd(sum);
+        __m512d carrySq = _mm512_set1_pd(sumSq);
+        for (; i + 8 <= stop; i += 8) {
+            __m512d in = _mm512_sub_pd(_mm512_loadu_pd(x + i), refs);
+            __m512d outgoing = _mm512_sub_pd(_mm512_loadu_pd(x + i - window), refs);
+            __m512d sums = _mm512_add_pd(prefixSum(_mm512_sub_pd(in, outgoing)), carry);
+            __m512d sumsSq = _mm512_add_pd(
+                prefixSum(_mm512_sub_pd(_mm512_mul_pd(in, in), _mm512_mul_pd(outgoing, outgoing))), carrySq);
+            __m512d means = _mm512_mul_pd(sums, scale);
+            __m512d variance = _mm512_sub_pd(_mm512_mul_pd(sumsSq, scale), _mm512_mul_pd(means, means));
+            _mm512_storeu_pd(out + i, _mm512_sqrt_pd(_mm512_max_pd(variance, zero)));
+            carry = broadcastLast(sums);
+            carrySq = broadcastLast(sumsSq);
+        }
+        sum = _mm512_cvtsd_f64(carry);
+        sumSq = _mm512_cvtsd_f64(carrySq);
+        for (; i < stop; i++) {
+            double in = x[i] - ref;
+            double outgoing = x[i - window] - ref;
+            sum += in - outgoing;
+            sumSq += in * in - outgoing * outgoing;
+            mean = sum / window;
+            out[i] = std::sqrt(std::max(0.0, sumSq / window - mean * mean));
+        }
+    }
+}
+
+AVX512_TARGET void avx512Ema(const double* x, std::size_t n, double alpha, double* out) {
+    if (n == 0) return;
+    const double b = 1.0 - alpha;
+    const double b2 = b * b;
+    const double b4 = b2 * b2;
+    const __m512d a = _mm512_set1_pd(alpha);
+    const __m512d step1 = _mm512_set1_pd(b);
+    const __m512d step2 = _mm512_set1_pd(b2);
+    const __m512d step4 = _mm512_set1_pd(b4);
+    const __m512d decay = _mm512_setr_pd(b, b2, b2 * b, b4, b4 * b, b4 * b2, b4 * b2 * b, b4 * b4);
+    __m512d previous = _mm512_set1_pd(x[0]);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m512d t = _mm512_mul_pd(a, _mm512_loadu_pd(x + i));
+        t = _mm512_add_pd(t, _mm512_mul_pd(step1, shiftUp<1>(t)));
+        t = _mm512_add_pd(t, _mm512_mul_pd(step2, shiftUp<2>(t)));
+        t = _mm512_add_pd(t, _mm512_mul_pd(step4, shiftUp<4>(t)));
+        __m512d y = _mm512_add_pd(t, _mm512_mul_pd(decay, previous));
+        _mm512_storeu_pd(out + i, y);
+        previous = broadcastLast(y);
+    }
+    double y = _mm512_cvtsd_f64(previous);
+    for (; i < n; i++) {
+        y += alpha * (x[i] - y);
+        out[i] = y;
+    }
+}
+
+AVX512_TARGET void avx512ToDouble(const std::int64_t* raw, std::size_t n, double* out) {
+    const __m512d scale = _mm512_set1_pd(static_cast<double>(Price::SCALE));
+    for (std::size_t i = 0; i < n; i += 8) {
+        __mmask8 lanes = (n - i >= 8) ? 0xFF : static_cast<__mmask8>((1u << (n - i)) - 1);
+        __m512d v = _mm512_cvtepi64_pd(_mm512_maskz_loadu_epi64(lanes, raw + i));
+        _mm512_mask_storeu_pd(out + i, lanes, _mm512_div_pd(v, scale));
+    }
+}
+
+#endif // HFT_SIMD_KERNELS
+
+const IndicatorKernels SCALAR_KERNELS = {
+    SimdLevel::SCALAR, scalarSum, scalarSumFixed, scalarMinMax, scalarMinMaxFixed, scalarVwap, scalarVwapFixed,
+    scalarReturns, scalarRollingMean, scalarRollingStddev, scalarEma, scalarToDouble
+};
+
+#ifdef HFT_SIMD_KERNELS
+const IndicatorKernels AVX2_KERNELS = {
+    SimdLevel::AVX2, avx2Sum, avx2SumFixed, avx2MinMax, avx2MinMaxFixed, avx2Vwap, avx2VwapFixed,
+    avx2Returns, avx2RollingMean, avx2RollingStddev, avx2Ema, avx2ToDouble
+};
+
+const IndicatorKernels AVX512_KERNELS = {
+    SimdLevel::AVX512, avx512Sum, avx512SumFixed, avx512MinMax, avx512MinMaxFixed, avx512Vwap, avx512VwapFixed,
+    avx512Returns, avx512RollingMean, avx512RollingStddev, avx512Ema, avx512ToDouble
+};
+#endif
+
+SimdLevel detectSimdLevel() {
+#ifdef HFT_SIMD_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) return SimdLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+    return SimdLevel::SCALAR;
+}
+
+} // namespace
+
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512: return "AVX-512";
+        case SimdLevel::AVX2: return "AVX2";
+        default: return "scalar";
+    }
+}
+
+SimdLevel bestSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+bool simdLevelSupported(SimdLevel level) {
+    return static_cast<int>(level) <= static_cast<int>(bestSimdLevel());
+}
+
+const IndicatorKernels& indicatorKernels(SimdLevel level) {
+#ifdef HFT_SIMD_KERNELS
+    if (simdLevelSupported(level)) {
+        if (level == SimdLevel::AVX512) return AVX512_KERNELS;
+        if (level == SimdLevel::AVX2) return AVX2_KERNELS;
+    }
+#endif
+    return SCALAR_KERNELS;
+}
+
+const IndicatorKernels& indicatorKernels() {
+    static const IndicatorKernels& best = indicatorKernels(bestSimdLevel());
+    return best;
+}
@@ -3,14 +3,26 @@
 #include "Order.h"
 #include "RiskManager.h"
 #include "ExchangeManager.h"
+#include "Strategy.h"
+#include "TickStore.h"
+#include "ReplayEngine.h"
+#include "TradingPipeline.h"
+#include "AsyncLogger.h"
+#include "ItchFeed.h"
+#include "L3OrderBook.h"
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
 #include <vector>
 
 class IntegrationTests {
 public:
     static void runAllTests() {
         testEndToEndTradingFlow();
+        testMarketDataReplay();
         testRiskIntegration();
         testExchangeIntegration();
+        testTickToTradeTracing();
     }
     
 private:
@@ -20,7 +32,7 @@ private:
         // Test complete trading workflow
         suite.addTest("Complete Trading Workflow", []() {
             // 1. Load market data
-            std::vector<MarketData> marketData;
+            TickStore marketData;
             bool dataLoaded = loadData(marketData);
             ASSERT_TRUE(dataLoaded);
             ASSERT_TRUE(marketData.size() > 0);
@@ -30,29 +42,36 @@ private:
             riskManager.updateMarketPrices(marketData);
             
             // 3. Create strategy
-            MovingAvgStrat strategy(2, 3);
+            MovingAvgStrat strategy(2, 3, 10);
             
-            // 4. Generate signal
-            int signal = strategy.generateSignal(marketData, "AAPL");
+            // 4. Replay the ticks into the strategy
+            ReplayEngine replay(marketData);
+            replay.subscribe(strategy);
+            ReplayStats replayed = replay.run(ReplayOptions{});
+            ASSERT_EQ(marketData.size(), replayed.events);
+            int signal = strategy.signal(marketData.findSymbol("AAPL"));
             ASSERT_TRUE(signal >= -1 && signal <= 1);
             
-            // 5. Create order based on signal
-            if (signal == 1) { // BUY signal
-                Order order("AAPL", OrderType::BUY, 10, 150.0);
+            // 5. Turn the strategy's intents into orders
+            for (const OrderIntent& intent : strategy.pendingIntents()) {
+                Order order(intent.symbol, intent.side, intent.quantity, intent.price);
                 
                 // 6. Validate with risk manager
-                bool riskPassed = riskManager.validateOrder(order, 150.0);
+                bool riskPassed = riskManager.validateOrder(order, intent.price);
                 
                 if (riskPassed) {
-                    // 7. Execute order (simulate)
+                    // 7. Execute order (simulate) and report the fill back
                     order.status = OrderStatus::FILLED;
                     riskManager.updatePosition(order);
+                    strategy.onFill(Fill{order.orderId, intent.symbol, intent.side, intent.quantity, intent.price, 0});
                     
                     // 8. Verify position was created
-                    Position* position = riskManager.getPosition("AAPL");
+                    Position* position = riskManager.getPosition(intent.symbol);
                     ASSERT_TRUE(position != nullptr);
+                    ASSERT_TRUE(strategy.position(intent.symbol) != 0);
                 }
             }
+            strategy.clearIntents();
             
             // Test completed successfully
             ASSERT_TRUE(true);
@@ -61,6 +80,85 @@ private:
         suite.runAll();
     }
     
+    static void testMarketDataReplay() {
+        TestSuite suite("Market Data Replay");
+        
+        // Paced replay on a pinned thread keeps the recorded schedule
+        suite.addTest("Scaled Replay Keeps Schedule", []() {
+            TickStore ticks;
+            for (int i = 0; i < 2000; i++) {
+                ticks.append(34200LL * NANOS_PER_SECOND + i * 100000LL, "AAPL", Price::fromDouble(150.0 + (i % 10) * 0.01), 100);
+            }
+            
+            std::vector<std::int64_t> seen;
+            seen.reserve(ticks.size());
+            ReplayEngine engine(ticks);
+            engine.subscribeTicks([&seen](const Tick& tick) { seen.push_back(tick.timestamp); });
+            
+            ReplayOptions options;
+            options.pacing = ReplayPacing::SCALED;
+            options.speed = 4.0;  // 200ms of data in ~50ms
+            options.core = 0;
+            engine.start(options);
+            ReplayStats stats = engine.join();
+            
+            std::cout << "🎬 Scaled replay: " << stats.seconds * 1e3 << "ms, jitter p50 " << stats.jitterP50
+                      << "ns, p99 " << stats.jitterP99 << "ns" << std::endl;
+            ASSERT_EQ(ticks.size(), stats.events);
+            ASSERT_EQ(ticks.size(), seen.size());
+            ASSERT_TRUE(std::is_sorted(seen.begin(), seen.end()));
+            ASSERT_TRUE(stats.seconds >= 0.199 / 4.0);
+            ASSERT_TRUE(stats.jitterP50 >= 0 && stats.jitterP50 <= stats.jitterMax);
+            
+            // As fast as possible has no schedule, so no jitter
+            ReplayStats fast = engine.run(ReplayOptions{});
+            ASSERT_EQ(ticks.size(), fast.events);
+            ASSERT_EQ(0, fast.jitterMax);
+            ASSERT_TRUE(fast.seconds < stats.seconds);
+        });
+        
+        // A captured ITCH file replays into an L3 book identical to a direct decode
+        suite.addTest("Capture Replay Rebuilds Books", []() {
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_replay_test.itch").string();
+            ASSERT_TRUE(generateItchFile(path, 50000, 2, 3));
+            
+            ReplayEngine engine;
+            ASSERT_TRUE(engine.loadCapture(path));
+            SymbolId aapl = findSymbolId("AAPL");
+            ASSERT_TRUE(aapl != INVALID_SYMBOL);
+            
+            L3OrderBook book;
+            std::size_t trades = 0;
+            engine.subscribeOrderEvents([&](const OrderBookEvent& event) {
+                if (event.symbol == aapl) book.apply(event);
+            });
+            engine.subscribeTicks([&](const Tick&) { trades++; });
+            
+            // Stop partway, then replay everything
+            engine.start(ReplayOptions{});
+            engine.stop();
+            engine.join();
+            book.clear();
+            trades = 0;
+            ReplayStats stats = engine.run(ReplayOptions{});
+            ASSERT_FALSE(stats.stopped);
+            ASSERT_EQ(engine.size(), stats.events);
+            
+            TickStore direct;
+            ItchBookBuilder builder(direct);
+            ASSERT_TRUE(loadItchFile(path, builder));
+            const L3OrderBook* expected = builder.book("AAPL");
+            ASSERT_TRUE(expected != nullptr);
+            ASSERT_EQ(expected->orderCount(), book.orderCount());
+            ASSERT_EQ(expected->levels().bestBid(), book.levels().bestBid());
+            ASSERT_EQ(expected->levels().bestAskQuantity(), book.levels().bestAskQuantity());
+            ASSERT_EQ(direct.size(), trades);
+            std::filesystem::remove(path);
+        });
+        
+        suite.runAll();
+    }
+    
     static void testRiskIntegration() {
         TestSuite suite("Risk Management Integration");
         
@@ -73,7 +171,7 @@ private:
             for (int i = 0; i < 10; i++) {
                 Order order("AAPL", OrderType::BUY, 10, 100.0); // $1000 each
                 
-                if (riskManager.validateOrder(order, 100.0)) {
+                if (riskManager.validateOrder(order, order.price)) {
                     order.status = OrderStatus::FILLED;
                     riskManager.updatePosition(order);
                     orders.push_back(order);
@@ -86,8 +184,8 @@ private:
             ASSERT_TRUE(orders.size() < 10);
             
             // Total exposure should be within limits
-            double totalExposure = riskManager.getTotalExposure();
-            ASSERT_TRUE(totalExposure <= 5000.0);
+            Price totalExposure = riskManager.getTotalExposure();
+            ASSERT_TRUE(totalExposure <= Price::fromDouble(5000.0));
         });
         
         suite.runAll();
@@ -106,14 +204,14 @@ private:
             ASSERT_TRUE(connected);
             
             // 2. Get live price
-            double price;
+            Price price;
             bool priceReceived = exchangeManager.getLivePrice("AAPL", price);
             ASSERT_TRUE(priceReceived);
-            ASSERT_TRUE(price > 0);
+            ASSERT_TRUE(price > Price());
             
             // 3. Execute live order
-            std::string orderId = exchangeManager.executeLiveOrder("AAPL", "buy", 1, price);
-            ASSERT_FALSE(orderId.empty());
+            OrderId orderId = exchangeManager.executeLiveOrder("AAPL", "buy", 1, price);
+            ASSERT_TRUE(orderId != INVALID_ORDER_ID);
             
             // Test completed successfully
             ASSERT_TRUE(true);
@@ -121,4 +219,117 @@ private:
         
         suite.runAll();
     }
+    
+    static void testTickToTradeTracing() {
+        TestSuite suite("Tick-to-Trade Tracing");
+        
+        suite.addTest("Tick-To-Trade Pipeline Traced", []() {
+            std::ostringstream sink;
+            AsyncLogger& logger = AsyncLogger::instance();
+            logger.setOutput(sink);
+            
+            SimulatedExchange venue;
+            ExchangeCredentials creds;
+            creds.apiKey = "test-trace";
+            venue.authenticate(creds);
+            venue.setCash(Price::fromRaw(1000000000LL * Price::SCALE));
+            venue.setShares("TRCX", 1000000);
+            RiskManager risk(1e6, 1e9);
+            OrderManager orders;
+            MovingAvgStrat strategy(2, 4, 10);
+            LatencyTracer& tracer = LatencyTracer::instance();
+            tracer.reset();
+            TradingPipeline pipeline(strategy, risk, orders, venue, tracer);
+            
+            // Down, then up, then down again: both crossovers fire. The ticks
+            // come through a paced replay, 100µs apart, as from a feed
+            const SymbolId symbol = internSymbol("TRCX");
+            const double path[] = {110, 108, 106, 104, 102, 100, 102, 104, 106, 108, 110, 112,
+                                   110, 108, 106, 104, 102, 100};
+            TickStore tape;
+            std::int64_t timestamp = 34200LL * NANOS_PER_SECOND;
+            for (double price : path) {
+                tape.append(timestamp, symbol, Price::fromDouble(price), 100);
+                timestamp += 100000;
+            }
+            ReplayEngine engine(tape);
+            engine.subscribeTicks([&pipeline](const Tick& tick) { pipeline.onTick(tick); });
+            ReplayOptions options;
+            options.pacing = ReplayPacing::ORIGINAL;
+            const ReplayStats replayed = engine.run(options);
+            ASSERT_EQ(tape.size(), replayed.events);
+            ASSERT_TRUE(replayed.seconds >= 0.0017);
+            tracer.collect();
+            logger.flush();
+            logger.setOutput(std::cout);
+            
+            const PipelineStats& stats = pipeline.stats();
+            ASSERT_EQ(18u, stats.ticks);
+            ASSERT_TRUE(stats.filled >= 2);
+            ASSERT_EQ(stats.intents, stats.filled + stats.riskRejects + stats.venueRejects);
+            ASSERT_EQ(0u, tracer.droppedCount());
+            
+            // Every tick is traced up to the decision, every routed order up to the ack
+            ASSERT_TRUE(tracer.span(0).count() >= stats.ticks);
+            ASSERT_TRUE(tracer.span(0).count() < stats.ticks + stats.intents);
+            ASSERT_EQ(stats.intents - stats.riskRejects, tracer.span(TRACE_SPAN_COUNT - 1).count());
+            ASSERT_EQ(0u, orders.liveCount());
+            tracer.reset();
+        });
+        
+        suite.addTest("Pipeline Books Only Venue Fills", []() {
+            std::ostringstream sink;
+            AsyncLogger& logger = AsyncLogger::instance();
+            logger.setOutput(sink);
+            
+            SimulatedExchange venue;
+            ExchangeCredentials creds;
+            creds.apiKey = "test-fills";
+            venue.authenticate(creds);
+            venue.setImmediateFills(false);
+            venue.setCash(Price::fromRaw(1000000000LL * Price::SCALE));
+            venue.setShares("TRCY", 1000000);
+            RiskManager risk(1e6, 1e9);
+            OrderManager orders;
+            MovingAvgStrat strategy(2, 4, 10);
+            LatencyTracer& tracer = LatencyTracer::instance();
+            tracer.reset();
+            TradingPipeline pipeline(strategy, risk, orders, venue, tracer);
+            
+            // A steady climb: one buy, which rests at the venue
+            const SymbolId symbol = internSymbol("TRCY");
+            const double path[] = {100, 101, 102, 103, 104, 105};
+            for (double price : path) {
+                pipeline.onTick(Tick{Clock::now(), symbol, Price::fromDouble(price), 100});
+            }
+            ASSERT_EQ(0u, pipeline.stats().fills);
+            ASSERT_EQ(1u, orders.liveCount());
+            const std::vector<ExchangeOrder> resting = venue.getOpenOrders();
+            ASSERT_EQ(1u, resting.size());
+            const Order* local = nullptr;
+            orders.forEachLive(symbol, [&](const Order& order) { local = orders.findOrder(order.orderId); });
+            ASSERT_TRUE(local->status == OrderStatus::ACKED);
+            ASSERT_TRUE(risk.getPosition("TRCY") == nullptr);
+            
+            // A partial execution is booked on the next tick, the rest once reported
+            ASSERT_TRUE(venue.simulateOrderFill(resting[0].exchangeOrderId, 4));
+            pipeline.onTick(Tick{Clock::now(), symbol, Price::fromDouble(106), 100});
+            ASSERT_EQ(1u, pipeline.stats().fills);
+            ASSERT_TRUE(local->status == OrderStatus::PARTIALLY_FILLED);
+            ASSERT_EQ(4, risk.getPosition("TRCY")->quantity);
+            
+            ASSERT_TRUE(venue.simulateOrderFill(resting[0].exchangeOrderId));
+            pipeline.bookFills();
+            tracer.collect();
+            tracer.reset();
+            logger.flush();
+            logger.setOutput(std::cout);
+            ASSERT_EQ(2u, pipeline.stats().fills);
+            ASSERT_EQ(1u, pipeline.stats().filled);
+            ASSERT_EQ(0u, orders.liveCount());
+            ASSERT_EQ(static_cast<int>(resting[0].quantity), risk.getPosition("TRCY")->quantity);
+        });
+        
+        suite.runAll();
+    }
 };
@@ -0,0 +1,257 @@
+#include "ItchFeed.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <fstream>
+
+namespace {
+
+void put16(std::string& out, std::uint16_t v) {
+    out += static_cast<char>(v >> 8);
+    out += static_cast<char>(v);
+}
+
+void put32(std::string& out, std::uint32_t v) {
+    put16(out, static_cast<std::uint16_t>(v >> 16));
+    put16(out, static_cast<std::uint16_t>(v));
+}
+
+void put48(std::string& out, std::uint64_t v) {
+    put16(out, static_cast<std::uint16_t>(v >> 32));
+    put32(out, static_cast<std::uint32_t>(v));
+}
+
+void put64(std::string& out, std::uint64_t v) {
+    put32(out, static_cast<std::uint32_t>(v >> 32));
+    put32(out, static_cast<std::uint32_t>(v));
+}
+
+void putAlpha(std::string& out, std::string_view text, std::size_t width) {
+    out.append(text.substr(0, width));
+    out.append(width - std::min(width, text.size()), ' ');
+}
+
+// Length prefix plus the common header; the caller appends the body and
+// patches the length with finish()
+std::size_t begin(std::string& out, char type, std::uint16_t locate, std::int64_t timestamp) {
+    std::size_t start = out.size();
+    put16(out, 0);
+    out += type;
+    put16(out, locate);
+    put16(out, 0);  // tracking number
+    put48(out, static_cast<std::uint64_t>(timestamp));
+    return start;
+}
+
+void finish(std::string& out, std::size_t start) {
+    std::size_t length = out.size() - start - 2;
+    out[start] = static_cast<char>(length >> 8);
+    out[start + 1] = static_cast<char>(length);
+}
+
+} // namespace
+
+ItchBookBuilder::ItchBookBuilder(TickStore& tickStore, Price bookTickSize)
+    : ticks(tickStore), tickSize(bookTickSize) {
+}
+
+SymbolId ItchBookBuilder::nameLocate(std::uint16_t locate, std::string_view stock) {
+    if (locate >= locateSymbols.size()) locateSymbols.resize(locate + 1, INVALID_SYMBOL);
+    if (locateSymbols[locate] == INVALID_SYMBOL) locateSymbols[locate] = ticks.symbolTable().intern(stock);
+    return locateSymbols[locate];
+}
+
+SymbolId ItchBookBuilder::symbolOf(std::uint16_t locate) const {
+    return (locate < locateSymbols.size()) ? locateSymbols[locate] : INVALID_SYMBOL;
+}
+
+L3OrderBook* ItchBookBuilder::bookOf(std::uint16_t locate) {
+    SymbolId symbol = symbolOf(locate);
+    return (symbol < books.size()) ? books[symbol].get() : nullptr;
+}
+
+void ItchBookBuilder::recordTrade(std::int64_t timestamp, SymbolId symbol, Price price, std::uint32_t shares) {
+    ticks.append(timestamp, symbol, price, static_cast<int>(shares));
+}
+
+void ItchBookBuilder::onStockDirectory(const itch::StockDirectory& message) {
+    nameLocate(message.stockLocate(), message.stock());
+}
+
+void ItchBookBuilder::addOrder(const itch::AddOrder& message) {
+    SymbolId symbol = nameLocate(message.stockLocate(), message.stock());
+    if (symbol >= books.size()) books.resize(symbol + 1);
+    if (!books[symbol]) books[symbol] = std::make_unique<L3OrderBook>(tickSize);
+    
+    BookSide side = message.isBuy() ? BookSide::BID : BookSide::ASK;
+    if (!books[symbol]->add(message.orderRef(), side, Price::fromRaw(message.price()), message.shares(),
+                            message.timestamp())) {
+        rejected++;
+    }
+}
+
+void ItchBookBuilder::onOrderExecuted(const itch::OrderExecuted& message) {
+    L3OrderBook* book = bookOf(message.stockLocate());
+    const L3Order* order = book ? book->find(message.orderRef()) : nullptr;
+    if (order == nullptr) {
+        rejected++;
+        return;
+    }
+    recordTrade(message.timestamp(), symbolOf(message.stockLocate()), order->price, message.executedShares());
+    book->execute(message.orderRef(), message.executedShares());
+}
+
+void ItchBookBuilder::onOrderExecutedWithPrice(const itch::OrderExecutedWithPrice& message) {
+    L3OrderBook* book = bookOf(message.stockLocate());
+    if (book == nullptr || !book->execute(message.orderRef(), message.executedShares())) {
+        rejected++;
+        return;
+    }
+    if (message.printable()) {
+        recordTrade(message.timestamp(), symbolOf(message.stockLocate()),
+                    Price::fromRaw(message.executionPrice()), message.executedShares());
+    }
+}
+
+void ItchBookBuilder::onOrderCancel(const itch::OrderCancel& message) {
+    L3OrderBook* book = bookOf(message.stockLocate());
+    if (book == nullptr || !book->cancel(message.orderRef(), message.cancelledShares())) rejected++;
+}
+
+void ItchBookBuilder::onOrderDelete(const itch::OrderDelete& message) {
+    L3OrderBook* book = bookOf(message.stockLocate());
+    if (book == nullptr || !book->remove(message.orderRef())) rejected++;
+}
+
+void ItchBookBuilder::onOrderReplace(const itch::OrderReplace& message) {
+    L3OrderBook* book = bookOf(message.stockLocate());
+    if (book == nullptr || !book->replace(message.originalOrderRef(), message.newOrderRef(),
+                                          Price::fromRaw(message.price()), message.shares(),
+                                          message.timestamp())) {
+        rejected++;
+    }
+}
+
+void ItchBookBuilder::onTrade(const itch::Trade& message) {
+    SymbolId symbol = nameLocate(message.stockLocate(), message.stock());
+    recordTrade(message.timestamp(), symbol, Price::fromRaw(message.price()), message.shares());
+}
+
+const L3OrderBook* ItchBookBuilder::book(SymbolId symbol) const {
+    return (symbol < books.size()) ? books[symbol].get() : nullptr;
+}
+
+bool loadItchFile(const std::string& path, ItchBookBuilder& builder, itch::DecodeResult* result) {
+    MappedFile file(path);
+    if (!file.isOpen()) return false;
+    
+    itch::DecodeResult decoded = itch::decode(file.data(), file.end(), builder);
+    if (result != nullptr) *result = decoded;
+    return decoded.complete;
+}
+
+bool isItchFile(const std::string& path) {
+    return path.size() > 5 && path.compare(path.size() - 5, 5, ".itch") == 0;
+}
+
+bool generateItchFile(const std::string& path, std::size_t messages, std::size_t symbols, unsigned seed) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open() || symbols == 0 || symbols > UINT16_MAX) return false;
+    
+    static const char* knownNames[] = {"AAPL", "MSFT", "GOOG", "AMZN", "TSLA", "NVDA", "META", "NFLX"};
+    std::vector<std::string> names;
+    std::vector<SyntheticOrderFlow> flows;
+    flows.reserve(symbols);
+    std::string buffer;
+    buffer.reserve(1 << 20);
+    
+    std::int64_t timestamp = 34200LL * NANOS_PER_SECOND - 1000;  // just before 09:30
+    std::size_t start = begin(buffer, 'S', 0, timestamp);
+    buffer += 'O';  // start of messages
+    finish(buffer, start);
+    
+    for (std::size_t s = 0; s < symbols; s++) {
+        char name[16];
+        if (s < sizeof(knownNames) / sizeof(knownNames[0])) {
+            std::snprintf(name, sizeof(name), "%s", knownNames[s]);
+        } else {
+            std::snprintf(name, sizeof(name), "SYM%05zu", s);
+        }
+        names.emplace_back(name);
+        
+        // Stock locates start at 1; each symbol trades around its own price
+        const std::uint16_t locate = static_cast<std::uint16_t>(s + 1);
+        start = begin(buffer, 'R', locate, timestamp);
+        putAlpha(buffer, names[s], 8);
+        buffer += 'Q';          // market category
+        buffer += 'N';          // financial status
+        put32(buffer, 100);     // round lot size
+        buffer += "NCZ PNN2N";  // round lots only, classification, subtype, authenticity, SSR, IPO, LULD tier, ETP
+        put32(buffer, 0);       // ETP leverage factor
+        buffer += 'N';          // inverse indicator
+        finish(buffer, start);
+        flows.emplace_back(locate, 5000, seed + static_cast<unsigned>(s),
+                           Price::fromRaw((100 + 25 * static_cast<std::int64_t>(s % 40)) * Price::SCALE));
+    }
+    
+    std::uint64_t matchNumber = 1;
+    unsigned pick = seed;
+    for (std::size_t i = 0; i < messages; i++) {
+        pick = pick * 1103515245u + 12345u;
+        const std::size_t s = (pick >> 8) % symbols;
+        OrderBookEvent event = flows[s].next();
+        timestamp += 1 + (pick >> 20) % 500;  // one feed clock across all symbols
+        
+        // Order refs are unique across the whole file
+        const std::uint64_t symbolBits = static_cast<std::uint64_t>(s + 1) << 40;
+        const std::uint16_t locate = static_cast<std::uint16_t>(event.symbol);
+        switch (event.type) {
+            case OrderEventType::ADD: {
+                bool withMpid = (event.orderId % 16 == 0);
+                start = begin(buffer, withMpid ? 'F' : 'A', locate, timestamp);
+                put64(buffer, symbolBits | event.orderId);
+                buffer += (event.side == BookSide::BID) ? 'B' : 'S';
+                put32(buffer, static_cast<std::uint32_t>(event.quantity));
+                putAlpha(buffer, names[s], 8);
+                put32(buffer, static_cast<std::uint32_t>(event.price.raw()));
+                if (withMpid) putAlpha(buffer, "HFTP", 4);
+                break;
+            }
+            case OrderEventType::EXECUTE: {
+                bool withPrice = (matchNumber % 4 == 0);
+                start = begin(buffer, withPrice ? 'C' : 'E', locate, timestamp);
+                put64(buffer, symbolBits | event.orderId);
+                put32(buffer, static_cast<std::uint32_t>(event.quantity));
+                put64(buffer, matchNumber++);
+                if (withPrice) {
+                    buffer += 'Y';
+                    put32(buffer, static_cast<std::uint32_t>(event.price.raw()));
+                }
+                break;
+            }
+            case OrderEventType::CANCEL:
+                start = begin(buffer, 'X', locate, timestamp);
+                put64(buffer, symbolBits | event.orderId);
+                put32(buffer, static_cast<std::uint32_t>(event.quantity));
+                break;
+            case OrderEventType::DELETE:
+                start = begin(buffer, 'D', locate, timestamp);
+                put64(buffer, symbolBits | event.orderId);
+                break;
+            case OrderEventType::REPLACE:
+                start = begin(buffer, 'U', locate, timestamp);
+                put64(buffer, symbolBits | event.orderId);
+                put64(buffer, symbolBits | event.newOrderId);
+                put32(buffer, static_cast<std::uint32_t>(event.quantity));
+                put32(buffer, static_cast<std::uint32_t>(event.price.raw()));
+                break;
+        }
+        finish(buffer, start);
+        
+        if (buffer.size() > (1 << 20) - 64) {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), buffer.size());
+    return out.good();
+}
@@ -0,0 +1,236 @@
+#include "L3OrderBook.h"
+#include <algorithm>
+
+L3OrderBook::L3OrderBook(Price tickSize, std::size_t levelsPerSide)
+    : orderIndex(1 << 14), levelIndex(1 << 10), aggregate(tickSize, levelsPerSide) {
+}
+
+L3Level* L3OrderBook::levelFor(BookSide side, Price price) {
+    const std::uint64_t key = levelKey(side, price);
+    if (L3Level** found = levelIndex.find(key)) return *found;
+    
+    L3Level* level = levelPool.template allocate<L3Level>(L3Level{price, side, 0, 0, nullptr, nullptr});
+    levelIndex.insert(key, level);
+    return level;
+}
+
+void L3OrderBook::link(L3Order* order, L3Level* level) {
+    order->level = level;
+    order->prev = level->tail;
+    order->next = nullptr;
+    if (level->tail != nullptr) {
+        level->tail->next = order;
+    } else {
+        level->head = order;
+    }
+    level->tail = order;
+    level->quantity += order->quantity;
+    level->orders++;
+    aggregate.update(level->side, level->price, level->quantity);
+}
+
+void L3OrderBook::reduce(L3Order* order, std::int64_t shares) {
+    L3Level* level = order->level;
+    shares = std::min(shares, order->quantity);
+    order->quantity -= shares;
+    level->quantity -= shares;
+    
+    if (order->quantity == 0) {
+        if (order->prev != nullptr) {
+            order->prev->next = order->next;
+        } else {
+            level->head = order->next;
+        }
+        if (order->next != nullptr) {
+            order->next->prev = order->prev;
+        } else {
+            level->tail = order->prev;
+        }
+        level->orders--;
+        orderIndex.erase(order->id);
+        orderPool.deallocate(order);
+    }
+    
+    aggregate.update(level->side, level->price, level->quantity);
+    if (level->orders == 0) {
+        levelIndex.erase(levelKey(level->side, level->price));
+        levelPool.deallocate(level);
+    }
+}
+
+bool L3OrderBook::add(std::uint64_t id, BookSide side, Price price, std::int64_t quantity, std::int64_t timestamp) {
+    if (quantity <= 0 || price.raw() <= 0 || !price.isOnTick(aggregate.tickSize())) return false;
+    if (id == FlatIdMap<L3Order*>::EMPTY_KEY || orderIndex.find(id) != nullptr) return false;
+    
+    L3Order* order = orderPool.template allocate<L3Order>(
+        L3Order{id, timestamp, price, quantity, side, nullptr, nullptr, nullptr});
+    orderIndex.insert(id, order);
+    link(order, levelFor(side, price));
+    return true;
+}
+
+bool L3OrderBook::cancel(std::uint64_t id, std::int64_t shares) {
+    L3Order** found = orderIndex.find(id);
+    if (found == nullptr || shares <= 0) return false;
+    reduce(*found, shares);
+    return true;
+}
+
+bool L3OrderBook::remove(std::uint64_t id) {
+    L3Order** found = orderIndex.find(id);
+    if (found == nullptr) return false;
+    reduce(*found, (*found)->quantity);
+    return true;
+}
+
+bool L3OrderBook::execute(std::uint64_t id, std::int64_t shares) {
+    L3Order** found = orderIndex.find(id);
+    if (found == nullptr || shares <= 0) return false;
+    executedShares += static_cast<std::uint64_t>(std::min(shares, (*found)->quantity));
+    reduce(*found, shares);
+    return true;
+}
+
+bool L3OrderBook::modify(std::uint64_t id, Price price, std::int64_t quantity, std::int64_t timestamp) {
+    L3Order** found = orderIndex.find(id);
+    if (found == nullptr || quantity <= 0 || price.raw() <= 0 || !price.isOnTick(aggregate.tickSize())) return false;
+    L3Order* order = *found;
+    
+    if (price == order->price && quantity <= order->quantity) {
+        reduce(order, order->quantity - quantity);  // keeps its place in the queue
+        return true;
+    }
+    BookSide side = order->side;
+    reduce(order, order->quantity);
+    return add(id, side, price, quantity, timestamp);
+}
+
+bool L3OrderBook::replace(std::uint64_t id, std::uint64_t newId, Price price, std::int64_t quantity, std::int64_t timestamp) {
+    L3Order** found = orderIndex.find(id);
+    if (found == nullptr || quantity <= 0 || price.raw() <= 0 || !price.isOnTick(aggregate.tickSize())) return false;
+    if (newId == FlatIdMap<L3Order*>::EMPTY_KEY || (newId != id && orderIndex.find(newId) != nullptr)) return false;
+    
+    BookSide side = (*found)->side;
+    reduce(*found, (*found)->quantity);
+    return add(newId, side, price, quantity, timestamp);
+}
+
+bool L3OrderBook::apply(const OrderBookEvent& event) {
+    switch (event.type) {
+        case OrderEventType::ADD:
+            return add(event.orderId, event.side, event.price, event.quantity, event.timestamp);
+        case OrderEventType::CANCEL:
+            return cancel(event.orderId, event.quantity);
+        case OrderEventType::DELETE:
+            return remove(event.orderId);
+        case OrderEventType::EXECUTE:
+            return execute(event.orderId, event.quantity);
+        case OrderEventType::REPLACE:
+            return replace(event.orderId, event.newOrderId, event.price, event.quantity, event.timestamp);
+    }
+    return false;
+}
+
+void L3OrderBook::clear() {
+    std::vector<std::uint64_t> ids;
+    ids.reserve(orderIndex.size());
+    orderIndex.forEach([&](std::uint64_t id, L3Order*) { ids.push_back(id); });
+    for (std::uint64_t id : ids) {
+        remove(id);
+    }
+    aggregate.clear();
+    executedShares = 0;
+}
+
+const L3Order* L3OrderBook::find(std::uint64_t id) const {
+    L3Order* const* found = orderIndex.find(id);
+    return found != nullptr ? *found : nullptr;
+}
+
+const L3Level* L3OrderBook::level(BookSide side, Price price) const {
+    L3Level* const* found = levelIndex.find(levelKey(side, price));
+    return found != nullptr ? *found : nullptr;
+}
+
+std::int64_t L3OrderBook::queueAhead(std::uint64_t id) const {
+    const L3Order* order = find(id);
+    if (order == nullptr) return -1;
+    std::int64_t ahead = 0;
+    for (const L3Order* o = order->level->head; o != order; o = o->next) {
+        ahead += o->quantity;
+    }
+    return ahead;
+}
+
+SyntheticOrderFlow::SyntheticOrderFlow(SymbolId symbolId, std::size_t liveOrders, unsigned randomSeed, Price centre)
+    : symbol(symbolId), targetLive(liveOrders), seed(randomSeed),
+      midTicks(centre.raw() / TICK.raw()), timestamp(34200LL * NANOS_PER_SECOND) {
+    live.reserve(liveOrders * 2);
+}
+
+unsigned SyntheticOrderFlow::random() {
+    seed = seed * 1103515245u + 12345u;
+    return seed >> 8;
+}
+
+Price SyntheticOrderFlow::priceFor(BookSide side, unsigned r) const {
+    std::int64_t offset = 1 + static_cast<std::int64_t>(r % 25);
+    return TICK * (side == BookSide::BID ? midTicks - offset : midTicks + offset);
+}
+
+OrderBookEvent SyntheticOrderFlow::next() {
+    timestamp += 1000 + random() % 4000;
+    
+    bool grow = random() % 100 < (live.size() < targetLive ? 60u : 30u);
+    if (live.empty() || grow) {
+        BookSide side = (random() & 1) ? BookSide::BID : BookSide::ASK;
+        std::int64_t shares = 100 * static_cast<std::int64_t>(1 + random() % 10);
+        Price price = priceFor(side, random());
+        live.push_back({nextId, side, price, shares});
+        return {timestamp, symbol, OrderEventType::ADD, side, nextId++, 0, price, shares};
+    }
+    
+    std::size_t j = random() % live.size();
+    LiveOrder& order = live[j];
+    OrderBookEvent event{timestamp, symbol, OrderEventType::DELETE, order.side, order.id, 0, Price(), 0};
+    bool gone = true;
+    unsigned action = random() % 100;
+    if (action < 60) {
+        event.type = OrderEventType::DELETE;
+    } else if (action < 80) {
+        event.type = OrderEventType::EXECUTE;
+        event.price = order.price;
+        event.quantity = std::min<std::int64_t>(order.shares, 100 * (1 + random() % 3));
+        gone = (event.quantity == order.shares);
+        order.shares -= event.quantity;
+    } else if (action < 88 && order.shares > 100) {
+        event.type = OrderEventType::CANCEL;
+        event.quantity = 100;
+        gone = false;
+        order.shares -= 100;
+    } else {
+        event.type = OrderEventType::REPLACE;
+        event.newOrderId = nextId++;
+        event.price = priceFor(order.side, random());
+        event.quantity = 100 * static_cast<std::int64_t>(1 + random() % 10);
+        order.id = event.newOrderId;
+        order.price = event.price;
+        order.shares = event.quantity;
+        gone = false;
+    }
+    
+    if (gone) {
+        live[j] = live.back();
+        live.pop_back();
+    }
+    return event;
+}
+
+void synthesizeOrderFlow(std::size_t count, std::vector<OrderBookEvent>& out, SymbolId symbol,
+                         std::size_t liveOrders, unsigned seed) {
+    SyntheticOrderFlow flow(symbol, liveOrders, seed);
+    out.reserve(out.size() + count);
+    for (std::size_t i = 0; i < count; i++) {
+        out.push_back(flow.next());
+    }
+}
@@ -0,0 +1,187 @@
+#include "LatencyTrace.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <iomanip>
+
+namespace {
+
+// Releases the calling thread's ring for reuse when the thread exits
+struct RingLease {
+    std::atomic<bool>* inUse = nullptr;
+    LatencyTracer::Ring* ring = nullptr;
+    
+    ~RingLease() {
+        if (inUse) inUse->store(false, std::memory_order_release);
+    }
+};
+
+thread_local RingLease lease;
+
+constexpr std::int64_t MAX_TRACKED_NANOS = (std::int64_t(1) << 40) - 1;
+
+} // namespace
+
+// LatencyHistogram implementation
+std::size_t LatencyHistogram::bucketOf(std::int64_t nanos) {
+    const std::uint64_t v = static_cast<std::uint64_t>(std::clamp<std::int64_t>(nanos, 0, MAX_TRACKED_NANOS));
+    if (v < 64) return static_cast<std::size_t>(v);
+    const int shift = std::bit_width(v) - (SUB_BUCKET_BITS + 1);  // leaves v >> shift in [32, 64)
+    return 64 + static_cast<std::size_t>(shift - 1) * 32 + static_cast<std::size_t>((v >> shift) - 32);
+}
+
+std::int64_t LatencyHistogram::bucketLow(std::size_t bucket) {
+    if (bucket < 64) return static_cast<std::int64_t>(bucket);
+    const std::size_t shift = (bucket - 64) / 32 + 1;
+    return static_cast<std::int64_t>((bucket - 64) % 32 + 32) << shift;
+}
+
+void LatencyHistogram::record(std::int64_t nanos) {
+    counts[bucketOf(nanos)]++;
+    if (total == 0 || nanos < minimum) minimum = nanos;
+    if (total == 0 || nanos > maximum) maximum = nanos;
+    total++;
+    sum += static_cast<double>(nanos);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total == 0) return;
+    for (std::size_t i = 0; i < BUCKETS; i++) counts[i] += other.counts[i];
+    minimum = (total == 0) ? other.minimum : std::min(minimum, other.minimum);
+    maximum = (total == 0) ? other.maximum : std::max(maximum, other.maximum);
+    total += other.total;
+    sum += other.sum;
+}
+
+std::int64_t LatencyHistogram::percentile(double p) const {
+    if (total == 0) return 0;
+    const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(p * total)));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS; i++) {
+        seen += counts[i];
+        if (seen >= rank) return std::min(bucketLow(i + 1) - 1, maximum);
+    }
+    return maximum;
+}
+
+// LatencyTracer implementation
+LatencyTracer& LatencyTracer::instance() {
+    static LatencyTracer tracer;
+    return tracer;
+}
+
+LatencyTracer::Ring* LatencyTracer::threadRing() {
+    if (lease.ring != nullptr) return lease.ring;
+    
+    // First record from this thread: reuse a released ring or create one
+    std::lock_guard<std::mutex> lock(registrationMutex);
+    std::size_t count = ringCount.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; i++) {
+        bool expected = false;
+        if (rings[i]->inUse.compare_exchange_strong(expected, true)) {
+            lease.inUse = &rings[i]->inUse;
+            lease.ring = &rings[i]->ring;
+            return lease.ring;
+        }
+    }
+    if (count == MAX_THREADS) return nullptr;
+    
+    rings[count] = std::make_unique<ThreadRing>();
+    rings[count]->inUse.store(true);
+    ringCount.store(count + 1, std::memory_order_release);
+    lease.inUse = &rings[count]->inUse;
+    lease.ring = &rings[count]->ring;
+    return lease.ring;
+}
+
+bool LatencyTracer::submit(const TraceRecord& record) {
+    Ring* ring = threadRing();
+    if (ring == nullptr || !ring->tryPush(record)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void LatencyTracer::aggregate(const TraceRecord& record) {
+    if (record.orderId == INVALID_ORDER_ID) {
+        tickRecords++;
+    } else {
+        orderRecords++;
+    }
+    for (std::size_t i = 0; i < TRACE_SPAN_COUNT; i++) {
+        const TraceSpan& span = TRACE_SPANS[i];
+        if (!record.reached(span.from) || !record.reached(span.to)) continue;
+        const std::uint64_t from = record.stamps[static_cast<std::size_t>(span.from)];
+        const std::uint64_t to = record.stamps[static_cast<std::size_t>(span.to)];
+        spans[i].record(to >= from ? Clock::ticksToNanos(to - from) : 0);
+    }
+}
+
+std::size_t LatencyTracer::collect() {
+    std::lock_guard<std::mutex> lock(collectMutex);
+    std::size_t taken = 0;
+    const std::size_t count = ringCount.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < count; i++) {
+        taken += rings[i]->ring.consume([this](const TraceRecord& record) { aggregate(record); });
+    }
+    return taken;
+}
+
+void LatencyTracer::reset() {
+    std::lock_guard<std::mutex> lock(collectMutex);
+    const std::size_t count = ringCount.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < count; i++) {
+        while (rings[i]->ring.consume([](const TraceRecord&) {}) != 0) {
+        }
+    }
+    for (LatencyHistogram& histogram : spans) histogram.clear();
+    tickRecords = 0;
+    orderRecords = 0;
+    dropped.store(0, std::memory_order_relaxed);
+}
+
+LatencyHistogram LatencyTracer::span(std::size_t index) {
+    std::lock_guard<std::mutex> lock(collectMutex);
+    return spans[index];
+}
+
+void LatencyTracer::report(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(collectMutex);
+    out << "\n⏱️ === Tick-to-Trade Latency (ns) ===" << std::endl;
+    out << "  " << tickRecords << " ticks without orders, " << orderRecords << " orders, "
+        << droppedCount() << " records dropped" << std::endl;
+    out << "  " << std::left << std::setw(18) << "span" << std::right
+        << std::setw(10) << "count" << std::setw(10) << "min" << std::setw(10) << "p50"
+        << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(12) << "max"
+        << std::setw(12) << "mean" << std::endl;
+    for (std::size_t i = 0; i < TRACE_SPAN_COUNT; i++) {
+        const LatencyHistogram& h = spans[i];
+        out << "  " << std::left << std::setw(18) << TRACE_SPANS[i].name << std::right
+            << std::setw(10) << h.count() << std::setw(10) << h.min() << std::setw(10) << h.percentile(0.50)
+            << std::setw(10) << h.percentile(0.99) << std::setw(10) << h.percentile(0.999)
+            << std::setw(12) << h.max() << std::setw(12) << std::fixed << std::setprecision(1) << h.mean()
+            << std::endl;
+    }
+}
+
+void LatencyTracer::dump(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(collectMutex);
+    out << "{\"tsc\":" << (Clock::usingTsc() ? "true" : "false") << ",\"ticks\":" << tickRecords
+        << ",\"orders\":" << orderRecords << ",\"dropped\":" << droppedCount() << ",\"spans\":[";
+    for (std::size_t i = 0; i < TRACE_SPAN_COUNT; i++) {
+        const LatencyHistogram& h = spans[i];
+        out << (i ? "," : "") << "\n {\"name\":\"" << TRACE_SPANS[i].name << "\",\"count\":" << h.count()
+            << ",\"min_ns\":" << h.min() << ",\"p50_ns\":" << h.percentile(0.50) << ",\"p90_ns\":" << h.percentile(0.90)
+            << ",\"p99_ns\":" << h.percentile(0.99) << ",\"p999_ns\":" << h.percentile(0.999)
+            << ",\"max_ns\":" << h.max() << ",\"mean_ns\":" << std::fixed << std::setprecision(1) << h.mean()
+            << ",\"buckets\":[";
+        bool first = true;
+        h.forEachBucket([&out, &first](std::int64_t low, std::int64_t high, std::uint64_t count) {
+            out << (first ? "" : ",") << '[' << low << ',' << high << ',' << count << ']';
+            first = false;
+        });
+        out << "]}";
+    }
+    out << "\n]}" << std::endl;
+}
@@ -1,4 +1,14 @@
 #include "MarketData.h"
+#include "Clock.h"
+#include "TickLoader.h"
+#include "BinaryTickFile.h"
+#include "ItchFeed.h"
+#include "OrderBook.h"
+#include "TickArchive.h"
+#include "TickStore.h"
+#include "TickIndex.h"
+#include "RollingIndicators.h"
+#include "IndicatorKernels.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -6,11 +16,46 @@
 
 using namespace std;
 
-// Global data storage (we'll use this for now)
-vector<MarketData> globalData;
+bool loadData(vector<MarketData>& data, const string& path) {
+    return loadTicksMapped(path, data);
+}
+
+bool loadData(TickStore& ticks, const string& path) {
+    if (isBinaryTickFile(path)) {
+        return loadBinaryTicks(path, ticks);
+    }
+    if (isTickArchive(path)) {
+        TickArchive archive;
+        return archive.open(path) && archive.load(ticks);
+    }
+    if (isItchFile(path)) {
+        // Executions and trades become ticks; the overload taking books keeps those too
+        ticks.clear();
+        ItchBookBuilder builder(ticks);
+        return loadItchFile(path, builder);
+    }
+    return loadTicksParallel(path, ticks);
+}
 
-bool loadData(vector<MarketData>& data) {
-    ifstream file("../src/market_data/market_data.csv");
+bool loadData(TickStore& ticks, OrderBookManager& books, const string& path) {
+    if (!isItchFile(path)) {
+        if (!loadData(ticks, path)) return false;
+        synthesizeDepth(ticks, books);
+        return true;
+    }
+    
+    ticks.clear();
+    ItchBookBuilder builder(ticks);
+    if (!loadItchFile(path, builder)) return false;
+    for (SymbolId symbol = 0; symbol < ticks.symbolTable().size(); symbol++) {
+        const L3OrderBook* book = builder.book(symbol);
+        if (book != nullptr) books.assign(symbol, book->levels());
+    }
+    return true;
+}
+
+bool loadDataStream(vector<MarketData>& data, const string& path) {
+    ifstream file(path);
     string line;
     
     if (file.is_open()) {
@@ -26,52 +71,97 @@ bool loadData(vector<MarketData>& data) {
             getline(ss, volume_str, ',');
             
             MarketData md;
-            md.Time = timestamp;
-            md.Abb = symbol;
-            md.price = stod(price_str);
+            if (!parseTimeOfDay(timestamp, md.Time)) continue;
+            md.Abb = internSymbol(symbol);
+            md.price = Price::fromDouble(stod(price_str));
             md.volume = stoi(volume_str);
             
             data.push_back(md);
         }
         file.close();
-        
-        // Also populate global data for backward compatibility
-        globalData = data;
         return true;
     }
     return false;
 }
 
 double calculateMovingAverage(const vector<MarketData>& data, const string& symbol, int periods) {
-    vector<double> prices;
-    for (const auto& md : data) {
-        if (md.Abb == symbol) {
-            prices.push_back(md.price);
-        }
+    if (periods <= 0) return 0.0;
+    const SymbolId id = findSymbolId(symbol);
+    
+    // Walk back from the newest row only as far as the window reaches
+    size_t first = data.size();
+    int found = 0;
+    while (first > 0 && found < periods) {
+        if (data[--first].Abb == id) found++;
     }
+    if (found < periods) return 0.0;
     
-    if (prices.size() < periods) return 0.0;
+    // Gather the window's prices, then sum them with the batch kernel
+    thread_local vector<Price> window;
+    window.clear();
+    for (size_t i = first; i < data.size(); i++) {
+        if (data[i].Abb == id) window.push_back(data[i].price);
+    }
+    return sumPrices(window.data(), window.size()).toDouble() / periods;
+}
+
+double calculateMovingAverage(const TickStore& ticks, const string& symbol, int periods) {
+    if (periods <= 0) return 0.0;
+    SymbolId id = ticks.findSymbol(symbol);
+    if (static_cast<size_t>(periods) <= PRICE_HISTORY_CAPACITY) {
+        return ticks.recentPrices().movingAverage(id, periods);
+    }
+    
+    // Window longer than the ring: fall back to the symbol's row index
+    const auto& rows = ticks.rowsFor(id);
+    if (rows.size() < static_cast<size_t>(periods)) return 0.0;
     
-    double sum = 0.0;
-    for (int i = prices.size() - periods; i < prices.size(); i++) {
-        sum += prices[i];
+    const auto& prices = ticks.priceColumn();
+    thread_local vector<Price> window;
+    window.clear();
+    for (size_t i = rows.size() - periods; i < rows.size(); i++) {
+        window.push_back(prices[rows[i]]);
     }
-    return sum / periods;
+    return sumPrices(window.data(), window.size()).toDouble() / periods;
 }
 
 void showPriceData(const vector<MarketData>& data, const string& symbol) {
     cout << "\n=== " << symbol << " Price Data ===" << endl;
+    const SymbolId id = findSymbolId(symbol);
     for (const auto& md : data) {
-        if (md.Abb == symbol) {
-            cout << md.Time << " - $" << md.price << " (Vol: " << md.volume << ")" << endl;
+        if (md.Abb == id) {
+            cout << formatTimeOfDay(md.Time) << " - $" << md.price << " (Vol: " << md.volume << ")" << endl;
         }
     }
 }
 
-void generateSignal(const vector<MarketData>& data, const string& symbol) {
-    double shortMA = calculateMovingAverage(data, symbol, 2);
-    double longMA = calculateMovingAverage(data, symbol, 3);
-    
+void showPriceData(const TickStore& ticks, const string& symbol) {
+    cout << "\n=== " << symbol << " Price Data ===" << endl;
+    const auto& timestamps = ticks.timestampColumn();
+    const auto& prices = ticks.priceColumn();
+    const auto& volumes = ticks.volumeColumn();
+    for (uint32_t row : ticks.rowsFor(ticks.findSymbol(symbol))) {
+        cout << formatTimeOfDay(timestamps[row]) << " - $" << prices[row] << " (Vol: " << volumes[row] << ")" << endl;
+    }
+}
+
+void showRangeStats(TickIndex& index, const TickStore& ticks, const string& symbol, int64_t from, int64_t to) {
+    index.update(ticks);
+    cout << "\n=== " << symbol << " " << formatTimeOfDay(from) << " - " << formatTimeOfDay(to) << " ===" << endl;
+    RangeStats stats = index.query(ticks.findSymbol(symbol), from, to);
+    if (stats.count == 0) {
+        cout << "No trades in this range" << endl;
+    } else {
+        cout << "Trades: " << stats.count << " (Vol: " << stats.volume << ")" << endl;
+        cout << "First: $" << stats.first << "  Last: $" << stats.last << endl;
+        cout << "VWAP: $" << stats.vwap << endl;
+    }
+    if (stats.twap != 0.0) {
+        cout << "TWAP: $" << stats.twap << endl;
+    }
+}
+
+static void printSignal(const string& symbol, double shortMA, double longMA) {
     cout << "\n=== " << symbol << " Trading Signal ===" << endl;
     cout << "Short MA (2-period): $" << shortMA << endl;
     cout << "Long MA (3-period): $" << longMA << endl;
@@ -85,6 +175,19 @@ void generateSignal(const vector<MarketData>& data, const string& symbol) {
     }
 }
 
+void generateSignal(const vector<MarketData>& data, const string& symbol) {
+    RollingIndicatorEngine indicators({2, 3});
+    indicators.update(data);
+    SymbolId id = findSymbolId(symbol);
+    printSignal(symbol, indicators.sma(id, 2), indicators.sma(id, 3));
+}
+
+void generateSignal(RollingIndicatorEngine& indicators, const TickStore& ticks, const string& symbol) {
+    indicators.update(ticks);
+    SymbolId id = ticks.findSymbol(symbol);
+    printSignal(symbol, indicators.sma(id, 2), indicators.sma(id, 3));
+}
+
 void showMenu() {
     cout << "\n======= HFT Trading Platform =======" << endl;
     cout << "1. View AAPL price data" << endl;
@@ -1,70 +1,184 @@
 #include "Order.h"
+#include "AsyncLogger.h"
+#include "Clock.h"
+#include "OrderJournal.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
 
 using namespace std;
 
-int Order::nextOrderId = 1;
+Order::Order(OrderId orderId, SymbolId symbol, OrderType type, std::int64_t quantity, Price price) 
+    : timestamp(Clock::now()), price(price), quantity(quantity), filledQuantity(0), orderId(orderId), 
+      symbol(symbol), type(type), status(OrderStatus::NEW) {
+}
 
-Order::Order(const string& symbol, OrderType type, int quantity, double price) 
-    : orderId(nextOrderId++), symbol(symbol), type(type), quantity(quantity), 
-      price(price), status(OrderStatus::PENDING) {
-    
-    time_t now = time(0);
-    char* timeStr = ctime(&now);
-    timestamp = string(timeStr);
-    timestamp.pop_back();
+bool Order::onEvent(OrderEvent event) {
+    OrderStatus next;
+    if (!nextOrderStatus(status, event, next)) return false;
+    if (next == OrderStatus::ACKED && filledQuantity > 0) next = OrderStatus::PARTIALLY_FILLED;
+    status = next;
+    return true;
+}
+
+bool Order::onFill(std::int64_t fillQuantity) {
+    if (fillQuantity <= 0 || fillQuantity > leaves()) return false;
+    if (!onEvent(fillQuantity == leaves() ? OrderEvent::FILL : OrderEvent::PARTIAL_FILL)) return false;
+    filledQuantity += fillQuantity;
+    return true;
+}
+
+bool Order::amend(std::int64_t newQuantity, Price newPrice, std::int64_t stampAt) {
+    if (!onEvent(OrderEvent::REPLACE_REQUEST)) return false;
+    // The new size has to leave something working beyond what already filled
+    if (newQuantity <= filledQuantity) {
+        onEvent(OrderEvent::REPLACE_REJECT);
+        return false;
+    }
+    if (newPrice != price || newQuantity > quantity) {
+        timestamp = (stampAt != 0) ? stampAt : Clock::now();
+    }
+    quantity = newQuantity;
+    price = newPrice;
+    return onEvent(OrderEvent::REPLACE_ACK);
 }
 
 void Order::displayOrder() const {
-    cout << "Order #" << orderId << " | " << symbol << " | " 
+    cout << "Order #" << orderId << " | " << symbolName(symbol) << " | " 
          << getTypeString() << " | Qty: " << quantity 
-         << " | Price: $" << fixed << setprecision(2) << price 
-         << " | Status: " << getStatusString() << endl;
+         << " | Price: $" << fixed << setprecision(2) << price.toDouble() 
+         << " | Status: " << getStatusString()
+         << " | Time: " << formatTimestamp(timestamp) << endl;
 }
 
-string Order::getTypeString() const {
+string_view Order::getTypeString() const {
     return (type == OrderType::BUY) ? "BUY" : "SELL";
 }
 
-string Order::getStatusString() const {
+string_view Order::getStatusString() const {
     switch(status) {
-        case OrderStatus::PENDING: return "PENDING";
+        case OrderStatus::NEW: return "NEW";
+        case OrderStatus::ACKED: return "ACKED";
+        case OrderStatus::PARTIALLY_FILLED: return "PARTIALLY_FILLED";
         case OrderStatus::FILLED: return "FILLED";
+        case OrderStatus::PENDING_CANCEL: return "PENDING_CANCEL";
         case OrderStatus::CANCELLED: return "CANCELLED";
+        case OrderStatus::REJECTED: return "REJECTED";
+        case OrderStatus::PENDING_REPLACE: return "PENDING_REPLACE";
         default: return "UNKNOWN";
     }
 }
 
 // OrderManager implementation
-void OrderManager::placeOrder(const string& symbol, OrderType type, int quantity, double price) {
-    Order newOrder(symbol, type, quantity, price);
-    orders.push_back(newOrder);
+void OrderManager::link(Order* order) {
+    if (order->symbol >= bySymbol.size()) {
+        bySymbol.resize(order->symbol + 1);
+    }
+    SymbolOrders& list = bySymbol[order->symbol];
+    order->prev = list.tail;
+    if (list.tail != nullptr) {
+        list.tail->next = order;
+    } else {
+        list.head = order;
+    }
+    list.tail = order;
+    list.count++;
+    liveIndex.insert(order->orderId, order);
+}
+
+bool OrderManager::refuseUnjournaled(OrderId orderId) const {
+    cout << "\n❌ Order journal could not record a change to order #" << orderId << ", change refused!" << endl;
+    return false;
+}
+
+OrderId OrderManager::placeOrder(SymbolId symbol, OrderType type, std::int64_t quantity, Price price) {
+    Order* order = pool.template allocate<Order>(symbol, type, quantity, price);
+    if (journal != nullptr && !journal->recordPlace(*order)) {
+        refuseUnjournaled(order->orderId);
+        pool.deallocate(order);
+        return INVALID_ORDER_ID;
+    }
+    link(order);
     
-    cout << "\n✓ Order placed successfully!" << endl;
-    newOrder.displayOrder();
+    const Order& newOrder = *order;
+    logAsync("\n✓ Order placed successfully!\nOrder #{} | {} | {} | Qty: {} | Price: ${:.2f} | Status: {}",
+             newOrder.orderId, symbolName(newOrder.symbol), newOrder.getTypeString(), newOrder.quantity,
+             newOrder.price.toDouble(), newOrder.getStatusString());
+    return newOrder.orderId;
+}
+
+bool OrderManager::restoreOrder(OrderId orderId, SymbolId symbol, OrderType type, std::int64_t quantity, Price price,
+                                std::int64_t timestamp) {
+    // Live orders only; the journal never repeats an ID, so the archive is not searched
+    if (orderId == INVALID_ORDER_ID || liveIndex.find(orderId) != nullptr) return false;
+    Order* order = pool.template allocate<Order>(orderId, symbol, type, quantity, price);
+    order->timestamp = timestamp;
+    if (journal != nullptr && !journal->recordPlace(*order)) {
+        pool.deallocate(order);
+        return refuseUnjournaled(orderId);
+    }
+    link(order);
+    return true;
+}
+
+void OrderManager::retire(Order* order) {
+    SymbolOrders& list = bySymbol[order->symbol];
+    if (order->prev != nullptr) {
+        order->prev->next = order->next;
+    } else {
+        list.head = order->next;
+    }
+    if (order->next != nullptr) {
+        order->next->prev = order->prev;
+    } else {
+        list.tail = order->prev;
+    }
+    list.count--;
+    
+    order->prev = nullptr;
+    order->next = nullptr;
+    if (order->symbol >= archivedBySymbol.size()) {
+        archivedBySymbol.resize(order->symbol + 1);
+    }
+    archivedBySymbol[order->symbol].push_back(static_cast<std::uint32_t>(archive.size()));
+    archiveIndex.insert(order->orderId, archive.size());
+    archive.push_back(*order);
+    liveIndex.erase(order->orderId);
+    pool.deallocate(order);
+}
+
+void OrderManager::reserveArchive(std::size_t orders) {
+    archive.reserve(archive.size() + orders);
+    archiveIndex.reserve(archiveIndex.size() + orders);
 }
 
 void OrderManager::showAllOrders() const {
-    if (orders.empty()) {
+    if (liveIndex.empty() && archive.empty()) {
         cout << "\nNo orders found." << endl;
         return;
     }
     
     cout << "\n=== All Orders ===" << endl;
-    for (const auto& order : orders) {
+    for (SymbolId symbol = 0; symbol < bySymbol.size(); symbol++) {
+        forEachLive(symbol, [](const Order& order) { order.displayOrder(); });
+    }
+    for (const auto& order : archive) {
         order.displayOrder();
     }
 }
 
 void OrderManager::showOrdersForSymbol(const string& symbol) const {
     cout << "\n=== Orders for " << symbol << " ===" << endl;
+    const SymbolId id = findSymbolId(symbol);
     bool found = false;
     
-    for (const auto& order : orders) {
-        if (order.symbol == symbol) {
-            order.displayOrder();
+    forEachLive(id, [&found](const Order& order) {
+        order.displayOrder();
+        found = true;
+    });
+    if (id < archivedBySymbol.size()) {
+        for (std::uint32_t position : archivedBySymbol[id]) {
+            archive[position].displayOrder();
             found = true;
         }
     }
@@ -74,10 +188,21 @@ void OrderManager::showOrdersForSymbol(const string& symbol) const {
     }
 }
 
-bool OrderManager::cancelOrder(int orderId) {
-    for (auto& order : orders) {
-        if (order.orderId == orderId && order.status == OrderStatus::PENDING) {
-            order.status = OrderStatus::CANCELLED;
+bool OrderManager::cancelOrder(OrderId orderId) {
+    Order** live = liveIndex.find(orderId);
+    if (live != nullptr) {
+        Order next = **live;
+        // No venue behind the local book, so the cancel is acknowledged at once
+        if (next.onEvent(OrderEvent::CANCEL_REQUEST)) {
+            next.onEvent(OrderEvent::CANCEL_ACK);
+            // Both records or neither, so a replay cannot stop at PENDING_CANCEL
+            if (journal != nullptr && (!journal->canAppend(2) ||
+                                       !journal->recordEvent(orderId, OrderEvent::CANCEL_REQUEST) ||
+                                       !journal->recordEvent(orderId, OrderEvent::CANCEL_ACK))) {
+                return refuseUnjournaled(orderId);
+            }
+            **live = next;
+            retire(*live);
             cout << "\n✓ Order #" << orderId << " cancelled successfully!" << endl;
             return true;
         }
@@ -86,3 +211,46 @@ bool OrderManager::cancelOrder(int orderId) {
     cout << "\n✗ Order #" << orderId << " not found or already processed!" << endl;
     return false;
 }
+
+bool OrderManager::fillOrder(OrderId orderId) {
+    Order** live = liveIndex.find(orderId);
+    return live != nullptr && fillOrder(orderId, (*live)->leaves());
+}
+
+bool OrderManager::fillOrder(OrderId orderId, std::int64_t quantity) {
+    Order** live = liveIndex.find(orderId);
+    if (live == nullptr) return false;
+    Order next = **live;
+    if (!next.onFill(quantity)) return false;
+    if (journal != nullptr && !journal->recordFill(orderId, quantity)) return refuseUnjournaled(orderId);
+    **live = next;
+    if (isTerminal((*live)->status)) retire(*live);
+    return true;
+}
+
+bool OrderManager::amendOrder(OrderId orderId, std::int64_t quantity, Price price, std::int64_t stampAt) {
+    Order** live = liveIndex.find(orderId);
+    if (live == nullptr) return false;
+    Order next = **live;
+    if (!next.amend(quantity, price, stampAt)) return false;
+    if (journal != nullptr && !journal->recordAmend(next)) return refuseUnjournaled(orderId);
+    **live = next;
+    return true;
+}
+
+bool OrderManager::applyEvent(OrderId orderId, OrderEvent event) {
+    Order** live = liveIndex.find(orderId);
+    if (live == nullptr) return false;
+    Order next = **live;
+    if (!next.onEvent(event)) return false;
+    if (journal != nullptr && !journal->recordEvent(orderId, event)) return refuseUnjournaled(orderId);
+    **live = next;
+    if (isTerminal((*live)->status)) retire(*live);
+    return true;
+}
+
+const Order* OrderManager::findOrder(OrderId orderId) const {
+    if (Order* const* live = liveIndex.find(orderId)) return *live;
+    const std::size_t* position = archiveIndex.find(orderId);
+    return (position != nullptr) ? &archive[*position] : nullptr;
+}
@@ -0,0 +1,258 @@
+#include "OrderBook.h"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+
+namespace {
+    constexpr std::size_t WORD_BITS = 64;
+    
+    // Highest occupied slot <= from, or -1
+    std::int64_t highestAtOrBelow(const std::vector<std::uint64_t>& bits, std::int64_t from) {
+        if (from < 0) return -1;
+        std::size_t word = static_cast<std::size_t>(from) / WORD_BITS;
+        std::uint64_t mask = bits[word] & (~0ULL >> (WORD_BITS - 1 - static_cast<std::size_t>(from) % WORD_BITS));
+        while (true) {
+            if (mask != 0) return static_cast<std::int64_t>(word * WORD_BITS + WORD_BITS - 1 - std::countl_zero(mask));
+            if (word == 0) return -1;
+            mask = bits[--word];
+        }
+    }
+    
+    // Lowest occupied slot >= from, or -1
+    std::int64_t lowestAtOrAbove(const std::vector<std::uint64_t>& bits, std::int64_t from) {
+        if (from >= static_cast<std::int64_t>(bits.size() * WORD_BITS)) return -1;
+        std::size_t word = static_cast<std::size_t>(from) / WORD_BITS;
+        std::uint64_t mask = bits[word] & (~0ULL << (static_cast<std::size_t>(from) % WORD_BITS));
+        while (true) {
+            if (mask != 0) return static_cast<std::int64_t>(word * WORD_BITS + std::countr_zero(mask));
+            if (++word == bits.size()) return -1;
+            mask = bits[word];
+        }
+    }
+    
+    bool isBetter(BookSide side, std::int64_t slot, std::int64_t best) {
+        return best < 0 || (side == BookSide::BID ? slot > best : slot < best);
+    }
+}
+
+OrderBook::OrderBook(Price tickSize, std::size_t levels)
+    : tick(tickSize.raw() > 0 ? tickSize : Price::fromRaw(1)),
+      capacity(std::bit_ceil(std::max(levels, WORD_BITS))) {
+    for (SideLevels* side : {&bids, &asks}) {
+        side->quantity.assign(capacity, 0);
+        side->occupied.assign(capacity / WORD_BITS, 0);
+    }
+}
+
+std::int64_t OrderBook::slotFor(BookSide side, std::int64_t tickIndex, bool adding) {
+    std::int64_t slot = tickIndex - baseTick;
+    if (slot >= 0 && slot < static_cast<std::int64_t>(capacity)) return slot;
+    
+    // Outside the window: only a new touch moves it, anything deeper is not kept
+    if (!adding || !isBetter(side, slot, sideOf(side).best)) return -1;
+    
+    std::int64_t centre = tickIndex;
+    const SideLevels& other = sideOf(side == BookSide::BID ? BookSide::ASK : BookSide::BID);
+    if (other.best >= 0) {
+        std::int64_t otherTick = baseTick + other.best;
+        // Keep both touches in the window when they fit
+        if (std::abs(otherTick - tickIndex) < static_cast<std::int64_t>(capacity) - 1) {
+            centre = (tickIndex + otherTick) / 2;
+        }
+    }
+    recentre(centre);
+    return tickIndex - baseTick;
+}
+
+void OrderBook::setSlot(BookSide side, std::int64_t slot, std::int64_t quantity) {
+    SideLevels& levels = sideOf(side);
+    std::int64_t old = levels.quantity[slot];
+    levels.quantity[slot] = quantity;
+    
+    const std::uint64_t bit = 1ULL << (slot % WORD_BITS);
+    if (quantity != 0 && old == 0) {
+        levels.occupied[slot / WORD_BITS] |= bit;
+        levels.levels++;
+        if (isBetter(side, slot, levels.best)) levels.best = slot;
+    } else if (quantity == 0 && old != 0) {
+        levels.occupied[slot / WORD_BITS] &= ~bit;
+        levels.levels--;
+        if (slot == levels.best) {
+            levels.best = (side == BookSide::BID) ? highestAtOrBelow(levels.occupied, slot - 1)
+                                                  : lowestAtOrAbove(levels.occupied, slot + 1);
+        }
+    }
+}
+
+void OrderBook::recentre(std::int64_t centreTick) {
+    const std::int64_t newBase = centreTick - static_cast<std::int64_t>(capacity / 2);
+    const std::int64_t shift = newBase - baseTick;
+    
+    for (SideLevels* side : {&bids, &asks}) {
+        std::vector<std::int64_t> moved(capacity, 0);
+        std::fill(side->occupied.begin(), side->occupied.end(), 0);
+        side->levels = 0;
+        
+        for (std::int64_t slot = 0; slot < static_cast<std::int64_t>(capacity); slot++) {
+            if (side->quantity[slot] == 0) continue;
+            std::int64_t target = slot - shift;
+            if (target < 0 || target >= static_cast<std::int64_t>(capacity)) continue;  // fell off the window
+            moved[target] = side->quantity[slot];
+            side->occupied[target / WORD_BITS] |= 1ULL << (target % WORD_BITS);
+            side->levels++;
+        }
+        side->quantity.swap(moved);
+    }
+    
+    baseTick = newBase;
+    bids.best = highestAtOrBelow(bids.occupied, static_cast<std::int64_t>(capacity) - 1);
+    asks.best = lowestAtOrAbove(asks.occupied, 0);
+}
+
+bool OrderBook::update(BookSide side, Price price, std::int64_t quantity) {
+    if (quantity < 0 || !price.isOnTick(tick)) return false;
+    
+    std::int64_t slot = slotFor(side, price.raw() / tick.raw(), quantity != 0);
+    if (slot < 0) {
+        if (quantity == 0) return true;  // removing a level that was never kept
+        dropped++;
+        return false;
+    }
+    setSlot(side, slot, quantity);
+    return true;
+}
+
+bool OrderBook::adjust(BookSide side, Price price, std::int64_t delta) {
+    if (!price.isOnTick(tick)) return false;
+    
+    std::int64_t slot = slotFor(side, price.raw() / tick.raw(), delta > 0);
+    if (slot < 0) {
+        if (delta > 0) dropped++;
+        return false;
+    }
+    std::int64_t quantity = sideOf(side).quantity[slot] + delta;
+    if (quantity < 0) return false;
+    setSlot(side, slot, quantity);
+    return true;
+}
+
+void OrderBook::clear() {
+    for (SideLevels* side : {&bids, &asks}) {
+        std::fill(side->quantity.begin(), side->quantity.end(), 0);
+        std::fill(side->occupied.begin(), side->occupied.end(), 0);
+        side->best = -1;
+        side->levels = 0;
+    }
+    dropped = 0;
+}
+
+Price OrderBook::mid() const {
+    if (hasBid() && hasAsk()) return (bestBid() + bestAsk()) / 2;
+    return hasBid() ? bestBid() : bestAsk();
+}
+
+std::int64_t OrderBook::quantityAt(BookSide side, Price price) const {
+    if (!price.isOnTick(tick)) return 0;
+    std::int64_t slot = price.raw() / tick.raw() - baseTick;
+    if (slot < 0 || slot >= static_cast<std::int64_t>(capacity)) return 0;
+    return sideOf(side).quantity[slot];
+}
+
+std::size_t OrderBook::depth(BookSide side, BookLevel* out, std::size_t maxLevels) const {
+    const SideLevels& levels = sideOf(side);
+    std::size_t written = 0;
+    std::int64_t slot = levels.best;
+    while (slot >= 0 && written < maxLevels) {
+        out[written++] = {priceOf(slot), levels.quantity[slot]};
+        slot = (side == BookSide::BID) ? highestAtOrBelow(levels.occupied, slot - 1)
+                                       : lowestAtOrAbove(levels.occupied, slot + 1);
+    }
+    return written;
+}
+
+std::vector<BookLevel> OrderBook::depth(BookSide side, std::size_t maxLevels) const {
+    std::vector<BookLevel> levels(std::min(maxLevels, levelCount(side)));
+    levels.resize(depth(side, levels.data(), levels.size()));
+    return levels;
+}
+
+OrderBookManager::OrderBookManager(const SymbolTable& symbolNames, Price tickSize, std::size_t levelsPerSide)
+    : symbols(&symbolNames), tick(tickSize), levels(levelsPerSide) {
+}
+
+OrderBook& OrderBookManager::book(SymbolId symbol) {
+    if (symbol >= books.size()) books.resize(symbol + 1);
+    if (!books[symbol]) books[symbol] = std::make_unique<OrderBook>(tick, levels);
+    return *books[symbol];
+}
+
+void OrderBookManager::assign(SymbolId symbol, const OrderBook& levels) {
+    if (symbol >= books.size()) books.resize(symbol + 1);
+    books[symbol] = std::make_unique<OrderBook>(levels);
+}
+
+const OrderBook* OrderBookManager::find(SymbolId symbol) const {
+    return (symbol < books.size()) ? books[symbol].get() : nullptr;
+}
+
+void synthesizeDepth(const TickStore& ticks, std::vector<BookUpdate>& out, std::size_t levels, Price tickSize) {
+    const auto& timestamps = ticks.timestampColumn();
+    const auto& symbolIds = ticks.symbolColumn();
+    const auto& prices = ticks.priceColumn();
+    const auto& volumes = ticks.volumeColumn();
+    
+    std::vector<Price> lastTrade(ticks.symbolTable().size());
+    std::vector<bool> traded(ticks.symbolTable().size(), false);
+    out.reserve(out.size() + ticks.size() * levels * 2);
+    
+    const std::int64_t depthLevels = static_cast<std::int64_t>(levels);
+    for (std::size_t row = 0; row < ticks.size(); row++) {
+        const SymbolId symbol = symbolIds[row];
+        const Price trade = prices[row].roundToTick(tickSize);
+        const std::int64_t ts = timestamps[row];
+        
+        // Pull the previous ladder's levels that the new one does not cover
+        if (traded[symbol]) {
+            const std::int64_t move = (trade - lastTrade[symbol]).raw() / tickSize.raw();
+            for (std::int64_t k = 1; k <= depthLevels; k++) {
+                std::int64_t bidOffset = k + move;  // ticks below the new trade
+                if (bidOffset < 1 || bidOffset > depthLevels) {
+                    out.push_back({ts, symbol, BookSide::BID, lastTrade[symbol] - tickSize * k, 0});
+                }
+                std::int64_t askOffset = k - move;  // ticks above the new trade
+                if (askOffset < 1 || askOffset > depthLevels) {
+                    out.push_back({ts, symbol, BookSide::ASK, lastTrade[symbol] + tickSize * k, 0});
+                }
+            }
+        }
+        
+        const std::int64_t size = std::max(volumes[row], 1);
+        for (std::int64_t k = 1; k <= depthLevels; k++) {
+            out.push_back({ts, symbol, BookSide::BID, trade - tickSize * k, size * k});
+            out.push_back({ts, symbol, BookSide::ASK, trade + tickSize * k, size * k});
+        }
+        lastTrade[symbol] = trade;
+        traded[symbol] = true;
+    }
+}
+
+void synthesizeDepth(const TickStore& ticks, OrderBookManager& books, std::size_t levels, Price tickSize) {
+    const auto& symbolIds = ticks.symbolColumn();
+    std::vector<std::size_t> lastRow(ticks.symbolTable().size(), ticks.size());
+    for (std::size_t row = 0; row < ticks.size(); row++) {
+        lastRow[symbolIds[row]] = row;
+    }
+    
+    const std::int64_t depthLevels = static_cast<std::int64_t>(levels);
+    for (SymbolId symbol = 0; symbol < lastRow.size(); symbol++) {
+        const std::size_t row = lastRow[symbol];
+        if (row == ticks.size()) continue;
+        const Price trade = ticks.priceColumn()[row].roundToTick(tickSize);
+        const std::int64_t ts = ticks.timestampColumn()[row];
+        const std::int64_t size = std::max(ticks.volumeColumn()[row], 1);
+        for (std::int64_t k = 1; k <= depthLevels; k++) {
+            books.apply({ts, symbol, BookSide::BID, trade - tickSize * k, size * k});
+            books.apply({ts, symbol, BookSide::ASK, trade + tickSize * k, size * k});
+        }
+    }
+}
@@ -0,0 +1,43 @@
+#include "OrderId.h"
+
+namespace {
+
+// Remaining sequence numbers of the calling thread's current block, per venue
+struct BlockCursor {
+    std::uint64_t next = 0;
+    std::uint64_t end = 0;
+};
+
+thread_local BlockCursor cursors[OrderIdAllocator::MAX_VENUES];
+std::atomic<std::uint32_t> threadsSeen{0};
+
+} // namespace
+
+std::atomic<std::uint64_t> OrderIdAllocator::issued[MAX_VENUES] = {};
+
+std::uint32_t OrderIdAllocator::threadIndex() {
+    thread_local const std::uint32_t index = threadsSeen.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+OrderId OrderIdAllocator::next(Venue venue) {
+    const std::size_t v = static_cast<std::size_t>(venue);
+    BlockCursor& cursor = cursors[v];
+    if (cursor.next == cursor.end) {
+        // Only uniqueness matters, so the block grab needs no ordering
+        cursor.next = issued[v].fetch_add(BLOCK_SIZE, std::memory_order_relaxed) + 1;
+        cursor.end = cursor.next + BLOCK_SIZE;
+    }
+    return make(venue, threadIndex(), cursor.next++);
+}
+
+void OrderIdAllocator::reserveThrough(Venue venue, std::uint64_t sequence) {
+    const std::size_t v = static_cast<std::size_t>(venue);
+    std::uint64_t current = issued[v].load(std::memory_order_relaxed);
+    while (current < sequence && !issued[v].compare_exchange_weak(current, sequence, std::memory_order_relaxed)) {
+    }
+    BlockCursor& cursor = cursors[v];
+    if (cursor.next <= sequence) {
+        cursor.next = cursor.end;
+    }
+}
@@ -0,0 +1,383 @@
+#include "OrderJournal.h"
+#include "Clock.h"
+#include "RiskManager.h"
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char MAGIC[8] = {'H', 'F', 'T', 'J', 'R', 'N', 'L', '1'};
+constexpr std::uint32_t VERSION = 1;
+
+struct JournalHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+};
+
+// Mix of the seven words after the checksum; cheap, and a torn or zeroed
+// record fails it
+std::uint64_t checksumOf(const JournalRecord& record) {
+    std::uint64_t words[7];
+    std::memcpy(words, reinterpret_cast<const char*>(&record) + sizeof(std::uint64_t), sizeof(words));
+    std::uint64_t hash = 0x6a09e667f3bcc908ULL;
+    for (std::uint64_t word : words) {
+        hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+        hash ^= hash >> 32;
+    }
+    return hash | 1;  // never 0, so an unwritten slot cannot pass
+}
+
+// Fault in the slots still to be written, writable, so appends never take a
+// page fault; best effort on kernels without MADV_POPULATE_WRITE
+void prefault(char* base, std::size_t from, std::size_t to) {
+    const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    from &= ~(page - 1);
+    if (from < to) madvise(base + from, to - from, MADV_POPULATE_WRITE);
+}
+
+bool reserveSpace(int fd, std::size_t length) {
+    // Allocate the blocks now so a full disk shows up here, not as SIGBUS on a store
+    if (posix_fallocate(fd, 0, static_cast<off_t>(length)) == 0) return true;
+    return ftruncate(fd, static_cast<off_t>(length)) == 0;
+}
+
+} // namespace
+
+OrderJournal::~OrderJournal() {
+    close();
+}
+
+bool OrderJournal::open(const std::string& path, std::size_t capacity, std::chrono::microseconds flushEvery) {
+    close();
+    
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) return false;
+    
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close();
+        return false;
+    }
+    const std::size_t existing = static_cast<std::size_t>(st.st_size);
+    JournalHeader header;
+    if (existing >= HEADER_SIZE) {
+        if (pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+            std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+            header.recordSize != sizeof(JournalRecord)) {
+            close();  // not ours, leave it alone
+            return false;
+        }
+    }
+    // Whole pages, so the file can later be mapped on in page-aligned pieces
+    const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t wanted = HEADER_SIZE + std::max<std::size_t>(capacity, 1) * sizeof(JournalRecord);
+    const std::size_t fileLength = (std::max(existing, wanted) + page - 1) & ~(page - 1);
+    if (fileLength > MAX_BYTES || (existing < fileLength && !reserveSpace(fd, fileLength))) {
+        close();
+        return false;
+    }
+    
+    // Reserve address space for every later size, then map the file at its start
+    void* base = mmap(nullptr, MAX_BYTES, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) {
+        close();
+        return false;
+    }
+    mapped = static_cast<char*>(base);
+    if (mmap(mapped, fileLength, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+        close();
+        return false;
+    }
+    length.store(fileLength, std::memory_order_release);
+    
+    if (existing < HEADER_SIZE) {
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.recordSize = sizeof(JournalRecord);
+        std::memcpy(mapped, &header, sizeof(header));
+    }
+    
+    // Find the end of the valid records
+    std::size_t offset = HEADER_SIZE;
+    JournalRecord record;
+    for (; offset + sizeof(JournalRecord) <= fileLength; offset += sizeof(JournalRecord)) {
+        std::memcpy(&record, mapped + offset, sizeof(record));
+        if (record.sequence != nextSequence || record.checksum != checksumOf(record)) break;
+        nextSequence++;
+    }
+    // Clear everything a crash left behind it, so old records cannot pass for
+    // new ones. Pages can reach the disk out of order, so valid records may
+    // sit past an all-zero hole; the whole tail is checked, not just up to it.
+    bool cleared = false;
+    for (std::size_t stale = offset; stale + sizeof(JournalRecord) <= fileLength; stale += sizeof(JournalRecord)) {
+        std::memcpy(&record, mapped + stale, sizeof(record));
+        if (record.checksum == 0 && record.sequence == 0) continue;
+        std::memset(mapped + stale, 0, sizeof(JournalRecord));
+        cleared = true;
+    }
+    if (cleared || existing < HEADER_SIZE) {
+        msync(mapped, fileLength, MS_SYNC);
+    }
+    
+    prefault(mapped, offset, fileLength);
+    
+    writeOffset = offset;
+    published.store(offset, std::memory_order_release);
+    synced = offset;
+    growIfNeeded();  // a recovered journal may already be past the high-water mark
+    writeLimit = length.load(std::memory_order_acquire);
+    declared.clear();
+    dropped = 0;
+    flushInterval = flushEvery;
+    running.store(true, std::memory_order_release);
+    flusher = std::thread([this]() { run(); });
+    return true;
+}
+
+void OrderJournal::close() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running.store(false, std::memory_order_release);
+    }
+    wake.notify_all();
+    if (flusher.joinable()) {
+        flusher.join();
+    }
+    if (mapped != nullptr) {
+        if (length.load(std::memory_order_relaxed) != 0) syncPublished();
+        munmap(mapped, MAX_BYTES);  // the reservation and every file mapping in it
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    fd = -1;
+    mapped = nullptr;
+    length.store(0, std::memory_order_relaxed);
+    writeOffset = 0;
+    writeLimit = 0;
+    nextSequence = 1;
+    published.store(0, std::memory_order_relaxed);
+    synced = 0;
+}
+
+bool OrderJournal::grow() {
+    // Flusher (or open) only: map the next piece of the file right after the
+    // current one, inside the reservation, so the writer's base never moves
+    const std::size_t current = length.load(std::memory_order_relaxed);
+    const std::size_t next = std::min(current * 2, MAX_BYTES);
+    if (next == current || !reserveSpace(fd, next)) return false;
+    if (mmap(mapped + current, next - current, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd,
+             static_cast<off_t>(current)) == MAP_FAILED) {
+        return false;
+    }
+    prefault(mapped, current, next);
+    length.store(next, std::memory_order_release);
+    return true;
+}
+
+void OrderJournal::growIfNeeded() {
+    // Past half full: the writer needs as long again as it took to get here
+    // before it can reach the end, many flush intervals
+    while (published.load(std::memory_order_acquire) - HEADER_SIZE >
+           (length.load(std::memory_order_relaxed) - HEADER_SIZE) / 2) {
+        if (!grow()) return;
+    }
+}
+
+bool OrderJournal::canAppend(std::size_t records) {
+    if (writeOffset + records * sizeof(JournalRecord) > writeLimit) {
+        writeLimit = length.load(std::memory_order_acquire);
+    }
+    return writeOffset + records * sizeof(JournalRecord) <= writeLimit;
+}
+
+bool OrderJournal::append(JournalRecord& record) {
+    if (!canAppend(1)) {
+        dropped++;
+        return false;
+    }
+    record.sequence = nextSequence++;
+    record.checksum = checksumOf(record);
+    std::memcpy(mapped + writeOffset, &record, sizeof(record));
+    writeOffset += sizeof(JournalRecord);
+    published.store(writeOffset, std::memory_order_release);
+    return true;
+}
+
+bool OrderJournal::declare(SymbolId symbol) {
+    if (symbol < declared.size() && declared[symbol]) return true;
+    if (symbol >= declared.size()) {
+        declared.resize(symbol + 1);
+    }
+    const std::string& name = symbolName(symbol);
+    JournalRecord record{};
+    record.kind = JournalKind::SYMBOL;
+    record.symbol = symbol;
+    record.nameLength = static_cast<std::uint8_t>(std::min(name.size(), MAX_SYMBOL_LENGTH));
+    std::memcpy(record.name, name.data(), record.nameLength);
+    if (!append(record)) return false;
+    declared[symbol] = true;
+    return true;
+}
+
+bool OrderJournal::recordPlace(const Order& order) {
+    if (!declare(order.symbol)) return false;
+    JournalRecord record{};
+    record.kind = JournalKind::PLACE;
+    record.timestamp = order.timestamp;
+    record.symbol = order.symbol;
+    record.type = order.type;
+    record.orderId = order.orderId;
+    record.price = order.price.raw();
+    record.quantity = order.quantity;
+    return append(record);
+}
+
+bool OrderJournal::recordFill(OrderId orderId, std::int64_t quantity) {
+    JournalRecord record{};
+    record.kind = JournalKind::FILL;
+    record.timestamp = Clock::now();
+    record.symbol = INVALID_SYMBOL;
+    record.orderId = orderId;
+    record.quantity = quantity;
+    return append(record);
+}
+
+bool OrderJournal::recordAmend(const Order& order) {
+    JournalRecord record{};
+    record.kind = JournalKind::AMEND;
+    record.timestamp = order.timestamp;
+    record.symbol = INVALID_SYMBOL;
+    record.orderId = order.orderId;
+    record.price = order.price.raw();
+    record.quantity = order.quantity;
+    return append(record);
+}
+
+bool OrderJournal::recordEvent(OrderId orderId, OrderEvent event) {
+    JournalRecord record{};
+    record.kind = JournalKind::EVENT;
+    record.timestamp = Clock::now();
+    record.symbol = INVALID_SYMBOL;
+    record.event = event;
+    record.orderId = orderId;
+    return append(record);
+}
+
+bool OrderJournal::recordPosition(const Order& fill) {
+    if (!declare(fill.symbol)) return false;
+    JournalRecord record{};
+    record.kind = JournalKind::POSITION;
+    record.timestamp = Clock::now();
+    record.symbol = fill.symbol;
+    record.type = fill.type;
+    record.orderId = fill.orderId;
+    record.price = fill.price.raw();
+    record.quantity = fill.quantity;
+    return append(record);
+}
+
+void OrderJournal::syncPublished() {
+    std::lock_guard<std::mutex> lock(syncMutex);
+    const std::size_t end = published.load(std::memory_order_acquire);
+    if (end <= synced) return;
+    // msync wants a page-aligned start
+    const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t begin = synced & ~(page - 1);
+    msync(mapped + begin, end - begin, MS_SYNC);
+    synced = end;
+}
+
+void OrderJournal::sync() {
+    if (mapped != nullptr) syncPublished();
+}
+
+void OrderJournal::run() {
+    // open() has already synced and sized the file, so each pass starts with the wait
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    while (!wake.wait_for(lock, flushInterval, [this]() { return !running.load(std::memory_order_acquire); })) {
+        lock.unlock();
+        growIfNeeded();  // before the msync, which can wait on the disk
+        syncPublished();
+        lock.lock();
+    }
+}
+
+JournalReplayStats OrderJournal::replay(OrderManager& orders, RiskManager& risk) const {
+    JournalReplayStats stats;
+    const std::uint64_t start = Clock::ticks();
+    std::vector<SymbolId> symbols;  // journal SymbolId -> this process's
+    std::uint64_t highest[OrderIdAllocator::MAX_VENUES] = {};
+    
+    // Size the archive once instead of growing it through the replay
+    std::size_t placed = 0;
+    for (std::size_t offset = HEADER_SIZE; offset < writeOffset; offset += sizeof(JournalRecord)) {
+        placed += reinterpret_cast<const JournalRecord*>(mapped + offset)->kind == JournalKind::PLACE;
+    }
+    orders.reserveArchive(placed);
+    
+    JournalRecord record;
+    for (std::size_t offset = HEADER_SIZE; offset < writeOffset; offset += sizeof(JournalRecord)) {
+        std::memcpy(&record, mapped + offset, sizeof(record));
+        stats.records++;
+        const SymbolId symbol = (record.symbol < symbols.size()) ? symbols[record.symbol] : INVALID_SYMBOL;
+        bool applied = true;
+        
+        switch (record.kind) {
+            case JournalKind::SYMBOL:
+                if (record.symbol >= symbols.size()) {
+                    symbols.resize(record.symbol + 1, INVALID_SYMBOL);
+                }
+                symbols[record.symbol] = internSymbol(std::string_view(record.name, record.nameLength));
+                break;
+            case JournalKind::PLACE: {
+                stats.orders++;
+                applied = symbol != INVALID_SYMBOL &&
+                          orders.restoreOrder(record.orderId, symbol, record.type, record.quantity,
+                                              Price::fromRaw(record.price), record.timestamp);
+                const std::size_t venue = static_cast<std::size_t>(OrderIdAllocator::venueOf(record.orderId));
+                highest[venue] = std::max(highest[venue], OrderIdAllocator::sequenceOf(record.orderId));
+                break;
+            }
+            case JournalKind::FILL:
+                stats.fills++;
+                applied = orders.fillOrder(record.orderId, record.quantity);
+                break;
+            case JournalKind::AMEND:
+                applied = orders.amendOrder(record.orderId, record.quantity, Price::fromRaw(record.price),
+                                            record.timestamp);
+                break;
+            case JournalKind::EVENT:
+                applied = orders.applyEvent(record.orderId, record.event);
+                break;
+            case JournalKind::POSITION: {
+                stats.positions++;
+                if (symbol == INVALID_SYMBOL) {
+                    applied = false;
+                    break;
+                }
+                Order fill(record.orderId, symbol, record.type, record.quantity, Price::fromRaw(record.price));
+                fill.status = OrderStatus::FILLED;
+                fill.filledQuantity = fill.quantity;
+                risk.updatePosition(fill);
+                break;
+            }
+            default:
+                applied = false;
+                break;
+        }
+        if (!applied) stats.rejected++;
+    }
+    
+    for (std::size_t venue = 0; venue < OrderIdAllocator::MAX_VENUES; venue++) {
+        if (highest[venue] != 0) OrderIdAllocator::reserveThrough(static_cast<Venue>(venue), highest[venue]);
+    }
+    stats.nanos = Clock::ticksToNanos(Clock::ticks() - start);
+    return stats;
+}
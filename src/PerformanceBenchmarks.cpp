@@ -3,7 +3,31 @@
 #include "MarketData.h"
 #include "Strategy.h"
 #include "Order.h"
+#include "TickLoader.h"
+#include "TickStore.h"
+#include "BinaryTickFile.h"
+#include "TickArchive.h"
+#include "PriceHistory.h"
+#include "RollingIndicators.h"
+#include "AsyncLogger.h"
+#include "LatencyTrace.h"
+#include "ThreadPool.h"
+#include "Clock.h"
+#include "IndicatorKernels.h"
+#include "OrderBook.h"
+#include "L3OrderBook.h"
+#include "ItchFeed.h"
+#include "BarAggregator.h"
+#include "TickIndex.h"
+#include "MappedFile.h"
+#include "OrderJournal.h"
+#include <algorithm>
 #include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <map>
+#include <sstream>
+#include <thread>
 #include <vector>
 
 class PerformanceBenchmarks {
@@ -13,6 +37,7 @@ public:
         benchmarkSignalGeneration();
         benchmarkOrderProcessing();
         benchmarkMemoryUsage();
+        benchmarkLogging();
     }
     
 private:
@@ -37,13 +62,139 @@ private:
             ASSERT_TRUE(duration.count() < 5000); // Less than 5 seconds
         });
         
+        suite.addTest("Mapped CSV Loader vs Stream Loader", []() {
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_loader_test.csv").string();
+            ASSERT_TRUE(generateTickCsv(path, 200000));
+            
+            std::vector<MarketData> streamData;
+            auto start = std::chrono::high_resolution_clock::now();
+            ASSERT_TRUE(loadDataStream(streamData, path));
+            auto mid = std::chrono::high_resolution_clock::now();
+            std::vector<MarketData> mappedData;
+            ASSERT_TRUE(loadData(mappedData, path));
+            auto end = std::chrono::high_resolution_clock::now();
+            std::filesystem::remove(path);
+            
+            auto streamUs = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+            auto mappedUs = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+            std::cout << "📊 200,000 rows: stream " << streamUs << "μs, mmap " << mappedUs << "μs" << std::endl;
+            
+            ASSERT_EQ(streamData.size(), mappedData.size());
+            ASSERT_EQ(streamData.back().Abb, mappedData.back().Abb);
+            ASSERT_EQ(streamData.back().price, mappedData.back().price);
+            ASSERT_TRUE(mappedUs < streamUs);
+        });
+        
+        suite.addTest("Binary Tick Load vs CSV Load", []() {
+            const auto tempDir = std::filesystem::temp_directory_path();
+            const std::string csvPath = (tempDir / "hft_binary_test.csv").string();
+            const std::string binaryPath = (tempDir / "hft_binary_test.ticks").string();
+            ASSERT_TRUE(generateTickCsv(csvPath, 200000));
+            ASSERT_TRUE(convertCsvToBinary(csvPath, binaryPath));
+            
+            TickStore csvStore;
+            auto start = std::chrono::high_resolution_clock::now();
+            ASSERT_TRUE(loadData(csvStore, csvPath));
+            auto mid = std::chrono::high_resolution_clock::now();
+            TickStore binaryStore;
+            ASSERT_TRUE(loadData(binaryStore, binaryPath));
+            auto end = std::chrono::high_resolution_clock::now();
+            std::filesystem::remove(csvPath);
+            std::filesystem::remove(binaryPath);
+            
+            auto csvUs = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+            auto binaryUs = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+            std::cout << "💾 200,000 rows: CSV " << csvUs << "μs, binary " << binaryUs << "μs" << std::endl;
+            
+            ASSERT_EQ(csvStore.size(), binaryStore.size());
+            ASSERT_TRUE(csvStore.priceColumn() == binaryStore.priceColumn());
+            ASSERT_TRUE(binaryUs < csvUs);
+        });
+        
+        suite.addTest("Compressed Archive Decode", []() {
+            const auto tempDir = std::filesystem::temp_directory_path();
+            const std::string csvPath = (tempDir / "hft_archive_test.csv").string();
+            const std::string archivePath = (tempDir / "hft_archive_test.tarc").string();
+            ASSERT_TRUE(generateTickCsv(csvPath, 1000000));
+            TickStore store;
+            ASSERT_TRUE(loadData(store, csvPath));
+            ASSERT_TRUE(writeTickArchive(archivePath, store));
+            std::filesystem::remove(csvPath);
+            
+            TickArchive archive;
+            ASSERT_TRUE(archive.open(archivePath));
+            TickStore decoded;
+            std::uint64_t start = Clock::ticks();
+            ASSERT_TRUE(archive.load(decoded));
+            double seconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / NANOS_PER_SECOND;
+            const double columnBytes = static_cast<double>(store.size()) * 24.0;
+            const double ratio = columnBytes / archive.compressedBytes();
+            archive.close();
+            std::filesystem::remove(archivePath);
+            
+            std::cout << "🗜️ 1,000,000 rows: archive " << ratio << "x smaller than the columns, decode "
+                      << columnBytes / seconds / 1e9 << " GB/s" << std::endl;
+            ASSERT_TRUE(store.priceColumn() == decoded.priceColumn());
+            ASSERT_TRUE(store.timestampColumn() == decoded.timestampColumn());
+            ASSERT_TRUE(ratio > 2.0);
+        });
+        
+        suite.addTest("Parallel CSV Loader", []() {
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_parallel_test.csv").string();
+            ASSERT_TRUE(generateTickCsv(path, 500000));
+            const double gigabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0 * 1024.0);
+            
+            TickStore sequential;
+            auto start = std::chrono::high_resolution_clock::now();
+            ASSERT_TRUE(loadTicksMapped(path, sequential));
+            auto mid = std::chrono::high_resolution_clock::now();
+            ThreadPool pool;
+            TickStore parallel;
+            ASSERT_TRUE(loadTicksParallel(path, parallel, pool));
+            auto end = std::chrono::high_resolution_clock::now();
+            std::filesystem::remove(path);
+            
+            double sequentialSeconds = std::chrono::duration<double>(mid - start).count();
+            double parallelSeconds = std::chrono::duration<double>(end - mid).count();
+            std::cout << "🧵 500,000 rows: 1 thread " << gigabytes / sequentialSeconds << " GB/s, "
+                      << pool.size() << " threads " << gigabytes / parallelSeconds << " GB/s" << std::endl;
+            
+            ASSERT_EQ(sequential.size(), parallel.size());
+            ASSERT_TRUE(sequential.priceColumn() == parallel.priceColumn());
+        });
+        
+        suite.addTest("Symbol Lookup", []() {
+            // The same names through std::map, the interning table and the perfect hash
+            std::map<std::string, SymbolId, std::less<>> tree;
+            for (SymbolId id = 0; id < globalSymbols().size(); id++) {
+                tree.emplace(symbolName(id), id);
+            }
+            const int lookups = 4000000;
+            std::uint64_t sinks[3] = {0, 0, 0};
+            double nanos[3];
+            for (int method = 0; method < 3; method++) {
+                std::uint64_t start = Clock::ticks();
+                for (int i = 0; i < lookups; i++) {
+                    std::string_view name = KNOWN_SYMBOL_NAMES[i & 7];
+                    if (method == 0) sinks[0] += tree.find(name)->second;
+                    else if (method == 1) sinks[1] += globalSymbols().find(name);
+                    else sinks[2] += knownSymbol(name);
+                }
+                nanos[method] = Clock::ticksToNanos(Clock::ticks() - start) / static_cast<double>(lookups);
+            }
+            std::cout << "🔤 Symbol lookup: std::map " << nanos[0] << "ns | table " << nanos[1]
+                      << "ns | perfect hash " << nanos[2] << "ns" << std::endl;
+            ASSERT_EQ(sinks[0], sinks[1]);
+            ASSERT_EQ(sinks[0], sinks[2]);
+        });
+        
         suite.addTest("Moving Average Performance", []() {
             // Create large dataset
             std::vector<MarketData> largeData;
             for (int i = 0; i < 10000; i++) {
                 MarketData data;
-                data.Abb = "PERF";
-                data.price = 100.0 + (i % 100) * 0.1;
+                data.Abb = internSymbol("PERF");
+                data.price = Price::fromDouble(100.0 + (i % 100) * 0.1);
                 largeData.push_back(data);
             }
             
@@ -63,6 +214,243 @@ private:
             ASSERT_TRUE(duration.count() < 100000);
         });
         
+        suite.addTest("Columnar Moving Average Performance", []() {
+            // Same workload as above, but spread across 10 symbols
+            std::vector<MarketData> largeData;
+            for (int i = 0; i < 10000; i++) {
+                MarketData data;
+                data.Abb = internSymbol("PERF" + std::to_string(i % 10));
+                data.price = Price::fromDouble(100.0 + (i % 100) * 0.1);
+                largeData.push_back(data);
+            }
+            TickStore store = TickStore::fromRows(largeData);
+            
+            auto start = std::chrono::high_resolution_clock::now();
+            double rowSum = 0.0;
+            for (int i = 0; i < 1000; i++) {
+                rowSum += calculateMovingAverage(largeData, "PERF3", 20);
+            }
+            auto mid = std::chrono::high_resolution_clock::now();
+            double columnSum = 0.0;
+            for (int i = 0; i < 1000; i++) {
+                columnSum += calculateMovingAverage(store, "PERF3", 20);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            
+            auto rowUs = std::chrono::duration_cast<std::chrono::microseconds>(mid - start).count();
+            auto columnUs = std::chrono::duration_cast<std::chrono::microseconds>(end - mid).count();
+            std::cout << "📈 1000 moving averages: rows " << rowUs << "μs, columns " << columnUs << "μs" << std::endl;
+            
+            ASSERT_NEAR(rowSum, columnSum, 1e-6);
+            ASSERT_TRUE(columnUs < rowUs);
+        });
+        
+        suite.addTest("Ring Buffer Moving Average Performance", []() {
+            PriceHistory history;
+            for (int i = 0; i < 1000000; i++) {
+                history.update(i % 100, Price::fromDouble(100.0 + (i % 100) * 0.1));
+            }
+            
+            auto start = std::chrono::high_resolution_clock::now();
+            double sum = 0.0;
+            for (int i = 0; i < 1000000; i++) {
+                sum += history.movingAverage(i % 100, 20);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            
+            std::cout << "📈 1,000,000 ring-buffer moving averages (100 symbols) in " << duration.count() << "μs" << std::endl;
+            ASSERT_TRUE(sum > 0.0);
+            ASSERT_TRUE(duration.count() < 1000000); // Under 1μs each
+        });
+        
+        suite.addTest("Rolling Indicator Throughput", []() {
+            const int symbols = 500;
+            const int ticks = 2000000;
+            RollingIndicatorEngine engine({5, 20, 50});
+            
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < ticks; i++) {
+                engine.onTick(i % symbols, 100.0 + (i % 257) * 0.01);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double seconds = std::chrono::duration<double>(end - start).count();
+            double ticksPerSecond = ticks / seconds;
+            
+            std::cout << "📈 " << ticks << " ticks x 3 windows across " << symbols << " symbols: "
+                      << ticksPerSecond / 1e6 << "M ticks/s" << std::endl;
+            ASSERT_TRUE(engine.sma(symbols - 1, 50) > 0.0);
+            ASSERT_TRUE(ticksPerSecond > 1000000.0);
+        });
+        
+        suite.addTest("SIMD Indicator Kernels", []() {
+            const std::size_t n = 4000000;
+            std::vector<double> prices(n);
+            for (std::size_t i = 0; i < n; i++) prices[i] = 100.0 + (i % 257) * 0.01;
+            std::vector<double> out(n);
+            
+            auto timeMean = [&](const IndicatorKernels& kernels) {
+                std::uint64_t start = Clock::ticks();
+                kernels.rollingMean(prices.data(), n, 20, out.data());
+                return static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / n;
+            };
+            const IndicatorKernels& best = indicatorKernels();
+            timeMean(best);  // warm-up
+            double scalarNs = timeMean(indicatorKernels(SimdLevel::SCALAR));
+            double bestNs = timeMean(best);
+            
+            std::cout << "🧮 SMA(20) over " << n << " prices: scalar " << scalarNs << "ns/elem, "
+                      << simdLevelName(best.level) << " " << bestNs << "ns/elem" << std::endl;
+            ASSERT_TRUE(out[n - 1] > 100.0);
+            // Runtime dispatch must never pick something slower than the fallback by much
+            ASSERT_TRUE(bestNs < scalarNs * 1.5);
+        });
+        
+        suite.addTest("L2 Book Update Latency", []() {
+            const std::size_t updates = 1000000;
+            OrderBook book;
+            std::vector<std::uint32_t> latencyTicks(updates);
+            unsigned seed = 99;
+            std::int64_t midTicks = 15000;
+            for (std::size_t i = 0; i < updates; i++) {
+                seed = seed * 1103515245u + 12345u;
+                BookSide side = ((seed >> 9) & 1) ? BookSide::BID : BookSide::ASK;
+                std::int64_t offset = 1 + static_cast<std::int64_t>((seed >> 10) % 20);
+                std::int64_t quantity = ((seed >> 16) % 3 == 0) ? 0 : 100;
+                if ((seed >> 28) == 0) {  // mid moves: delete the level it lands on
+                    bool up = (seed >> 8) & 1;
+                    midTicks += up ? 1 : -1;
+                    side = up ? BookSide::ASK : BookSide::BID;
+                    offset = 0;
+                    quantity = 0;
+                }
+                Price price = book.tickSize() * (side == BookSide::BID ? midTicks - offset : midTicks + offset);
+                
+                std::uint64_t start = Clock::ticks();
+                book.update(side, price, quantity);
+                latencyTicks[i] = static_cast<std::uint32_t>(Clock::ticks() - start);
+            }
+            std::sort(latencyTicks.begin(), latencyTicks.end());
+            std::int64_t p50 = Clock::ticksToNanos(latencyTicks[updates / 2]);
+            std::int64_t p99 = Clock::ticksToNanos(latencyTicks[updates * 99 / 100]);
+            
+            std::cout << "📚 " << updates << " L2 updates: p50 " << p50 << "ns, p99 " << p99 << "ns" << std::endl;
+            ASSERT_TRUE(book.hasBid() && book.hasAsk() && book.bestBid() < book.bestAsk());
+            ASSERT_TRUE(p50 < 1000);
+        });
+        
+        suite.addTest("L3 Book Replay", []() {
+            std::vector<OrderBookEvent> feed;
+            synthesizeOrderFlow(2000000, feed);
+            L3OrderBook book;
+            
+            std::uint64_t start = Clock::ticks();
+            std::size_t applied = 0;
+            for (const OrderBookEvent& event : feed) {
+                applied += book.apply(event);
+            }
+            double seconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / NANOS_PER_SECOND;
+            double messagesPerSecond = feed.size() / seconds;
+            
+            std::cout << "📖 Replayed " << feed.size() << " L3 events: " << messagesPerSecond / 1e6
+                      << "M msgs/s, " << book.orderCount() << " live orders" << std::endl;
+            ASSERT_EQ(feed.size(), applied);
+            // A busy equity symbol peaks at a few hundred thousand messages per second
+            ASSERT_TRUE(messagesPerSecond > 1000000.0);
+        });
+        
+        suite.addTest("Bar Aggregation Across Symbols", []() {
+            const std::size_t symbols = 2000;
+            std::vector<SymbolId> ids(symbols);
+            for (std::size_t s = 0; s < symbols; s++) {
+                ids[s] = internSymbol("BAR" + std::to_string(s));
+            }
+            std::vector<Tick> tape(2000000);
+            std::int64_t totalVolume = 0;
+            for (std::size_t i = 0; i < tape.size(); i++) {
+                const std::uint64_t h = (i + 1) * 0x9e3779b97f4a7c15ULL;
+                tape[i] = {34200LL * NANOS_PER_SECOND + static_cast<std::int64_t>(i) * 10000, ids[(h >> 32) % symbols],
+                           Price::fromRaw(1000000 + static_cast<std::int64_t>((h >> 12) % 10000)), 1 + static_cast<int>(h % 300)};
+                totalVolume += tape[i].volume;
+            }
+            
+            BarAggregator bars({BarSpec::seconds(1), BarSpec::minutes(1), BarSpec::ticks(50), BarSpec::volume(5000)}, 16);
+            std::int64_t minuteVolume = 0;
+            bars.subscribe([&minuteVolume](const Bar& bar, std::size_t series) {
+                if (series == 1) minuteVolume += bar.volume;
+            });
+            
+            std::uint64_t start = Clock::ticks();
+            for (const Tick& tick : tape) {
+                bars.onTick(tick);
+            }
+            double nanosPerTick = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / tape.size();
+            bars.closeElapsed(tape.back().timestamp + 60 * NANOS_PER_SECOND);
+            
+            std::cout << "🕯️ " << tape.size() << " ticks into 4 bar series x " << symbols << " symbols: "
+                      << nanosPerTick << "ns per tick, " << bars.completedBars() << " bars" << std::endl;
+            ASSERT_EQ(totalVolume, minuteVolume);  // every trade lands in exactly one minute bar
+            ASSERT_TRUE(nanosPerTick < 1000.0);
+        });
+        
+        suite.addTest("Time Range Queries", []() {
+            TickStore store;
+            store.reserve(1000000);
+            for (std::size_t i = 0; i < 1000000; i++) {
+                const std::uint64_t h = (i + 1) * 0x9e3779b97f4a7c15ULL;
+                store.append(34200LL * NANOS_PER_SECOND + static_cast<std::int64_t>(i) * 20000, static_cast<SymbolId>((h >> 32) % 8),
+                             Price::fromRaw(1000000 + static_cast<std::int64_t>((h >> 12) % 10000)), 1 + static_cast<int>(h % 300));
+            }
+            TickIndex index;
+            index.update(store);
+            
+            const std::int64_t span = store.timestampColumn().back() - store.timestampColumn().front();
+            std::int64_t totalVolume = 0;
+            double checksum = 0.0;
+            const int queries = 200000;
+            std::uint64_t start = Clock::ticks();
+            for (int q = 0; q < queries; q++) {
+                const std::uint64_t h = (q + 1) * 0xbf58476d1ce4e5b9ULL;
+                const std::int64_t from = store.timestampColumn().front() + static_cast<std::int64_t>((h >> 20) % span);
+                RangeStats stats = index.query(static_cast<SymbolId>(q % 8), from, from + 60 * NANOS_PER_SECOND);
+                totalVolume += stats.volume;
+                checksum += stats.vwap + stats.twap;
+            }
+            double nanosPerQuery = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / queries;
+            
+            std::cout << "🔎 " << queries << " VWAP/TWAP queries over " << store.size() << " ticks: "
+                      << nanosPerQuery << "ns per query" << std::endl;
+            ASSERT_EQ(index.volume(0, 0, INT64_MAX), index.volume(0, 0, span / 2 + 34200LL * NANOS_PER_SECOND) +
+                                                     index.volume(0, span / 2 + 34200LL * NANOS_PER_SECOND, INT64_MAX));
+            ASSERT_TRUE(totalVolume > 0 && checksum > 0.0);
+            ASSERT_TRUE(nanosPerQuery < 2000.0);
+        });
+        
+        suite.addTest("ITCH Decode Throughput", []() {
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_itch_decode.itch").string();
+            ASSERT_TRUE(generateItchFile(path, 2000000));
+            MappedFile file(path);
+            
+            itch::Handler noop;
+            std::uint64_t start = Clock::ticks();
+            itch::DecodeResult result = itch::decode(file.data(), file.end(), noop);
+            double decodeSeconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / NANOS_PER_SECOND;
+            
+            TickStore ticks;
+            ItchBookBuilder builder(ticks);
+            start = Clock::ticks();
+            itch::decode(file.data(), file.end(), builder);
+            double buildSeconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / NANOS_PER_SECOND;
+            
+            std::cout << "📡 ITCH " << result.messages << " msgs: decode " << result.messages / decodeSeconds / 1e6
+                      << "M msgs/s, into books " << result.messages / buildSeconds / 1e6 << "M msgs/s" << std::endl;
+            ASSERT_TRUE(result.complete);
+            ASSERT_EQ(0u, builder.rejectedEvents());
+            ASSERT_TRUE(result.messages / decodeSeconds > 10000000.0);
+            file.close();
+            std::filesystem::remove(path);
+        });
+        
         suite.runAll();
     }
     
@@ -70,23 +458,30 @@ private:
         TestSuite suite("Signal Generation Performance");
         
         suite.addTest("High-Frequency Signal Generation", []() {
-            std::vector<MarketData> data;
+            TickStore data;
             loadData(data);
+            ASSERT_FALSE(data.empty());
             
             MovingAvgStrat strategy(5, 20);
+            int buySignals = 0;
             
             auto start = std::chrono::high_resolution_clock::now();
             
-            // Generate signals at high frequency
+            // Generate signals at high frequency: one tick in, one signal out
             for (int i = 0; i < 10000; i++) {
-                strategy.generateSignal(data, "AAPL");
+                Tick tick = data.tick(i % data.size());
+                tick.price += Price::fromDouble((i % 50) * 0.01);
+                strategy.onTick(tick);
+                buySignals += (strategy.signal(tick.symbol) == 1);
+                strategy.clearIntents();
             }
             
             auto end = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
             
             std::cout << "🎯 Generated 10,000 signals in " << duration.count() << "μs" << std::endl;
-            std::cout << "📊 Average: " << (duration.count() / 10000.0) << "μs per signal" << std::endl;
+            std::cout << "📊 Average: " << (duration.count() / 10000.0) << "μs per signal ("
+                      << buySignals << " BUY)" << std::endl;
             
             // HFT requirement: signals should be generated very quickly
             double avgTime = duration.count() / 10000.0;
@@ -121,6 +516,128 @@ private:
             ASSERT_TRUE(avgTime < 10.0); // Less than 10μs per order
         });
         
+        suite.addTest("Order Manager Retire By ID", []() {
+            std::ostringstream sink;
+            AsyncLogger& logger = AsyncLogger::instance();
+            logger.setOutput(sink);
+            logger.setPolicy(LogOverflowPolicy::DROP);
+            OrderManager manager;
+            std::vector<OrderId> ids;
+            for (int i = 0; i < 200000; i++) {
+                ids.push_back(manager.placeOrder(static_cast<SymbolId>(i % 8), OrderType::BUY, 100, Price::fromDouble(150.0)));
+            }
+            logger.flush();
+            logger.setPolicy(LogOverflowPolicy::BLOCK);
+            logger.setOutput(std::cout);
+            
+            // Newest first: the worst case for the old front-to-back scan
+            auto start = std::chrono::high_resolution_clock::now();
+            for (auto it = ids.rbegin(); it != ids.rend(); ++it) {
+                manager.fillOrder(*it);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            double nanosPerOrder = std::chrono::duration<double, std::nano>(end - start).count() / ids.size();
+            
+            std::cout << "🗂️ Filled and archived " << ids.size() << " orders by ID: " << nanosPerOrder << "ns each" << std::endl;
+            ASSERT_EQ(0u, manager.liveCount());
+            ASSERT_EQ(ids.size(), manager.archivedOrders().size());
+            ASSERT_TRUE(nanosPerOrder < 2000.0);
+        });
+        
+        suite.addTest("Journaled Orders And Replay", []() {
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_journal_benchmark.bin").string();
+            std::filesystem::remove(path);
+            std::ostringstream sink;
+            AsyncLogger& logger = AsyncLogger::instance();
+            logger.setOutput(sink);
+            logger.setPolicy(LogOverflowPolicy::DROP);
+            
+            const int orders = 200000;
+            double nanosPerOrder = 0.0;
+            {
+                OrderJournal journal;
+                ASSERT_TRUE(journal.open(path, orders * 2));
+                OrderManager manager;
+                manager.attachJournal(&journal);
+                auto start = std::chrono::high_resolution_clock::now();
+                for (int i = 0; i < orders; i++) {
+                    manager.fillOrder(manager.placeOrder(static_cast<SymbolId>(i % 8), OrderType::BUY, 100,
+                                                         Price::fromDouble(150.0)));
+                }
+                auto end = std::chrono::high_resolution_clock::now();
+                nanosPerOrder = std::chrono::duration<double, std::nano>(end - start).count() / orders;
+            }
+            logger.flush();
+            logger.setPolicy(LogOverflowPolicy::BLOCK);
+            logger.setOutput(std::cout);
+            
+            OrderJournal journal;
+            ASSERT_TRUE(journal.open(path));
+            OrderManager manager;
+            RiskManager risk;
+            JournalReplayStats stats = journal.replay(manager, risk);
+            journal.close();
+            std::filesystem::remove(path);
+            
+            std::cout << "📒 Place + fill journaled: " << nanosPerOrder << "ns per order; replayed " << stats.records
+                      << " records in " << stats.nanos / 1e6 << "ms" << std::endl;
+            ASSERT_EQ(static_cast<std::size_t>(orders), manager.archivedOrders().size());
+            ASSERT_EQ(0u, stats.rejected);
+            ASSERT_TRUE(stats.nanos < 1000000000);
+        });
+        
+        suite.addTest("Order ID Allocation Across Threads", []() {
+            const int threads = 4;
+            const std::size_t perThread = 1000000;
+            std::vector<std::vector<OrderId>> issued(threads, std::vector<OrderId>(perThread));
+            std::vector<std::thread> workers;
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back([&issued, t, perThread]() {
+                    for (std::size_t i = 0; i < perThread; i++) issued[t][i] = nextOrderId();
+                });
+            }
+            for (auto& worker : workers) worker.join();
+            auto end = std::chrono::high_resolution_clock::now();
+            double nanosPerId = std::chrono::duration<double, std::nano>(end - start).count() / (threads * perThread);
+            
+            std::vector<OrderId> all;
+            all.reserve(threads * perThread);
+            for (const auto& ids : issued) all.insert(all.end(), ids.begin(), ids.end());
+            std::sort(all.begin(), all.end());
+            
+            std::cout << "🔢 " << all.size() << " order IDs from " << threads << " threads: " << nanosPerId << "ns each" << std::endl;
+            ASSERT_TRUE(std::adjacent_find(all.begin(), all.end()) == all.end());
+            ASSERT_TRUE(all.front() != INVALID_ORDER_ID);
+            ASSERT_TRUE(nanosPerId < 100.0);
+        });
+        
+        suite.addTest("Timestamp Cost", []() {
+            const int reads = 1000000;
+            std::int64_t sink = 0;
+            std::uint64_t start = Clock::ticks();
+            for (int i = 0; i < reads; i++) {
+                sink += Clock::now();
+            }
+            double clockNs = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / reads;
+            
+            // The per-order string timestamp this replaced
+            const int stringReads = 100000;
+            std::size_t chars = 0;
+            start = Clock::ticks();
+            for (int i = 0; i < stringReads; i++) {
+                time_t now = time(0);
+                std::string text = ctime(&now);
+                chars += text.size();
+            }
+            double ctimeNs = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / stringReads;
+            
+            std::cout << "⏱️  Clock::now(): " << clockNs << "ns (" << (Clock::usingTsc() ? "TSC" : "clock_gettime")
+                      << "), time()+ctime(): " << ctimeNs << "ns" << std::endl;
+            ASSERT_TRUE(sink != 0 && chars > 0);
+            ASSERT_TRUE(clockNs < ctimeNs);
+        });
+        
         suite.runAll();
     }
     
@@ -136,8 +653,8 @@ private:
             
             for (int i = 0; i < 100000; i++) {
                 MarketData data;
-                data.Abb = "MEM";
-                data.price = 100.0 + i;
+                data.Abb = internSymbol("MEM");
+                data.price = Price::fromDouble(100.0 + i);
                 data.volume = 1000;
                 largeDataset.push_back(data);
                 
@@ -156,4 +673,72 @@ private:
         
         suite.runAll();
     }
+    
+    static void benchmarkLogging() {
+        TestSuite suite("Logging Performance");
+        
+        suite.addTest("Async Logger Hot Path", []() {
+            std::ostringstream sink;
+            AsyncLogger& logger = AsyncLogger::instance();
+            logger.setOutput(sink);
+            logger.setPolicy(LogOverflowPolicy::DROP);
+            std::uint64_t droppedBefore = logger.droppedCount();
+            
+            const int records = 100000;
+            std::string symbol = "AAPL";
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < records; i++) {
+                logger.log("📝 Order placed: SIM_{} | buy {} {} @ ${}", i, 100, symbol, 150.25);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            
+            logger.flush();
+            logger.setPolicy(LogOverflowPolicy::BLOCK);
+            logger.setOutput(std::cout);
+            
+            double asyncNs = std::chrono::duration<double, std::nano>(end - start).count() / records;
+            
+            // Same line formatted synchronously with iostream + endl
+            std::ostringstream syncSink;
+            start = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < records; i++) {
+                syncSink << "📝 Order placed: SIM_" << i << " | buy " << 100 << " " << symbol
+                         << " @ $" << 150.25 << std::endl;
+            }
+            end = std::chrono::high_resolution_clock::now();
+            double syncNs = std::chrono::duration<double, std::nano>(end - start).count() / records;
+            
+            std::uint64_t dropped = logger.droppedCount() - droppedBefore;
+            std::cout << "📝 Async log call: " << asyncNs << "ns (" << dropped << " dropped), "
+                      << "iostream: " << syncNs << "ns" << std::endl;
+            ASSERT_TRUE(asyncNs < 1000.0);
+        });
+        
+        
+        suite.addTest("Trace Record Submit", []() {
+            LatencyTracer& tracer = LatencyTracer::instance();
+            tracer.reset();
+            
+            const int records = 1000000;
+            std::uint64_t start = Clock::ticks();
+            for (int i = 0; i < records; i++) {
+                TraceRecord trace;
+                trace.stamp(TraceStage::FEED_RECEIVE);
+                trace.stamp(TraceStage::STRATEGY_DECISION);
+                tracer.submit(trace);
+                if ((i & 1023) == 1023) tracer.collect();
+            }
+            double perRecord = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / records;
+            tracer.collect();
+            std::uint64_t dropped = tracer.droppedCount();
+            tracer.reset();
+            
+            std::cout << "⏱️ Stamp + submit + collect: " << perRecord << "ns per record (" << dropped
+                      << " dropped)" << std::endl;
+            ASSERT_EQ(0u, dropped);
+            ASSERT_TRUE(perRecord < 1000.0);
+        });
+        
+        suite.runAll();
+    }
 };
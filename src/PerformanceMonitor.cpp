@@ -1,9 +1,27 @@
 #include "PerformanceMonitor.h"
+#include "AsyncLogger.h"
+#include "Clock.h"
 #include "MarketData.h"
 #include "Strategy.h"
 #include "Order.h"
 #include "LockFreeQueue.h"
 #include "MemoryPool.h"
+#include "TickLoader.h"
+#include "TickStore.h"
+#include "BinaryTickFile.h"
+#include "TickArchive.h"
+#include "ThreadPool.h"
+#include "IndicatorKernels.h"
+#include "OrderBook.h"
+#include "L3OrderBook.h"
+#include "ItchFeed.h"
+#include "MappedFile.h"
+#include "ReplayEngine.h"
+#include "BarAggregator.h"
+#include "TickIndex.h"
+#include "TradingPipeline.h"
+#include "OrderJournal.h"
+#include <algorithm>
 #include <vector>
 #include <thread>
 #include <chrono>
@@ -11,11 +29,15 @@
 #include <unistd.h>
 #include <iostream>
 #include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <sstream>
 
 PerformanceTimer::PerformanceTimer(const std::string& operation) 
     : operationName(operation) {
-    startTime = std::chrono::high_resolution_clock::now();
-    std::cout << "⏱️  Starting: " << operationName << "..." << std::endl;
+    logAsync("⏱️  Starting: {}...", operationName);
+    startTicks = Clock::ticks();
 }
 
 PerformanceTimer::~PerformanceTimer() {
@@ -23,12 +45,10 @@ PerformanceTimer::~PerformanceTimer() {
 }
 
 void PerformanceTimer::stop() {
-    auto endTime = std::chrono::high_resolution_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
+    std::int64_t nanos = Clock::ticksToNanos(Clock::ticks() - startTicks);
     
-    std::cout << "✅ " << operationName << " completed in: " 
-              << duration.count() << " nanoseconds (" 
-              << duration.count() / 1000.0 << " microseconds)" << std::endl;
+    logAsync("✅ {} completed in: {} nanoseconds ({} microseconds)",
+             operationName, nanos, nanos / 1000.0);
 }
 
 void PerformanceMonitor::measureDataLoad() {
@@ -45,8 +65,10 @@ void PerformanceMonitor::measureDataLoad() {
 void PerformanceMonitor::measureSignalGeneration() {
     PerformanceTimer timer("Multi-threaded Signal Generation");
     
-    std::vector<MarketData> testData;
+    TickStore testData;
     loadData(testData);
+    if (testData.empty()) return;
+    const SymbolId aapl = testData.findSymbol("AAPL");
     
     const int num_threads = std::thread::hardware_concurrency();
     std::vector<std::thread> threads;
@@ -54,11 +76,11 @@ void PerformanceMonitor::measureSignalGeneration() {
     LockFreeQueue<int> signal_queue;
     
     for (int i = 0; i < num_threads; ++i) {
-        threads.emplace_back([&testData, &signal_queue]() {
+        threads.emplace_back([&testData, &signal_queue, aapl]() {
             MovingAvgStrat strategy(2, 3);
             for (int j = 0; j < 250; j++) {
-                int signal = strategy.generateSignal(testData, "AAPL");
-                signal_queue.enqueue(signal);
+                strategy.onTick(testData.tick(j % testData.size()));
+                signal_queue.enqueue(strategy.signal(aapl));
             }
         });
     }
@@ -71,32 +93,276 @@ void PerformanceMonitor::measureSignalGeneration() {
 }
 
 void PerformanceMonitor::measureOrderPlacement() {
-    PerformanceTimer timer("Memory Pool Order Processing");
+    PerformanceTimer timer("Pooled Order Processing");
     
-    MemoryPool<Order> order_pool;
-    std::vector<Order*> orders;
-    orders.reserve(1000);
+    // Placement lines go to a sink; only the order path itself is of interest here
+    std::ostringstream sink;
+    AsyncLogger::instance().setOutput(sink);
     
+    OrderManager manager;
+    const SymbolId aapl = knownSymbol("AAPL");
     for (int i = 0; i < 1000; i++) {
-        Order* order = order_pool.template allocate<Order>("AAPL", OrderType::BUY, 100, 150.0 + i * 0.01);
-        orders.push_back(order);
+        manager.fillOrder(manager.placeOrder(aapl, OrderType::BUY, 100, Price::fromDouble(150.0 + i * 0.01)));
+    }
+    AsyncLogger::instance().setOutput(std::cout);
+    
+    std::cout << "📝 Placed and filled 1000 " << sizeof(Order) << "-byte orders from the order pool" << std::endl;
+}
+
+void PerformanceMonitor::traceTickToTrade(std::size_t ticks, const std::string& dumpPath) {
+    std::cout << "\n⏱️ Tracing tick-to-trade over " << ticks << " synthetic ticks, replayed 5µs apart..." << std::endl;
+    
+    // Random walk on a one-cent grid for a handful of symbols
+    const SymbolId symbols[] = {internSymbol("TRC0"), internSymbol("TRC1"), internSymbol("TRC2"), internSymbol("TRC3")};
+    std::int64_t cents[] = {2000, 2500, 3000, 3500};
+    TickStore tape;
+    tape.reserve(ticks);
+    const std::int64_t open = 34200LL * NANOS_PER_SECOND;
+    std::uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    for (std::size_t i = 0; i < ticks; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        const std::size_t s = seed % 4;
+        cents[s] = std::max<std::int64_t>(100, cents[s] + static_cast<std::int64_t>((seed >> 8) % 5) - 2);
+        tape.append(open + static_cast<std::int64_t>(i) * 5000, symbols[s],
+                    Price::fromRaw(cents[s] * (Price::SCALE / 100)), 100);
+    }
+    
+    // Order lines go to a sink so the terminal does not set the pace
+    std::ostringstream sink;
+    AsyncLogger& logger = AsyncLogger::instance();
+    logger.setOutput(sink);
+    logger.setPolicy(LogOverflowPolicy::DROP);
+    
+    SimulatedExchange venue;
+    ExchangeCredentials creds;
+    creds.apiKey = "trace";
+    venue.authenticate(creds);
+    venue.setCash(Price::fromRaw(1000000000000LL * Price::SCALE));
+    for (SymbolId symbol : symbols) {
+        venue.setShares(symbolName(symbol), 1000000000);
+    }
+    RiskManager risk(1e6, 1e12);
+    OrderManager orders;
+    MovingAvgStrat strategy(3, 8, 10);
+    LatencyTracer& tracer = LatencyTracer::instance();
+    tracer.reset();
+    TradingPipeline pipeline(strategy, risk, orders, venue, tracer);
+    
+    // The feed is the replay engine at the recorded pace, so every tick is
+    // stamped as it comes off the schedule, the way a live feed delivers it
+    ReplayEngine engine(tape);
+    engine.subscribeTicks([&pipeline](const Tick& tick) { pipeline.onTick(tick); });
+    std::size_t delivered = 0;
+    engine.subscribeTicks([&](const Tick&) {
+        // Drain between ticks, well before a ring can fill
+        if ((++delivered & 1023) == 0) tracer.collect();
+    });
+    ReplayOptions options;
+    options.pacing = ReplayPacing::ORIGINAL;
+    engine.start(options);
+    const ReplayStats replayed = engine.join();
+    tracer.collect();
+    logger.flush();
+    logger.setPolicy(LogOverflowPolicy::BLOCK);
+    logger.setOutput(std::cout);
+    
+    const PipelineStats& stats = pipeline.stats();
+    std::cout << "  " << stats.intents << " intents: " << stats.filled << " filled, " << stats.riskRejects
+              << " risk rejects, " << stats.venueRejects << " venue rejects" << std::endl;
+    std::cout << "  Feed: " << replayed.events << " ticks in " << replayed.seconds << "s, jitter p50 "
+              << replayed.jitterP50 << "ns, p99 " << replayed.jitterP99 << "ns, max " << replayed.jitterMax << "ns"
+              << std::endl;
+    tracer.report(std::cout);
+    
+    std::ofstream dump(dumpPath);
+    if (dump) {
+        tracer.dump(dump);
+        std::cout << "  📄 Machine-readable dump written to " << dumpPath << std::endl;
+    } else {
+        std::cout << "  ❌ Could not write " << dumpPath << std::endl;
+    }
+}
+
+void PerformanceMonitor::measureOrderManager(std::size_t orders) {
+    std::cout << "\n🗂️ === Order Manager (" << orders << " orders) ===" << std::endl;
+    
+    // Placement lines go to a sink so the terminal does not set the pace
+    std::ostringstream sink;
+    AsyncLogger& logger = AsyncLogger::instance();
+    logger.setOutput(sink);
+    logger.setPolicy(LogOverflowPolicy::DROP);
+    
+    OrderManager manager;
+    std::vector<OrderId> ids(orders);
+    std::uint64_t start = Clock::ticks();
+    for (std::size_t i = 0; i < orders; i++) {
+        ids[i] = manager.placeOrder(static_cast<SymbolId>(i % 8), (i & 1) ? OrderType::SELL : OrderType::BUY, 100,
+                                    Price::fromRaw(1000000 + static_cast<std::int64_t>(i % 1000)));
     }
+    double placeNanos = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / orders;
+    logger.flush();
+    logger.setPolicy(LogOverflowPolicy::BLOCK);
+    logger.setOutput(std::cout);
+    
+    // Retire in a scattered order so every lookup lands somewhere new
+    std::uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    for (std::size_t i = orders - 1; i > 0; i--) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        std::swap(ids[i], ids[seed % (i + 1)]);
+    }
+    start = Clock::ticks();
+    for (OrderId id : ids) {
+        manager.fillOrder(id);
+    }
+    double retireNanos = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / orders;
+    
+    std::size_t found = 0;
+    start = Clock::ticks();
+    for (OrderId id : ids) {
+        found += manager.findOrder(id) != nullptr;
+    }
+    double lookupNanos = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / orders;
+    
+    // Baseline: the old linear search over a vector of every order ever placed,
+    // for the orders retired last
+    const std::size_t scans = std::min<std::size_t>(orders, 2000);
+    const std::vector<Order>& flat = manager.archivedOrders();
+    std::size_t scanned = 0;
+    start = Clock::ticks();
+    for (std::size_t i = 0; i < scans; i++) {
+        for (const Order& order : flat) {
+            if (order.orderId == ids[orders - 1 - i]) {
+                scanned++;
+                break;
+            }
+        }
+    }
+    double scanNanos = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / scans;
+    
+    std::cout << "  Place: " << placeNanos << "ns per order, fill + archive: " << retireNanos << "ns per order" << std::endl;
+    std::cout << "  Lookup by ID: " << lookupNanos << "ns indexed vs " << scanNanos / 1000.0 << "μs linear scan ("
+              << found + scanned << " found), " << manager.liveCount() << " live, " << manager.archivedOrders().size()
+              << " archived" << std::endl;
+}
+
+void PerformanceMonitor::measureOrderIds(std::size_t idsPerThread) {
+    const int threads = std::max(2, std::min(4, static_cast<int>(std::thread::hardware_concurrency())));
+    std::cout << "\n🔢 === Order ID Allocation (" << threads << " threads x " << idsPerThread << " IDs) ===" << std::endl;
+    
+    // Wall time for every thread to draw its IDs from the given source
+    auto timeThreads = [threads, idsPerThread](auto&& draw) {
+        std::atomic<std::uint64_t> checksum{0};
+        std::vector<std::thread> workers;
+        std::uint64_t start = Clock::ticks();
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&]() {
+                std::uint64_t sum = 0;
+                for (std::size_t i = 0; i < idsPerThread; i++) sum += draw();
+                checksum.fetch_add(sum, std::memory_order_relaxed);
+            });
+        }
+        for (auto& worker : workers) worker.join();
+        return static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / (static_cast<double>(idsPerThread) * threads);
+    };
+    
+    double blockNanos = timeThreads([]() { return nextOrderId(); });
+    
+    // Baseline: every ID is a fetch_add on one shared counter
+    std::atomic<std::uint64_t> shared{1};
+    double sharedNanos = timeThreads([&shared]() { return shared.fetch_add(1, std::memory_order_relaxed); });
+    
+    std::cout << "  Block-reserved: " << blockNanos << "ns per ID, shared counter: " << sharedNanos
+              << "ns per ID (" << sharedNanos / blockNanos << "x), one atomic per "
+              << OrderIdAllocator::BLOCK_SIZE << " IDs" << std::endl;
+}
+
+void PerformanceMonitor::measureOrderJournal(std::size_t orders) {
+    std::cout << "\n📒 === Order Journal (" << orders << " orders) ===" << std::endl;
+    const std::string path = (std::filesystem::temp_directory_path() / "hft_journal_bench.bin").string();
+    std::filesystem::remove(path);
+    
+    // Placement lines go to a sink so the terminal does not set the pace
+    std::ostringstream sink;
+    AsyncLogger& logger = AsyncLogger::instance();
+    logger.setOutput(sink);
+    logger.setPolicy(LogOverflowPolicy::DROP);
     
-    for (Order* order : orders) {
-        order_pool.deallocate(order);
+    // A session: every order is placed, filled and booked as a position
+    auto session = [orders](OrderManager& manager, RiskManager& risk) {
+        std::uint64_t start = Clock::ticks();
+        for (std::size_t i = 0; i < orders; i++) {
+            const SymbolId symbol = static_cast<SymbolId>(i % 8);
+            const OrderType type = (i & 1) ? OrderType::SELL : OrderType::BUY;
+            const Price price = Price::fromRaw(1000000 + static_cast<std::int64_t>(i % 1000));
+            const OrderId id = manager.placeOrder(symbol, type, 100, price);
+            manager.fillOrder(id);
+            Order fill(id, symbol, type, 100, price);
+            fill.status = OrderStatus::FILLED;
+            risk.updatePosition(fill);
+        }
+        return static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / orders;
+    };
+    
+    double plainNanos = 0.0;
+    {
+        OrderManager manager;
+        RiskManager risk;
+        plainNanos = session(manager, risk);
     }
+    double journaledNanos = 0.0;
+    std::uint64_t records = 0;
+    std::uint64_t dropped = 0;
+    {
+        // Default size, so the flusher has to keep growing the file ahead of the session
+        OrderJournal journal;
+        if (!journal.open(path)) {
+            std::cout << "❌ Could not open " << path << std::endl;
+            logger.setPolicy(LogOverflowPolicy::BLOCK);
+            logger.setOutput(std::cout);
+            return;
+        }
+        OrderManager manager;
+        RiskManager risk;
+        manager.attachJournal(&journal);
+        risk.attachJournal(&journal);
+        journaledNanos = session(manager, risk);
+        records = journal.recordCount();
+        dropped = journal.droppedCount();
+        std::uint64_t start = Clock::ticks();
+        journal.sync();
+        std::cout << "  Final sync: " << Clock::ticksToNanos(Clock::ticks() - start) / 1000 << "us" << std::endl;
+    }
+    logger.flush();
+    logger.setPolicy(LogOverflowPolicy::BLOCK);
+    logger.setOutput(std::cout);
+    
+    std::cout << "  Session: " << journaledNanos << "ns per order journaled, " << plainNanos << "ns without ("
+              << records << " records, " << (journaledNanos - plainNanos) * orders / records << "ns per record, "
+              << dropped << " dropped)" << std::endl;
     
-    std::cout << "📝 Created and destroyed 1000 orders using memory pool" << std::endl;
+    // Recovery as at startup: open finds the tail, replay rebuilds the managers
+    std::uint64_t start = Clock::ticks();
+    OrderJournal journal;
+    journal.open(path);
+    double openMillis = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / 1e6;
+    OrderManager manager;
+    RiskManager risk;
+    JournalReplayStats stats = journal.replay(manager, risk);
+    std::cout << "  Recovery: open " << openMillis << "ms, replay " << stats.nanos / 1e6 << "ms for " << stats.records
+              << " records (" << static_cast<double>(stats.nanos) / stats.records << "ns per record, "
+              << manager.archivedOrders().size() << " orders, " << stats.rejected << " rejected)" << std::endl;
+    journal.close();
+    std::filesystem::remove(path);
 }
 
 void PerformanceMonitor::measureCPUAffinity() {
     PerformanceTimer timer("CPU Affinity Optimization");
     
-    cpu_set_t cpuset;
-    CPU_ZERO(&cpuset);
-    CPU_SET(0, &cpuset);
-    
-    if (sched_setaffinity(0, sizeof(cpu_set_t), &cpuset) == 0) {
+    if (pinCurrentThread(0)) {
         std::cout << "🎯 CPU affinity set to core 0 for deterministic performance" << std::endl;
         
         volatile int result = 0;
@@ -121,13 +387,11 @@ void PerformanceMonitor::measureCacheOptimization() {
         prices.push_back(100.0 + (i % 100) * 0.1);
     }
     
-    double sum = 0.0;
-    for (double price : prices) {
-        sum += price;
-    }
-    
-    double average = sum / size;
-    std::cout << "📈 Processed " << size << " prices with cache-optimized access" << std::endl;
+    // One contiguous column summed with the widest kernel the CPU supports
+    const IndicatorKernels& kernels = indicatorKernels();
+    double average = kernels.sum(prices.data(), prices.size()) / size;
+    std::cout << "📈 Processed " << size << " contiguous prices with " << simdLevelName(kernels.level)
+              << " kernels" << std::endl;
     std::cout << "💰 Average price: $" << average << std::endl;
 }
 
@@ -179,3 +443,522 @@ void PerformanceMonitor::verifyMultiThreading() {
         std::cout << "⚠️  Potential race condition or scheduling issue!" << std::endl;
     }
 }
+
+void PerformanceMonitor::measureTickLoader(std::size_t rows) {
+    std::cout << "\n📂 === CSV Tick Loader Benchmark (" << rows << " rows) ===" << std::endl;
+    
+    const std::string path = (std::filesystem::temp_directory_path() / "hft_tick_loader_bench.csv").string();
+    if (!generateTickCsv(path, rows)) {
+        std::cout << "⚠️  Could not write benchmark file " << path << std::endl;
+        return;
+    }
+    const double megabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0);
+    std::cout << "📄 Generated " << megabytes << " MB at " << path << std::endl;
+    
+    auto timeLoader = [&path](bool (*loader)(std::vector<MarketData>&, const std::string&),
+                              std::size_t& loaded) {
+        std::vector<MarketData> data;
+        auto start = std::chrono::high_resolution_clock::now();
+        loader(data, path);
+        auto end = std::chrono::high_resolution_clock::now();
+        loaded = data.size();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+    
+    std::size_t streamRows = 0;
+    std::size_t mappedRows = 0;
+    double streamMs = timeLoader(loadDataStream, streamRows);
+    double mappedMs = timeLoader(loadData, mappedRows);
+    
+    std::cout << "🐢 ifstream/stringstream loadData: " << streamRows << " rows in " << streamMs << " ms ("
+              << megabytes / (streamMs / 1000.0) << " MB/s)" << std::endl;
+    std::cout << "🚀 mmap + from_chars loader:       " << mappedRows << " rows in " << mappedMs << " ms ("
+              << megabytes / (mappedMs / 1000.0) << " MB/s)" << std::endl;
+    std::cout << "⚡ Speedup: " << streamMs / mappedMs << "x" << std::endl;
+    
+    std::filesystem::remove(path);
+}
+
+void PerformanceMonitor::measureBinaryTickLoad(std::size_t rows) {
+    std::cout << "\n💾 === CSV vs Binary Tick Load (" << rows << " rows) ===" << std::endl;
+    
+    const auto tempDir = std::filesystem::temp_directory_path();
+    const std::string csvPath = (tempDir / "hft_binary_bench.csv").string();
+    const std::string binaryPath = (tempDir / "hft_binary_bench.ticks").string();
+    if (!generateTickCsv(csvPath, rows) || !convertCsvToBinary(csvPath, binaryPath)) {
+        std::cout << "⚠️  Could not write benchmark files in " << tempDir << std::endl;
+        return;
+    }
+    std::cout << "📄 CSV: " << std::filesystem::file_size(csvPath) / (1024.0 * 1024.0) << " MB, binary: "
+              << std::filesystem::file_size(binaryPath) / (1024.0 * 1024.0) << " MB" << std::endl;
+    
+    auto timeLoad = [](const std::string& path, std::size_t& loaded) {
+        TickStore store;
+        auto start = std::chrono::high_resolution_clock::now();
+        loadData(store, path);
+        auto end = std::chrono::high_resolution_clock::now();
+        loaded = store.size();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+    
+    std::size_t csvRows = 0;
+    std::size_t binaryRows = 0;
+    double csvMs = timeLoad(csvPath, csvRows);
+    double binaryMs = timeLoad(binaryPath, binaryRows);
+    
+    std::cout << "📝 CSV (mmap + from_chars): " << csvRows << " rows in " << csvMs << " ms" << std::endl;
+    std::cout << "💾 Binary (no parsing):     " << binaryRows << " rows in " << binaryMs << " ms" << std::endl;
+    std::cout << "⚡ Speedup: " << csvMs / binaryMs << "x" << std::endl;
+    
+    std::filesystem::remove(csvPath);
+    std::filesystem::remove(binaryPath);
+}
+
+void PerformanceMonitor::measureTickArchive(std::size_t rows) {
+    std::cout << "\n🗜️ === Compressed Tick Archive (" << rows << " rows) ===" << std::endl;
+    
+    const auto tempDir = std::filesystem::temp_directory_path();
+    const std::string csvPath = (tempDir / "hft_archive_bench.csv").string();
+    const std::string binaryPath = (tempDir / "hft_archive_bench.ticks").string();
+    const std::string archivePath = (tempDir / "hft_archive_bench.tarc").string();
+    TickStore store;
+    if (!generateTickCsv(csvPath, rows) || !loadData(store, csvPath) || !writeBinaryTicks(binaryPath, store)) {
+        std::cout << "⚠️  Could not write benchmark files in " << tempDir << std::endl;
+        return;
+    }
+    
+    std::uint64_t start = Clock::ticks();
+    bool written = writeTickArchive(archivePath, store);
+    double encodeSeconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / NANOS_PER_SECOND;
+    TickArchive archive;
+    if (!written || !archive.open(archivePath)) {
+        std::cout << "⚠️  Could not write " << archivePath << std::endl;
+        return;
+    }
+    
+    const double mb = 1024.0 * 1024.0;
+    const double columnBytes = static_cast<double>(rows) * (sizeof(std::int64_t) + sizeof(SymbolId) + sizeof(Price) + sizeof(int));
+    const double archiveBytes = static_cast<double>(archive.compressedBytes());
+    std::cout << "  CSV " << std::filesystem::file_size(csvPath) / mb << " MB | MarketData rows "
+              << rows * sizeof(MarketData) / mb << " MB | columns " << columnBytes / mb << " MB | binary file "
+              << std::filesystem::file_size(binaryPath) / mb << " MB" << std::endl;
+    std::cout << "  Archive " << archiveBytes / mb << " MB in " << archive.index().size() << " blocks: "
+              << columnBytes / archiveBytes << "x smaller than the columns, "
+              << std::filesystem::file_size(binaryPath) / archiveBytes << "x smaller than the binary file ("
+              << encodeSeconds * 1000.0 << " ms to encode)" << std::endl;
+    
+    // Full decode into a fresh store, best of three to keep page faults out
+    double best = 1e30;
+    for (int run = 0; run < 3; run++) {
+        TickStore decoded;
+        start = Clock::ticks();
+        archive.load(decoded);
+        best = std::min(best, static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / NANOS_PER_SECOND);
+    }
+    std::cout << "  Decode: " << best * 1000.0 << " ms, " << columnBytes / best / 1e9 << " GB/s of columns out, "
+              << archiveBytes / best / 1e9 << " GB/s compressed in" << std::endl;
+    
+    // One minute from the middle of the session touches one or two blocks
+    const std::int64_t from = store.timestampColumn()[rows / 2];
+    TickStore minute;
+    start = Clock::ticks();
+    archive.loadRange(from, from + 60 * NANOS_PER_SECOND, minute);
+    std::cout << "  Range seek (1 minute, " << minute.size() << " rows): "
+              << Clock::ticksToNanos(Clock::ticks() - start) / 1000 << " µs" << std::endl;
+    
+    archive.close();
+    std::filesystem::remove(csvPath);
+    std::filesystem::remove(binaryPath);
+    std::filesystem::remove(archivePath);
+}
+
+void PerformanceMonitor::measureParallelTickLoad(std::size_t rows) {
+    std::cout << "\n🧵 === Parallel CSV Tick Load Scaling (" << rows << " rows) ===" << std::endl;
+    
+    const std::string path = (std::filesystem::temp_directory_path() / "hft_parallel_bench.csv").string();
+    if (!generateTickCsv(path, rows)) {
+        std::cout << "⚠️  Could not write benchmark file " << path << std::endl;
+        return;
+    }
+    const double gigabytes = std::filesystem::file_size(path) / (1024.0 * 1024.0 * 1024.0);
+    std::cout << "📄 Generated " << gigabytes << " GB at " << path << std::endl;
+    
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    double singleSeconds = 0.0;
+    for (unsigned threads = 1; threads <= maxThreads; threads++) {
+        ThreadPool pool(threads);
+        TickStore store;
+        std::uint64_t start = Clock::ticks();
+        loadTicksParallel(path, store, pool);
+        double seconds = Clock::ticksToNanos(Clock::ticks() - start) / 1e9;
+        if (threads == 1) singleSeconds = seconds;
+        
+        std::cout << "🧵 " << threads << " thread(s): " << store.size() << " rows in " << seconds * 1000.0
+                  << " ms, " << gigabytes / seconds << " GB/s (" << singleSeconds / seconds << "x)" << std::endl;
+    }
+    
+    std::filesystem::remove(path);
+}
+
+void PerformanceMonitor::measureIndicatorKernels(std::size_t count) {
+    std::cout << "\n🧮 === SIMD Indicator Kernels (" << count << " prices) ===" << std::endl;
+    std::cout << "CPU supports up to: " << simdLevelName(bestSimdLevel()) << std::endl;
+    
+    // Random-walk price column in both representations, plus volumes
+    std::vector<Price> fixed(count);
+    std::vector<double> prices(count);
+    std::vector<int> volumes(count);
+    std::int64_t raw = 1500000;
+    unsigned seed = 42;
+    for (std::size_t i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        raw += static_cast<int>((seed >> 16) % 201) - 100;
+        fixed[i] = Price::fromRaw(raw);
+        prices[i] = fixed[i].toDouble();
+        volumes[i] = 100 + static_cast<int>((seed >> 8) % 900);
+    }
+    std::vector<double> out(count);
+    const std::int64_t* rawColumn = rawPrices(fixed.data());
+    
+    struct KernelRun {
+        const char* name;
+        std::function<double(const IndicatorKernels&)> run;
+    };
+    const std::vector<KernelRun> runs = {
+        {"sum (double)", [&](const IndicatorKernels& k) { return k.sum(prices.data(), count); }},
+        {"sum (fixed)", [&](const IndicatorKernels& k) { return static_cast<double>(k.sumFixed(rawColumn, count)); }},
+        {"min/max", [&](const IndicatorKernels& k) { double lo, hi; k.minMax(prices.data(), count, lo, hi); return hi - lo; }},
+        {"VWAP (double)", [&](const IndicatorKernels& k) { return k.vwap(prices.data(), volumes.data(), count); }},
+        {"VWAP (fixed)", [&](const IndicatorKernels& k) { return k.vwapFixed(rawColumn, volumes.data(), count); }},
+        {"returns", [&](const IndicatorKernels& k) { k.returns(prices.data(), count, out.data()); return out[count / 2]; }},
+        {"SMA(20) series", [&](const IndicatorKernels& k) { k.rollingMean(prices.data(), count, 20, out.data()); return out[count - 1]; }},
+        {"stddev(20) series", [&](const IndicatorKernels& k) { k.rollingStddev(prices.data(), count, 20, out.data()); return out[count - 1]; }},
+        {"EMA series", [&](const IndicatorKernels& k) { k.ema(prices.data(), count, 2.0 / 21.0, out.data()); return out[count - 1]; }},
+        {"fixed -> double", [&](const IndicatorKernels& k) { k.toDouble(rawColumn, count, out.data()); return out[count - 1]; }},
+    };
+    
+    const SimdLevel levels[] = {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512};
+    for (const KernelRun& kernel : runs) {
+        double scalarNs = 0.0;
+        std::cout << "  " << kernel.name << ":";
+        for (SimdLevel level : levels) {
+            if (!simdLevelSupported(level)) continue;
+            const IndicatorKernels& kernels = indicatorKernels(level);
+            volatile double sink = kernel.run(kernels);  // warm-up
+            std::uint64_t start = Clock::ticks();
+            const int passes = 5;
+            for (int pass = 0; pass < passes; pass++) {
+                sink = kernel.run(kernels);
+            }
+            (void)sink;
+            double ns = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / passes / count;
+            if (level == SimdLevel::SCALAR) scalarNs = ns;
+            std::cout << "  " << simdLevelName(level) << " " << ns << "ns/elem";
+            if (level != SimdLevel::SCALAR) std::cout << " (" << scalarNs / ns << "x)";
+        }
+        std::cout << std::endl;
+    }
+}
+
+void PerformanceMonitor::measureOrderBook(std::size_t updates) {
+    std::cout << "\n📚 === L2 Order Book Updates (" << updates << ") ===" << std::endl;
+    
+    OrderBook book;
+    const Price tick = book.tickSize();
+    std::vector<std::uint32_t> latencyTicks(updates);
+    
+    // Random-walk mid; levels within 20 ticks of it, about a third are deletes.
+    // When the mid moves, the level it moved onto is deleted so the book never crosses.
+    std::int64_t midTicks = 15000;
+    unsigned seed = 7;
+    std::int64_t checksum = 0;
+    for (std::size_t i = 0; i < updates; i++) {
+        seed = seed * 1103515245u + 12345u;
+        BookSide side = ((seed >> 9) & 1) ? BookSide::BID : BookSide::ASK;
+        std::int64_t offset = 1 + static_cast<std::int64_t>((seed >> 10) % 20);
+        std::int64_t quantity = ((seed >> 16) % 3 == 0) ? 0 : 100 * static_cast<std::int64_t>(1 + (seed >> 18) % 50);
+        if ((seed >> 28) == 0) {
+            bool up = (seed >> 8) & 1;
+            midTicks += up ? 1 : -1;
+            side = up ? BookSide::ASK : BookSide::BID;
+            offset = 0;
+            quantity = 0;
+        }
+        Price price = tick * (side == BookSide::BID ? midTicks - offset : midTicks + offset);
+        
+        std::uint64_t start = Clock::ticks();
+        book.update(side, price, quantity);
+        checksum += book.bestBidQuantity();
+        latencyTicks[i] = static_cast<std::uint32_t>(Clock::ticks() - start);
+    }
+    
+    // Median of back-to-back timestamp reads: the part of each sample that is the timer
+    std::vector<std::uint64_t> timerTicks(100000);
+    for (std::uint64_t& sample : timerTicks) {
+        std::uint64_t start = Clock::ticks();
+        sample = Clock::ticks() - start;
+    }
+    std::nth_element(timerTicks.begin(), timerTicks.begin() + timerTicks.size() / 2, timerTicks.end());
+    std::int64_t overheadNs = Clock::ticksToNanos(timerTicks[timerTicks.size() / 2]);
+    
+    std::sort(latencyTicks.begin(), latencyTicks.end());
+    auto percentile = [&](double p) {
+        std::size_t index = std::min(latencyTicks.size() - 1, static_cast<std::size_t>(p * latencyTicks.size()));
+        return Clock::ticksToNanos(latencyTicks[index]);
+    };
+    
+    std::cout << "📈 p50: " << percentile(0.50) << "ns | p90: " << percentile(0.90) << "ns | p99: "
+              << percentile(0.99) << "ns | p99.9: " << percentile(0.999) << "ns | max: "
+              << Clock::ticksToNanos(latencyTicks.back()) << "ns" << std::endl;
+    std::cout << "⏱️  Timer overhead: ~" << overheadNs << "ns per sample (included above)" << std::endl;
+    std::cout << "📚 Final book: " << book.bestBid() << " x " << book.bestAsk() << ", "
+              << book.levelCount(BookSide::BID) << "/" << book.levelCount(BookSide::ASK) << " levels"
+              << " (checksum " << checksum << ")" << std::endl;
+}
+
+void PerformanceMonitor::measureL3Replay(std::size_t events) {
+    std::cout << "\n📖 === L3 Book Replay (" << events << " events) ===" << std::endl;
+    
+    std::vector<OrderBookEvent> feed;
+    synthesizeOrderFlow(events, feed);
+    
+    L3OrderBook book;
+    std::vector<std::uint32_t> latencyTicks(feed.size());
+    std::size_t rejected = 0;
+    
+    std::uint64_t replayStart = Clock::ticks();
+    for (std::size_t i = 0; i < feed.size(); i++) {
+        std::uint64_t start = Clock::ticks();
+        rejected += !book.apply(feed[i]);
+        latencyTicks[i] = static_cast<std::uint32_t>(Clock::ticks() - start);
+    }
+    double seconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - replayStart)) / NANOS_PER_SECOND;
+    
+    // Untimed pass for pure throughput
+    L3OrderBook untimed;
+    std::uint64_t throughputStart = Clock::ticks();
+    for (const OrderBookEvent& event : feed) {
+        untimed.apply(event);
+    }
+    double untimedSeconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - throughputStart)) / NANOS_PER_SECOND;
+    
+    std::sort(latencyTicks.begin(), latencyTicks.end());
+    auto percentile = [&](double p) {
+        std::size_t index = std::min(latencyTicks.size() - 1, static_cast<std::size_t>(p * latencyTicks.size()));
+        return Clock::ticksToNanos(latencyTicks[index]);
+    };
+    
+    std::cout << "⚡ " << feed.size() / untimedSeconds / 1e6 << "M msgs/s untimed, "
+              << feed.size() / seconds / 1e6 << "M msgs/s with per-event timing" << std::endl;
+    std::cout << "📈 p50: " << percentile(0.50) << "ns | p99: " << percentile(0.99) << "ns | p99.9: "
+              << percentile(0.999) << "ns | max: " << Clock::ticksToNanos(latencyTicks.back()) << "ns" << std::endl;
+    std::cout << "📖 " << book.orderCount() << " live orders, " << book.sharesExecuted() << " shares executed, "
+              << rejected << " rejected events | touch " << book.levels().bestBid() << " x "
+              << book.levels().bestAsk() << std::endl;
+}
+
+void PerformanceMonitor::measureItchDecode(std::size_t messages) {
+    std::cout << "\n📡 === ITCH Decode (" << messages << " messages) ===" << std::endl;
+    
+    const std::string path = (std::filesystem::temp_directory_path() / "hft_itch_bench.itch").string();
+    if (!generateItchFile(path, messages)) {
+        std::cout << "⚠️  Could not write benchmark file " << path << std::endl;
+        return;
+    }
+    MappedFile file(path);
+    const double megabytes = file.size() / (1024.0 * 1024.0);
+    std::cout << "📄 Generated " << megabytes << " MB at " << path << std::endl;
+    
+    // Decode only: every message dispatched to no-op handlers
+    itch::Handler noop;
+    std::uint64_t start = Clock::ticks();
+    itch::DecodeResult decoded = itch::decode(file.data(), file.end(), noop);
+    double decodeSeconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / NANOS_PER_SECOND;
+    
+    // Decode into L3 books and the tick store
+    TickStore ticks;
+    ItchBookBuilder builder(ticks);
+    start = Clock::ticks();
+    itch::decode(file.data(), file.end(), builder);
+    double buildSeconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / NANOS_PER_SECOND;
+    
+    std::cout << "⚡ Decode only: " << decoded.messages / decodeSeconds / 1e6 << "M msgs/s ("
+              << megabytes / 1024.0 / decodeSeconds << " GB/s)" << std::endl;
+    std::cout << "📖 Decode + L3 books + ticks: " << decoded.messages / buildSeconds / 1e6 << "M msgs/s, "
+              << ticks.size() << " trade ticks, " << builder.rejectedEvents() << " rejected" << std::endl;
+    
+    const L3OrderBook* aapl = builder.book("AAPL");
+    if (aapl != nullptr) {
+        std::cout << "📚 AAPL: " << aapl->orderCount() << " live orders, touch " << aapl->levels().bestBid()
+                  << " x " << aapl->levels().bestAsk() << std::endl;
+    }
+    file.close();
+    std::filesystem::remove(path);
+}
+
+void PerformanceMonitor::measureReplayJitter(std::size_t events) {
+    std::cout << "\n🎬 === Market Data Replay (" << events << " ticks, 20µs apart) ===" << std::endl;
+    
+    TickStore ticks;
+    ticks.reserve(events);
+    const std::int64_t open = 34200LL * NANOS_PER_SECOND;
+    for (std::size_t i = 0; i < events; i++) {
+        ticks.append(open + static_cast<std::int64_t>(i) * 20000, (i % 2) ? "AAPL" : "MSFT",
+                     Price::fromDouble(150.0 + (i % 100) * 0.01), 100);
+    }
+    
+    // main() pins the logger to the last core, so the replay thread takes the
+    // one before it; with fewer than 3 cores it stays unpinned
+    const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const int core = (cores >= 3) ? cores - 2 : -1;
+    MovingAvgStrat strategy(5, 20);
+    ReplayEngine engine(ticks);
+    engine.subscribe(strategy);
+    
+    struct Mode {
+        const char* name;
+        ReplayPacing pacing;
+        double speed;
+    };
+    const Mode modes[] = {
+        {"original timing", ReplayPacing::ORIGINAL, 1.0},
+        {"10x speed", ReplayPacing::SCALED, 10.0},
+        {"as fast as possible", ReplayPacing::AS_FAST_AS_POSSIBLE, 1.0},
+    };
+    for (const Mode& mode : modes) {
+        ReplayOptions options;
+        options.pacing = mode.pacing;
+        options.speed = mode.speed;
+        options.core = core;
+        engine.start(options);
+        ReplayStats stats = engine.join();
+        strategy.clearIntents();
+        
+        std::cout << "  " << mode.name << ": " << stats.seconds << "s, " << stats.eventsPerSecond() / 1e6
+                  << "M events/s" << (stats.pinned ? " (pinned to core " + std::to_string(core) + ")" : "");
+        if (mode.pacing != ReplayPacing::AS_FAST_AS_POSSIBLE) {
+            std::cout << " | jitter p50 " << stats.jitterP50 << "ns, p99 " << stats.jitterP99 << "ns, p99.9 "
+                      << stats.jitterP999 << "ns, max " << stats.jitterMax << "ns";
+        }
+        std::cout << std::endl;
+    }
+}
+
+void PerformanceMonitor::measureBarAggregation(std::size_t ticks, std::size_t symbols) {
+    std::cout << "\n🕯️ === Bar Aggregation (" << ticks << " ticks across " << symbols << " symbols) ===" << std::endl;
+    
+    std::vector<SymbolId> ids(symbols);
+    for (std::size_t s = 0; s < symbols; s++) {
+        ids[s] = internSymbol("BAR" + std::to_string(s));
+    }
+    
+    // One trading session, trades spread uniformly over the symbols
+    std::vector<Tick> tape(ticks);
+    const std::int64_t open = 34200LL * NANOS_PER_SECOND;
+    const std::int64_t spacing = std::max<std::int64_t>(1, 23400LL * NANOS_PER_SECOND / static_cast<std::int64_t>(ticks));
+    std::uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    for (std::size_t i = 0; i < ticks; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        tape[i] = {open + static_cast<std::int64_t>(i) * spacing, ids[seed % symbols],
+                   Price::fromRaw(1000000 + static_cast<std::int64_t>((seed >> 20) % 10000)),
+                   1 + static_cast<int>((seed >> 40) % 500)};
+    }
+    
+    BarAggregator bars({BarSpec::seconds(1), BarSpec::minutes(1), BarSpec::ticks(100), BarSpec::volume(10000)}, 32);
+    std::uint64_t delivered = 0;
+    bars.subscribe([&delivered](const Bar&, std::size_t) { delivered++; });
+    
+    std::uint64_t start = Clock::ticks();
+    for (const Tick& tick : tape) {
+        bars.onTick(tick);
+    }
+    double seconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / NANOS_PER_SECOND;
+    bars.closeElapsed(open + 23400LL * NANOS_PER_SECOND);
+    
+    std::cout << "  4 bar series per symbol (1s, 1m, 100 ticks, 10k shares): " << seconds * 1e9 / ticks
+              << "ns per tick, " << ticks / seconds / 1e6 << "M ticks/s" << std::endl;
+    std::cout << "  " << delivered << " bars delivered to subscribers, "
+              << (symbols * bars.specs().size() * bars.historyPerSeries() * sizeof(Bar)) / (1024 * 1024)
+              << " MB of bar history" << std::endl;
+}
+
+void PerformanceMonitor::measureRangeQueries(std::size_t ticks, std::size_t queries) {
+    std::cout << "\n🔎 === Time Range Queries (" << ticks << " ticks, " << queries << " queries) ===" << std::endl;
+    
+    const std::size_t symbols = 100;
+    std::vector<SymbolId> ids(symbols);
+    for (std::size_t s = 0; s < symbols; s++) {
+        ids[s] = internSymbol("RNG" + std::to_string(s));
+    }
+    
+    // One trading session in a TickStore, trades spread uniformly over the symbols
+    TickStore store;
+    store.reserve(ticks);
+    const std::int64_t open = 34200LL * NANOS_PER_SECOND;
+    const std::int64_t session = 23400LL * NANOS_PER_SECOND;
+    const std::int64_t spacing = std::max<std::int64_t>(1, session / static_cast<std::int64_t>(ticks));
+    std::uint64_t seed = 0x9e3779b97f4a7c15ULL;
+    auto next = [&seed]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        return seed;
+    };
+    for (std::size_t i = 0; i < ticks; i++) {
+        std::uint64_t r = next();
+        store.append(open + static_cast<std::int64_t>(i) * spacing, ids[r % symbols],
+                     Price::fromRaw(1000000 + static_cast<std::int64_t>((r >> 20) % 10000)),
+                     1 + static_cast<int>((r >> 40) % 500));
+    }
+    
+    TickIndex index;
+    std::uint64_t start = Clock::ticks();
+    index.update(store);
+    double buildSeconds = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / NANOS_PER_SECOND;
+    
+    struct Query { SymbolId symbol; std::int64_t from; std::int64_t to; };
+    std::vector<Query> ranges(queries);
+    for (Query& q : ranges) {
+        std::int64_t a = open + static_cast<std::int64_t>(next() % static_cast<std::uint64_t>(session));
+        std::int64_t b = open + static_cast<std::int64_t>(next() % static_cast<std::uint64_t>(session));
+        q = {ids[next() % symbols], std::min(a, b), std::max(a, b) + 1};
+    }
+    
+    double checksum = 0.0;
+    start = Clock::ticks();
+    for (const Query& q : ranges) {
+        RangeStats stats = index.query(q.symbol, q.from, q.to);
+        checksum += stats.vwap + stats.twap;
+    }
+    double indexNanos = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / queries;
+    
+    // Baseline: filter the whole tape per query, as the old price views did
+    const std::size_t scans = std::min<std::size_t>(queries, 20);
+    const auto& timestamps = store.timestampColumn();
+    const auto& symbolColumn = store.symbolColumn();
+    const auto& prices = store.priceColumn();
+    const auto& volumes = store.volumeColumn();
+    std::size_t mismatches = 0;
+    start = Clock::ticks();
+    for (std::size_t i = 0; i < scans; i++) {
+        const Query& q = ranges[i];
+        std::int64_t volume = 0;
+        double notional = 0.0;
+        for (std::size_t row = 0; row < store.size(); row++) {
+            if (symbolColumn[row] == q.symbol && timestamps[row] >= q.from && timestamps[row] < q.to) {
+                volume += volumes[row];
+                notional += prices[row].toDouble() * volumes[row];
+            }
+        }
+        if (volume != index.volume(q.symbol, q.from, q.to)) mismatches++;
+        checksum += volume > 0 ? notional / volume : 0.0;
+    }
+    double scanNanos = static_cast<double>(Clock::ticksToNanos(Clock::ticks() - start)) / scans;
+    
+    std::cout << "  Index build: " << buildSeconds * 1e9 / ticks << "ns per tick" << std::endl;
+    std::cout << "  VWAP+TWAP query: " << indexNanos << "ns indexed vs " << scanNanos / 1000.0
+              << "μs full scan (" << scanNanos / indexNanos << "x)" << std::endl;
+    std::cout << "  " << mismatches << " volume mismatches against the scan (checksum " << checksum << ")" << std::endl;
+}
@@ -0,0 +1,42 @@
+#include "Price.h"
+
+bool parsePrice(std::string_view text, Price& out) {
+    std::size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+')) {
+        negative = (text[i] == '-');
+        i++;
+    }
+    
+    std::int64_t whole = 0;
+    std::size_t wholeDigits = 0;
+    while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+        if (++wholeDigits > 14) return false;  // would overflow the raw range
+        whole = whole * 10 + (text[i] - '0');
+        i++;
+    }
+    
+    std::int64_t fraction = 0;
+    std::size_t fractionDigits = 0;
+    bool roundUp = false;
+    if (i < text.size() && text[i] == '.') {
+        i++;
+        while (i < text.size() && text[i] >= '0' && text[i] <= '9') {
+            if (fractionDigits < 4) {
+                fraction = fraction * 10 + (text[i] - '0');
+            } else if (fractionDigits == 4) {
+                roundUp = (text[i] >= '5');
+            }
+            fractionDigits++;
+            i++;
+        }
+    }
+    if (i != text.size() || (wholeDigits == 0 && fractionDigits == 0)) return false;
+    
+    for (std::size_t d = fractionDigits; d < 4; d++) {
+        fraction *= 10;
+    }
+    std::int64_t raw = whole * Price::SCALE + fraction + (roundUp ? 1 : 0);
+    out = Price::fromRaw(negative ? -raw : raw);
+    return true;
+}
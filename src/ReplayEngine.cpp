@@ -0,0 +1,227 @@
+#include "ReplayEngine.h"
+#include "Clock.h"
+#include "FlatIdMap.h"
+#include "ItchFeed.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// Turns decoded ITCH messages into replay events: order messages become
+// OrderBookEvents, executions and trades become ticks at the traded price
+class CaptureRecorder : public itch::Handler {
+private:
+    std::vector<ReplayEvent>& events;
+    SymbolTable& names;
+    std::vector<SymbolId> locateSymbols;
+    FlatIdMap<Price> restingPrices{1 << 16};  // order ref -> price, for plain executions
+    
+    SymbolId nameLocate(std::uint16_t locate, std::string_view stock) {
+        if (locate >= locateSymbols.size()) locateSymbols.resize(locate + 1, INVALID_SYMBOL);
+        if (locateSymbols[locate] == INVALID_SYMBOL) locateSymbols[locate] = names.intern(stock);
+        return locateSymbols[locate];
+    }
+    
+    SymbolId symbolOf(std::uint16_t locate) const {
+        return (locate < locateSymbols.size()) ? locateSymbols[locate] : INVALID_SYMBOL;
+    }
+    
+    void order(const itch::MessageView& m, OrderEventType type, BookSide side, std::uint64_t ref,
+               std::uint64_t newRef, Price price, std::int64_t quantity) {
+        ReplayEvent event{};
+        event.isTick = false;
+        event.order = {m.timestamp(), symbolOf(m.stockLocate()), type, side, ref, newRef, price, quantity};
+        events.push_back(event);
+    }
+    
+    void trade(const itch::MessageView& m, SymbolId symbol, Price price, std::uint32_t shares) {
+        ReplayEvent event{};
+        event.isTick = true;
+        event.tick = {m.timestamp(), symbol, price, static_cast<int>(shares)};
+        events.push_back(event);
+    }
+    
+    void add(const itch::AddOrder& m) {
+        nameLocate(m.stockLocate(), m.stock());
+        Price price = Price::fromRaw(m.price());
+        restingPrices.insert(m.orderRef(), price);
+        order(m, OrderEventType::ADD, m.isBuy() ? BookSide::BID : BookSide::ASK, m.orderRef(), 0, price, m.shares());
+    }
+    
+public:
+    CaptureRecorder(std::vector<ReplayEvent>& out, SymbolTable& symbolNames) : events(out), names(symbolNames) {}
+    
+    void onStockDirectory(const itch::StockDirectory& m) { nameLocate(m.stockLocate(), m.stock()); }
+    void onAddOrder(const itch::AddOrder& m) { add(m); }
+    void onAddOrderMpid(const itch::AddOrderMpid& m) { add(m); }
+    
+    void onOrderExecuted(const itch::OrderExecuted& m) {
+        const Price* price = restingPrices.find(m.orderRef());
+        Price traded = price != nullptr ? *price : Price();
+        order(m, OrderEventType::EXECUTE, BookSide::BID, m.orderRef(), 0, traded, m.executedShares());
+        if (price != nullptr) trade(m, symbolOf(m.stockLocate()), traded, m.executedShares());
+    }
+    
+    void onOrderExecutedWithPrice(const itch::OrderExecutedWithPrice& m) {
+        Price traded = Price::fromRaw(m.executionPrice());
+        order(m, OrderEventType::EXECUTE, BookSide::BID, m.orderRef(), 0, traded, m.executedShares());
+        if (m.printable()) trade(m, symbolOf(m.stockLocate()), traded, m.executedShares());
+    }
+    
+    void onOrderCancel(const itch::OrderCancel& m) {
+        order(m, OrderEventType::CANCEL, BookSide::BID, m.orderRef(), 0, Price(), m.cancelledShares());
+    }
+    
+    void onOrderDelete(const itch::OrderDelete& m) {
+        restingPrices.erase(m.orderRef());
+        order(m, OrderEventType::DELETE, BookSide::BID, m.orderRef(), 0, Price(), 0);
+    }
+    
+    void onOrderReplace(const itch::OrderReplace& m) {
+        Price price = Price::fromRaw(m.price());
+        restingPrices.erase(m.originalOrderRef());
+        restingPrices.insert(m.newOrderRef(), price);
+        order(m, OrderEventType::REPLACE, BookSide::BID, m.originalOrderRef(), m.newOrderRef(), price, m.shares());
+    }
+    
+    void onTrade(const itch::Trade& m) {
+        trade(m, nameLocate(m.stockLocate(), m.stock()), Price::fromRaw(m.price()), m.shares());
+    }
+};
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+} // namespace
+
+ReplayEngine::~ReplayEngine() {
+    if (worker.joinable()) {
+        stop();
+        worker.join();
+    }
+}
+
+void ReplayEngine::setSource(const TickStore& store) {
+    ticks = &store;
+    capture.clear();
+}
+
+bool ReplayEngine::loadCapture(const std::string& path) {
+    MappedFile file(path);
+    if (!file.isOpen()) return false;
+    
+    capture.clear();
+    capture.reserve(file.size() / 30);  // ~30 bytes per order message
+    CaptureRecorder recorder(capture, globalSymbols());
+    itch::DecodeResult result = itch::decode(file.data(), file.end(), recorder);
+    ticks = nullptr;
+    return result.complete;
+}
+
+std::size_t ReplayEngine::size() const {
+    return ticks != nullptr ? ticks->size() : capture.size();
+}
+
+void ReplayEngine::subscribe(Strategy& strategy) {
+    subscribeTicks([&strategy](const Tick& tick) { strategy.onTick(tick); });
+}
+
+template <typename Source>
+ReplayStats ReplayEngine::play(const ReplayOptions& options, std::size_t count, Source&& source) {
+    ReplayStats stats;
+    stats.pinned = options.core >= 0 && pinCurrentThread(options.core);
+    
+    const bool paced = options.pacing != ReplayPacing::AS_FAST_AS_POSSIBLE && count > 0;
+    const double speed = (options.pacing == ReplayPacing::SCALED && options.speed > 0.0) ? options.speed : 1.0;
+    const std::int64_t firstTimestamp = count > 0 ? source.timestamp(0) : 0;
+    std::vector<std::int64_t> lateness;
+    if (paced) lateness.reserve(count);
+    
+    const std::uint64_t startTicks = Clock::ticks();
+    auto elapsedNs = [startTicks]() { return Clock::ticksToNanos(Clock::ticks() - startTicks); };
+    
+    for (std::size_t i = 0; i < count; i++) {
+        if (stopRequested.load(std::memory_order_relaxed)) {
+            stats.stopped = true;
+            break;
+        }
+        if (paced) {
+            const std::int64_t due = static_cast<std::int64_t>((source.timestamp(i) - firstTimestamp) / speed);
+            std::int64_t now = elapsedNs();
+            if (due - now > options.spinThresholdNs) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(due - now - options.spinThresholdNs));
+            }
+            while ((now = elapsedNs()) < due) {
+                cpuRelax();
+            }
+            lateness.push_back(now - due);
+        }
+        source.dispatch(i);
+        stats.events++;
+    }
+    stats.seconds = static_cast<double>(elapsedNs()) / NANOS_PER_SECOND;
+    
+    if (!lateness.empty()) {
+        std::sort(lateness.begin(), lateness.end());
+        auto percentile = [&](double p) {
+            return lateness[std::min(lateness.size() - 1, static_cast<std::size_t>(p * lateness.size()))];
+        };
+        stats.jitterP50 = percentile(0.50);
+        stats.jitterP99 = percentile(0.99);
+        stats.jitterP999 = percentile(0.999);
+        stats.jitterMax = lateness.back();
+    }
+    return stats;
+}
+
+ReplayStats ReplayEngine::run(const ReplayOptions& options) {
+    stopRequested.store(false, std::memory_order_relaxed);
+    return replay(options);
+}
+
+ReplayStats ReplayEngine::replay(const ReplayOptions& options) {
+    if (ticks != nullptr) {
+        struct StoreSource {
+            const TickStore& store;
+            const std::vector<TickHandler>& handlers;
+            std::int64_t timestamp(std::size_t i) const { return store.timestampColumn()[i]; }
+            void dispatch(std::size_t i) const {
+                const Tick tick = store.tick(i);
+                for (const TickHandler& handler : handlers) handler(tick);
+            }
+        };
+        return play(options, ticks->size(), StoreSource{*ticks, tickHandlers});
+    }
+    
+    struct CaptureSource {
+        const std::vector<ReplayEvent>& events;
+        const std::vector<TickHandler>& tickHandlers;
+        const std::vector<OrderEventHandler>& orderHandlers;
+        std::int64_t timestamp(std::size_t i) const { return events[i].timestamp(); }
+        void dispatch(std::size_t i) const {
+            const ReplayEvent& event = events[i];
+            if (event.isTick) {
+                for (const TickHandler& handler : tickHandlers) handler(event.tick);
+            } else {
+                for (const OrderEventHandler& handler : orderHandlers) handler(event.order);
+            }
+        }
+    };
+    return play(options, capture.size(), CaptureSource{capture, tickHandlers, orderHandlers});
+}
+
+void ReplayEngine::start(const ReplayOptions& options) {
+    if (worker.joinable()) worker.join();
+    stopRequested.store(false, std::memory_order_relaxed);
+    worker = std::thread([this, options]() { workerStats = replay(options); });
+}
+
+ReplayStats ReplayEngine::join() {
+    if (worker.joinable()) worker.join();
+    return workerStats;
+}
@@ -1,69 +1,114 @@
 #include "RiskManager.h"
+#include "AsyncLogger.h"
+#include "OrderJournal.h"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
 
 RiskManager::RiskManager(double maxPosSize, double maxExposure) 
-    : maxPositionSize(maxPosSize), maxTotalExposure(maxExposure) {
+    : maxPositionSize(Price::fromDouble(maxPosSize)), maxTotalExposure(Price::fromDouble(maxExposure)) {
 }
 
 void RiskManager::updatePosition(const Order& order) {
     if (order.status != OrderStatus::FILLED) return;
+    // The fill already happened at the venue, so it is booked either way; a
+    // position the journal missed is reported rather than dropped
+    if (journal != nullptr && !journal->recordPosition(order)) {
+        std::cout << "\n❌ Order journal could not record the " << symbolName(order.symbol)
+                  << " fill of order #" << order.orderId << "; position will not survive a restart!" << std::endl;
+    }
     
-    std::string symbol = order.symbol;
-    int orderQty = (order.type == OrderType::BUY) ? order.quantity : -order.quantity;
+    const SymbolId symbol = order.symbol;
+    const int orderQty = static_cast<int>((order.type == OrderType::BUY) ? order.quantity : -order.quantity);
+    if (symbol >= positions.size()) {
+        positions.resize(symbol + 1);
+    }
+    Position& pos = positions[symbol];
     
-    if (positions.find(symbol) == positions.end()) {
-        Position pos;
+    if (pos.symbol == INVALID_SYMBOL) {
         pos.symbol = symbol;
         pos.quantity = orderQty;
         pos.avgPrice = order.price;
         pos.currentPrice = order.price;
-        pos.unrealizedPnL = 0.0;
-        positions[symbol] = pos;
+        pos.unrealizedPnL = Price();
+        openPositions++;
     } else {
-        Position& pos = positions[symbol];
-        
         if ((pos.quantity > 0 && orderQty > 0) || (pos.quantity < 0 && orderQty < 0)) {
-            double totalValue = (pos.quantity * pos.avgPrice) + (orderQty * order.price);
+            Price totalValue = (pos.avgPrice * pos.quantity) + (order.price * orderQty);
             pos.quantity += orderQty;
             pos.avgPrice = totalValue / pos.quantity;
         } else {
             pos.quantity += orderQty;
             if (pos.quantity == 0) {
-                positions.erase(symbol);
+                pos = Position();
+                openPositions--;
             }
         }
     }
 }
 
 void RiskManager::updateMarketPrices(const std::vector<MarketData>& marketData) {
-    std::map<std::string, double> latestPrices;
-    
+    // The last row of each held symbol sets its mark
     for (const auto& data : marketData) {
-        latestPrices[data.Abb] = data.price;
+        Position* pos = getPosition(data.Abb);
+        if (pos != nullptr) pos->currentPrice = data.price;
+    }
+    for (Position& pos : positions) {
+        if (pos.symbol == INVALID_SYMBOL) continue;
+        pos.unrealizedPnL = (pos.currentPrice - pos.avgPrice) * pos.quantity;
     }
-    for (auto& pair : positions) {
-        Position& pos = pair.second;
-        if (latestPrices.find(pos.symbol) != latestPrices.end()) {
-            pos.currentPrice = latestPrices[pos.symbol];
-            pos.unrealizedPnL = pos.quantity * (pos.currentPrice - pos.avgPrice);
+}
+
+void RiskManager::updateMarketPrices(const TickStore& ticks) {
+    const auto& prices = ticks.priceColumn();
+    for (Position& pos : positions) {
+        const auto& rows = ticks.rowsFor(pos.symbol);
+        if (!rows.empty()) {
+            pos.currentPrice = prices[rows.back()];
+            pos.unrealizedPnL = (pos.currentPrice - pos.avgPrice) * pos.quantity;
         }
     }
 }
 
-bool RiskManager::validateOrder(const Order& order, double currentPrice) {
-    double orderValue = order.quantity * order.price;
+void RiskManager::updateMarketPrices(const OrderBookManager& orderBooks) {
+    for (Position& pos : positions) {
+        if (pos.symbol == INVALID_SYMBOL) continue;
+        const OrderBook* book = orderBooks.find(pos.symbol);
+        if (book != nullptr && (book->hasBid() || book->hasAsk())) {
+            pos.currentPrice = book->mid();
+            pos.unrealizedPnL = (pos.currentPrice - pos.avgPrice) * pos.quantity;
+        }
+    }
+}
+
+void RiskManager::attachOrderBooks(const OrderBookManager* orderBooks, double maxDeviation) {
+    books = orderBooks;
+    maxBookDeviation = maxDeviation;
+}
+
+bool RiskManager::validateOrder(const Order& order, Price currentPrice) {
+    Price orderValue = order.price * order.quantity;
+    
+    // Price collar around the live book, when one is attached
+    if (books != nullptr) {
+        const OrderBook* book = books->find(order.symbol);
+        if (book != nullptr && book->hasBid() && book->hasAsk()) {
+            Price mid = book->mid();
+            if ((order.price - mid).abs() > mid.scaled(maxBookDeviation)) {
+                logAsync("⚠️  RISK ALERT: Order price ${} is too far from the book mid (${})",
+                         order.price.toDouble(), mid.toDouble());
+                return false;
+            }
+        }
+    }
     
     if (orderValue > maxPositionSize) {
-        std::cout << "⚠️  RISK ALERT: Order exceeds max position size ($" 
-                  << maxPositionSize << ")" << std::endl;
+        logAsync("⚠️  RISK ALERT: Order exceeds max position size (${})", maxPositionSize.toDouble());
         return false;
     }
-    double totalExposure = getTotalExposure() + orderValue;
+    Price totalExposure = getTotalExposure() + orderValue;
     if (totalExposure > maxTotalExposure) {
-        std::cout << "⚠️  RISK ALERT: Order would exceed max total exposure ($" 
-                  << maxTotalExposure << ")" << std::endl;
+        logAsync("⚠️  RISK ALERT: Order would exceed max total exposure (${})", maxTotalExposure.toDouble());
         return false;
     }
     
@@ -71,7 +116,7 @@ bool RiskManager::validateOrder(const Order& order, double currentPrice) {
 }
 
 void RiskManager::showPositions() const {
-    if (positions.empty()) {
+    if (openPositions == 0) {
         std::cout << "\n📊 No open positions." << std::endl;
         return;
     }
@@ -79,13 +124,13 @@ void RiskManager::showPositions() const {
     std::cout << "\n📊 === Current Positions ===" << std::endl;
     std::cout << std::fixed << std::setprecision(2);
     
-    double totalPnL = 0.0;
+    Price totalPnL;
     
-    for (const auto& pair : positions) {
-        const Position& pos = pair.second;
+    for (const Position& pos : positions) {
+        if (pos.symbol == INVALID_SYMBOL) continue;
         std::string direction = (pos.quantity > 0) ? "LONG" : "SHORT";
         
-        std::cout << pos.symbol << " | " << direction << " " << abs(pos.quantity) 
+        std::cout << symbolName(pos.symbol) << " | " << direction << " " << abs(pos.quantity) 
                   << " @ $" << pos.avgPrice 
                   << " | Current: $" << pos.currentPrice
                   << " | P&L: $" << pos.unrealizedPnL << std::endl;
@@ -96,16 +141,15 @@ void RiskManager::showPositions() const {
     std::cout << "💰 Total Unrealized P&L: $" << totalPnL << std::endl;
 }
 
-double RiskManager::getTotalExposure() const {
-    double total = 0.0;
-    for (const auto& pair : positions) {
-        const Position& pos = pair.second;
-        total += abs(pos.quantity * pos.currentPrice);
+Price RiskManager::getTotalExposure() const {
+    Price total;
+    for (const Position& pos : positions) {
+        total += (pos.currentPrice * pos.quantity).abs();
     }
     return total;
 }
 
-Position* RiskManager::getPosition(const std::string& symbol) {
-    auto it = positions.find(symbol);
-    return (it != positions.end()) ? &it->second : nullptr;
+Position* RiskManager::getPosition(SymbolId symbol) {
+    if (symbol >= positions.size() || positions[symbol].symbol == INVALID_SYMBOL) return nullptr;
+    return &positions[symbol];
 }
@@ -0,0 +1,149 @@
+#include "RollingIndicators.h"
+#include <cmath>
+#include <utility>
+
+RollingWindow::RollingWindow(std::size_t window)
+    : values(window > 0 ? window : 1), alpha(2.0 / (values.size() + 1.0)) {
+}
+
+void RollingWindow::addToSum(double x) {
+    double t = sum + x;
+    if (std::abs(sum) >= std::abs(x)) {
+        compensation += (sum - t) + x;
+    } else {
+        compensation += (x - t) + sum;
+    }
+    sum = t;
+}
+
+void RollingWindow::update(double price) {
+    const std::size_t n = values.size();
+    
+    if (count < n) {
+        values[count] = price;
+        count++;
+        addToSum(price);
+        
+        double delta = price - mean;
+        mean += delta / count;
+        m2 += delta * (price - mean);
+    } else {
+        double oldest = values[head];
+        values[head] = price;
+        head = (head + 1 == n) ? 0 : head + 1;
+        addToSum(price);
+        addToSum(-oldest);
+        
+        double newMean = mean + (price - oldest) / n;
+        m2 += (price - oldest) * (price - newMean + oldest - mean);
+        mean = newMean;
+    }
+    
+    if (emaSeeded) {
+        emaValue += alpha * (price - emaValue);
+    } else {
+        emaValue = price;
+        emaSeeded = true;
+    }
+}
+
+void RollingWindow::reset() {
+    head = 0;
+    count = 0;
+    sum = 0.0;
+    compensation = 0.0;
+    mean = 0.0;
+    m2 = 0.0;
+    emaValue = 0.0;
+    emaSeeded = false;
+}
+
+double RollingWindow::variance() const {
+    if (count == 0) return 0.0;
+    double v = m2 / count;
+    return v > 0.0 ? v : 0.0;  // guard against rounding below zero
+}
+
+double RollingWindow::stddev() const {
+    return std::sqrt(variance());
+}
+
+RollingIndicatorEngine::RollingIndicatorEngine(std::vector<std::size_t> windows)
+    : windowSizes(std::move(windows)) {
+}
+
+int RollingIndicatorEngine::slotOf(std::size_t window) const {
+    for (std::size_t i = 0; i < windowSizes.size(); i++) {
+        if (windowSizes[i] == window) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void RollingIndicatorEngine::onTick(SymbolId symbol, double price) {
+    const std::size_t perSymbol = windowSizes.size();
+    std::size_t base = static_cast<std::size_t>(symbol) * perSymbol;
+    
+    // Allocate windows only the first time a symbol shows up
+    while (stats.size() < base + perSymbol) {
+        stats.emplace_back(windowSizes[stats.size() % perSymbol]);
+    }
+    for (std::size_t i = 0; i < perSymbol; i++) {
+        stats[base + i].update(price);
+    }
+}
+
+void RollingIndicatorEngine::reset() {
+    stats.clear();
+    sourceGeneration = 0;
+    sourceRows = nullptr;
+    processed = 0;
+}
+
+void RollingIndicatorEngine::update(const TickStore& ticks) {
+    if (ticks.generation() != sourceGeneration || ticks.size() < processed) {
+        reset();
+        sourceGeneration = ticks.generation();
+    }
+    
+    const auto& symbols = ticks.symbolColumn();
+    const auto& prices = ticks.priceColumn();
+    for (std::size_t row = processed; row < ticks.size(); row++) {
+        onTick(symbols[row], prices[row].toDouble());
+    }
+    processed = ticks.size();
+}
+
+void RollingIndicatorEngine::update(const std::vector<MarketData>& rows) {
+    if (sourceGeneration != 0 || rows.data() != sourceRows || rows.size() < processed) {
+        reset();
+        sourceRows = rows.data();
+    }
+    
+    for (std::size_t row = processed; row < rows.size(); row++) {
+        onTick(rows[row].Abb, rows[row].price.toDouble());
+    }
+    processed = rows.size();
+}
+
+const RollingWindow* RollingIndicatorEngine::window(SymbolId symbol, std::size_t windowSize) const {
+    int slot = slotOf(windowSize);
+    if (slot < 0 || symbol == INVALID_SYMBOL) return nullptr;
+    
+    std::size_t index = static_cast<std::size_t>(symbol) * windowSizes.size() + slot;
+    return (index < stats.size()) ? &stats[index] : nullptr;
+}
+
+double RollingIndicatorEngine::sma(SymbolId symbol, std::size_t windowSize) const {
+    const RollingWindow* w = window(symbol, windowSize);
+    return w ? w->sma() : 0.0;
+}
+
+double RollingIndicatorEngine::ema(SymbolId symbol, std::size_t windowSize) const {
+    const RollingWindow* w = window(symbol, windowSize);
+    return w ? w->ema() : 0.0;
+}
+
+double RollingIndicatorEngine::stddev(SymbolId symbol, std::size_t windowSize) const {
+    const RollingWindow* w = window(symbol, windowSize);
+    return w ? w->stddev() : 0.0;
+}
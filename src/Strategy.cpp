@@ -1,18 +1,42 @@
 #include "Strategy.h"
-#include "MarketData.h"
-#include <iostream>
+#include <cstdlib>
 using namespace std;
 
-MovingAvgStrat::MovingAvgStrat(int short_P, int long_P) : shortP(short_P), longP(long_P) {
+MovingAvgStrat::MovingAvgStrat(int short_P, int long_P, int orderQty)
+    : shortP(short_P), longP(long_P), orderQuantity(orderQty),
+      indicators({static_cast<size_t>(short_P), static_cast<size_t>(long_P)}) {
 }
 
-int MovingAvgStrat::generateSignal(const vector<MarketData>& data, const string& symbol) {
-    double shortMA = calculateMovingAverage(data, symbol, shortP);
-    double longMA = calculateMovingAverage(data, symbol, longP);
+void MovingAvgStrat::onTick(const Tick& tick) {
+    indicators.onTick(tick.symbol, tick.price.toDouble());
+    
+    if (tick.symbol >= lastSignal.size()) {
+        lastSignal.resize(tick.symbol + 1, 0);
+        positions.resize(tick.symbol + 1, 0);
+    }
+    
+    int current = signal(tick.symbol);
+    if (current == lastSignal[tick.symbol]) return;
+    lastSignal[tick.symbol] = current;
+    
+    int delta = current * orderQuantity - positions[tick.symbol];
+    if (delta != 0) {
+        emit({tick.symbol, delta > 0 ? OrderType::BUY : OrderType::SELL, abs(delta), tick.price});
+    }
+}
 
-    cout << "  " << getStratName() << endl;
-    cout << "  Short MA (" << shortP << "-period): $" << shortMA << endl;
-    cout << "  Long MA (" << longP << "-period): $" << longMA << endl;
+void MovingAvgStrat::onFill(const Fill& fill) {
+    if (fill.symbol >= positions.size()) {
+        lastSignal.resize(fill.symbol + 1, 0);
+        positions.resize(fill.symbol + 1, 0);
+    }
+    positions[fill.symbol] += (fill.side == OrderType::BUY) ? fill.quantity : -fill.quantity;
+}
+
+int MovingAvgStrat::signal(SymbolId symbol) const {
+    double shortMA = shortAverage(symbol);
+    double longMA = longAverage(symbol);
+    if (shortMA == 0.0 || longMA == 0.0) return 0;
     
     if (shortMA > longMA) {
         return 1;  // Buy signal
@@ -23,6 +47,10 @@ int MovingAvgStrat::generateSignal(const vector<MarketData>& data, const string&
     }
 }
 
+int MovingAvgStrat::position(SymbolId symbol) const {
+    return (symbol < positions.size()) ? positions[symbol] : 0;
+}
+
 string MovingAvgStrat::getStratName() const {
     return "Moving Average Crossover Strategy (" + to_string(shortP) + "/" + to_string(longP) + ")";
-}
\ No newline at end of file
+}
@@ -44,13 +44,13 @@ public:
         
         quickSuite.addTest("Order Creation", []() {
             Order order("AAPL", OrderType::BUY, 100, 150.0);
-            ASSERT_EQ("AAPL", order.symbol);
+            ASSERT_EQ(knownSymbol("AAPL"), order.symbol);
         });
         
         quickSuite.addTest("Risk Management", []() {
             RiskManager rm(1000, 5000);
             Order order("AAPL", OrderType::BUY, 5, 100.0);
-            ASSERT_TRUE(rm.validateOrder(order, 100.0));
+            ASSERT_TRUE(rm.validateOrder(order, order.price));
         });
         
         quickSuite.runAll();
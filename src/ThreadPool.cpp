@@ -0,0 +1,66 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <sched.h>
+
+bool pinCurrentThread(int core) {
+    if (core < 0 || core >= CPU_SETSIZE) return false;
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core, &cpuset);
+    return sched_setaffinity(0, sizeof(cpu_set_t), &cpuset) == 0;
+}
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(std::move(job));
+        unfinished++;
+    }
+    jobReady.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    allDone.wait(lock, [this]() { return unfinished == 0; });
+}
+
+void ThreadPool::workerLoop() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobReady.wait(lock, [this]() { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return;  // stopping and drained
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        
+        job();
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--unfinished == 0) {
+            allDone.notify_all();
+        }
+    }
+}
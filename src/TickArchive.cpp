@@ -0,0 +1,326 @@
+#include "TickArchive.h"
+#include "MarketData.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <numeric>
+
+namespace {
+
+constexpr std::uint64_t BLOCK_ALIGNMENT = 64;
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+void putVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+// Decodes count varints into out; false if the stream is short, too long or malformed.
+// Single-byte values, the common case for deltas, skip the general loop.
+template <typename T, typename Transform>
+bool readVarints(const std::uint8_t* p, const std::uint8_t* end, std::size_t count, T* out, Transform transform) {
+    for (std::size_t i = 0; i < count; i++) {
+        if (p < end && *p < 0x80) {
+            out[i] = transform(*p++);
+            continue;
+        }
+        std::uint64_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            if (p == end || shift > 63) return false;
+            std::uint8_t byte = *p++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if (byte < 0x80) break;
+        }
+        out[i] = transform(value);
+    }
+    return p == end;
+}
+
+} // namespace
+
+bool writeTickArchive(const std::string& path, const TickStore& store, std::uint32_t blockRows) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open() || blockRows == 0) return false;
+    
+    const std::size_t rows = store.size();
+    const auto& timestampColumn = store.timestampColumn();
+    const auto& symbolColumn = store.symbolColumn();
+    const auto& priceColumn = store.priceColumn();
+    const auto& volumeColumn = store.volumeColumn();
+    
+    // Dense dictionary of the symbols that actually have rows
+    std::vector<std::uint32_t> position(store.symbolTable().size(), UINT32_MAX);
+    std::vector<SymbolId> dictionary;
+    for (SymbolId id : symbolColumn) {
+        if (position[id] == UINT32_MAX) {
+            position[id] = static_cast<std::uint32_t>(dictionary.size());
+            dictionary.push_back(id);
+        }
+    }
+    
+    TickArchiveHeader header = {};
+    std::memcpy(header.magic, TICK_ARCHIVE_MAGIC, sizeof(header.magic));
+    header.version = TICK_ARCHIVE_VERSION;
+    header.symbolCount = static_cast<std::uint32_t>(dictionary.size());
+    header.rowCount = rows;
+    header.blockRows = blockRows;
+    header.blockCount = static_cast<std::uint32_t>((rows + blockRows - 1) / blockRows);
+    header.dictionaryOffset = sizeof(TickArchiveHeader);
+    
+    std::vector<char> dictionaryBytes;
+    for (SymbolId id : dictionary) {
+        const std::string& name = symbolName(id);
+        std::uint16_t nameLength = static_cast<std::uint16_t>(name.size());
+        const char* lengthBytes = reinterpret_cast<const char*>(&nameLength);
+        dictionaryBytes.insert(dictionaryBytes.end(), lengthBytes, lengthBytes + sizeof(nameLength));
+        dictionaryBytes.insert(dictionaryBytes.end(), name.begin(), name.end());
+    }
+    header.indexOffset = alignUp(header.dictionaryOffset + dictionaryBytes.size());
+    
+    // Blocks stream out one at a time; the index is filled in at the end
+    static const char zeros[BLOCK_ALIGNMENT] = {};
+    std::vector<ArchiveBlock> index(header.blockCount);
+    std::uint64_t offset = alignUp(header.indexOffset + index.size() * sizeof(ArchiveBlock));
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(dictionaryBytes.data(), dictionaryBytes.size());
+    out.write(zeros, header.indexOffset - header.dictionaryOffset - dictionaryBytes.size());
+    out.seekp(static_cast<std::streamoff>(offset));
+    std::vector<std::uint8_t> stream;
+    std::vector<std::int64_t> lastSteps(dictionary.size());
+    
+    for (std::size_t b = 0; b < index.size(); b++) {
+        const std::size_t first = b * blockRows;
+        const std::size_t last = std::min(rows, first + blockRows);
+        ArchiveBlock& block = index[b];
+        block.firstRow = first;
+        block.rows = static_cast<std::uint32_t>(last - first);
+        block.firstTimestamp = timestampColumn[first];
+        block.minTimestamp = *std::min_element(timestampColumn.begin() + first, timestampColumn.begin() + last);
+        block.maxTimestamp = *std::max_element(timestampColumn.begin() + first, timestampColumn.begin() + last);
+        block.priceTick = 0;
+        for (std::size_t row = first; row < last; row++) {
+            block.priceTick = std::gcd(block.priceTick, priceColumn[row].raw());
+        }
+        if (block.priceTick == 0) block.priceTick = 1;
+        block.offset = offset;
+        
+        stream.clear();
+        std::int64_t previous = block.firstTimestamp;
+        for (std::size_t row = first; row < last; row++) {
+            putVarint(stream, zigzag(timestampColumn[row] - previous));
+            previous = timestampColumn[row];
+        }
+        block.timestampBytes = static_cast<std::uint32_t>(stream.size());
+        
+        for (std::size_t row = first; row < last; row++) {
+            putVarint(stream, position[symbolColumn[row]]);
+        }
+        block.symbolBytes = static_cast<std::uint32_t>(stream.size() - block.timestampBytes);
+        
+        std::fill(lastSteps.begin(), lastSteps.end(), 0);
+        for (std::size_t row = first; row < last; row++) {
+            std::int64_t steps = priceColumn[row].raw() / block.priceTick;
+            std::int64_t& lastStep = lastSteps[position[symbolColumn[row]]];
+            putVarint(stream, zigzag(steps - lastStep));
+            lastStep = steps;
+        }
+        block.priceBytes = static_cast<std::uint32_t>(stream.size() - block.timestampBytes - block.symbolBytes);
+        
+        for (std::size_t row = first; row < last; row++) {
+            putVarint(stream, static_cast<std::uint32_t>(volumeColumn[row]));
+        }
+        block.volumeBytes = static_cast<std::uint32_t>(stream.size() - block.timestampBytes - block.symbolBytes -
+                                                       block.priceBytes);
+        
+        out.write(reinterpret_cast<const char*>(stream.data()), stream.size());
+        std::uint64_t next = alignUp(offset + stream.size());
+        out.write(zeros, next - offset - stream.size());
+        offset = next;
+    }
+    
+    out.seekp(static_cast<std::streamoff>(header.indexOffset));
+    out.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(ArchiveBlock));
+    return out.good();
+}
+
+bool isTickArchive(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(TICK_ARCHIVE_MAGIC)];
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, TICK_ARCHIVE_MAGIC, sizeof(magic)) == 0;
+}
+
+bool archiveTicks(const std::string& inputPath, const std::string& archivePath) {
+    TickStore store;
+    return loadData(store, inputPath) && writeTickArchive(archivePath, store);
+}
+
+bool TickArchive::open(const std::string& path) {
+    close();
+    if (!file.open(path) || file.size() < sizeof(TickArchiveHeader)) return false;
+    std::memcpy(&header, file.data(), sizeof(header));
+    
+    const std::uint64_t fileSize = file.size();
+    const std::uint64_t indexBytes = static_cast<std::uint64_t>(header.blockCount) * sizeof(ArchiveBlock);
+    if (std::memcmp(header.magic, TICK_ARCHIVE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != TICK_ARCHIVE_VERSION ||
+        header.indexOffset > fileSize || indexBytes > fileSize - header.indexOffset ||
+        header.dictionaryOffset > header.indexOffset) {
+        close();
+        return false;
+    }
+    
+    // Dictionary first, so every block can be checked against its size
+    std::vector<std::string_view> names;
+    const char* p = file.data() + header.dictionaryOffset;
+    const char* dictionaryEnd = file.data() + header.indexOffset;
+    for (std::uint32_t i = 0; i < header.symbolCount; i++) {
+        std::uint16_t nameLength;
+        if (dictionaryEnd - p < static_cast<std::ptrdiff_t>(sizeof(nameLength))) {
+            close();
+            return false;
+        }
+        std::memcpy(&nameLength, p, sizeof(nameLength));
+        p += sizeof(nameLength);
+        if (dictionaryEnd - p < nameLength) {
+            close();
+            return false;
+        }
+        names.emplace_back(p, nameLength);
+        p += nameLength;
+    }
+    
+    blocks.resize(header.blockCount);
+    std::memcpy(blocks.data(), file.data() + header.indexOffset, indexBytes);
+    // Every row takes at least one byte in each stream, which bounds the
+    // decode buffers by the file size
+    std::uint64_t expectedRow = 0;
+    timeOrdered = true;
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        const ArchiveBlock& block = blocks[b];
+        if (block.firstRow != expectedRow || block.priceTick <= 0 || block.rows > header.blockRows ||
+            block.rows > block.timestampBytes || block.rows > block.symbolBytes ||
+            block.rows > block.priceBytes || block.rows > block.volumeBytes ||
+            block.minTimestamp > block.maxTimestamp ||
+            block.offset % BLOCK_ALIGNMENT != 0 || block.offset > fileSize || block.bytes() > fileSize - block.offset) {
+            close();
+            return false;
+        }
+        timeOrdered = timeOrdered && (b == 0 || blocks[b - 1].maxTimestamp <= block.maxTimestamp);
+        expectedRow += block.rows;
+    }
+    if (expectedRow != header.rowCount) {
+        close();
+        return false;
+    }
+    
+    symbols.clear();
+    for (std::string_view name : names) {
+        symbols.push_back(internSymbol(name));
+    }
+    return true;
+}
+
+void TickArchive::close() {
+    file.close();
+    header = {};
+    symbols.clear();
+    blocks.clear();
+}
+
+bool TickArchive::decode(const ArchiveBlock& block) {
+    const std::size_t rows = block.rows;
+    timestamps.resize(rows);
+    symbolIds.resize(rows);
+    prices.resize(rows);
+    volumes.resize(rows);
+    archiveSymbols.resize(rows);
+    
+    // One pass per stream: each loop touches a single input and output array
+    const std::uint8_t* p = reinterpret_cast<const std::uint8_t*>(file.data() + block.offset);
+    const std::uint8_t* symbolStream = p + block.timestampBytes;
+    const std::uint8_t* priceStream = symbolStream + block.symbolBytes;
+    const std::uint8_t* volumeStream = priceStream + block.priceBytes;
+    const std::uint8_t* end = volumeStream + block.volumeBytes;
+    
+    if (!readVarints(p, symbolStream, rows, timestamps.data(), unzigzag) ||
+        !readVarints(symbolStream, priceStream, rows, archiveSymbols.data(),
+                     [](std::uint64_t v) { return static_cast<std::uint32_t>(v); }) ||
+        !readVarints(volumeStream, end, rows, volumes.data(), [](std::uint64_t v) { return static_cast<int>(v); })) {
+        return false;
+    }
+    std::int64_t timestamp = block.firstTimestamp;
+    for (std::size_t i = 0; i < rows; i++) {
+        timestamp += timestamps[i];
+        timestamps[i] = timestamp;
+    }
+    const std::uint32_t symbolCount = static_cast<std::uint32_t>(symbols.size());
+    for (std::size_t i = 0; i < rows; i++) {
+        if (archiveSymbols[i] >= symbolCount) return false;
+        symbolIds[i] = symbols[archiveSymbols[i]];
+    }
+    
+    // Prices are deltas per symbol, so they decode after the symbol stream
+    lastSteps.assign(symbols.size(), 0);
+    std::int64_t* raw = reinterpret_cast<std::int64_t*>(prices.data());
+    if (!readVarints(priceStream, volumeStream, rows, raw, unzigzag)) return false;
+    for (std::size_t i = 0; i < rows; i++) {
+        std::int64_t& step = lastSteps[archiveSymbols[i]];
+        step += raw[i];
+        raw[i] = step * block.priceTick;
+    }
+    return true;
+}
+
+std::size_t TickArchive::findBlock(std::int64_t timestamp) const {
+    auto reaches = [timestamp](const ArchiveBlock& block) { return block.maxTimestamp >= timestamp; };
+    // Binary search needs block maxima in order, as they are for a time-sorted store
+    auto it = timeOrdered ? std::partition_point(blocks.begin(), blocks.end(), std::not_fn(reaches))
+                          : std::find_if(blocks.begin(), blocks.end(), reaches);
+    return static_cast<std::size_t>(it - blocks.begin());
+}
+
+bool TickArchive::appendBlock(std::size_t block, TickStore& store) {
+    if (block >= blocks.size() || !decode(blocks[block])) return false;
+    store.appendColumns(timestamps.data(), symbolIds.data(), prices.data(), volumes.data(), blocks[block].rows);
+    return true;
+}
+
+bool TickArchive::load(TickStore& store) {
+    if (!isOpen()) return false;
+    store.clear();
+    store.reserve(header.rowCount);
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+        if (!appendBlock(b, store)) return false;
+    }
+    return true;
+}
+
+bool TickArchive::loadRange(std::int64_t from, std::int64_t to, TickStore& store) {
+    if (!isOpen()) return false;
+    store.clear();
+    for (const ArchiveBlock& block : blocks) {
+        if (block.maxTimestamp < from || block.minTimestamp >= to) continue;  // never decoded
+        if (!decode(block)) return false;
+        for (std::size_t i = 0; i < block.rows; i++) {
+            if (timestamps[i] >= from && timestamps[i] < to) {
+                store.append(timestamps[i], symbolIds[i], prices[i], volumes[i]);
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,177 @@
+#include "TickIndex.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+// First position with times[i] >= timestamp. A few interpolation probes narrow
+// the range on evenly spread timestamps, then binary search finishes it, so
+// clustered data never costs more than O(log n).
+std::size_t searchTimes(const std::vector<std::int64_t>& times, std::int64_t timestamp) {
+    std::size_t lo = 0;
+    std::size_t hi = times.size();
+    for (int probe = 0; probe < 3 && hi - lo > 32; probe++) {
+        const std::int64_t low = times[lo];
+        const std::int64_t high = times[hi - 1];
+        if (timestamp <= low) return lo;
+        if (timestamp > high) return hi;
+        const double fraction = (static_cast<double>(timestamp) - low) / (static_cast<double>(high) - low);
+        std::size_t guess = lo + static_cast<std::size_t>(fraction * static_cast<double>(hi - 1 - lo));
+        guess = std::min(std::max(guess, lo), hi - 1);
+        if (times[guess] < timestamp) {
+            lo = guess + 1;
+        } else {
+            hi = guess;
+        }
+    }
+    return static_cast<std::size_t>(std::lower_bound(times.begin() + lo, times.begin() + hi, timestamp) - times.begin());
+}
+
+// First position with times[i] > timestamp
+std::size_t searchAfter(const std::vector<std::int64_t>& times, std::int64_t timestamp) {
+    if (timestamp == std::numeric_limits<std::int64_t>::max()) return times.size();
+    return searchTimes(times, timestamp + 1);
+}
+
+} // namespace
+
+const TickIndex::Series* TickIndex::find(SymbolId symbol) const {
+    return (symbol < series.size() && !series[symbol].times.empty()) ? &series[symbol] : nullptr;
+}
+
+void TickIndex::append(std::int64_t timestamp, SymbolId symbol, Price price, int volume) {
+    if (symbol >= series.size()) {
+        series.resize(symbol + 1);
+    }
+    Series& s = series[symbol];
+    if (s.volumeSum.empty()) {
+        s.volumeSum.push_back(0);
+        s.notionalSum.push_back(0);
+    }
+    totalTicks++;
+    const Wide notional = static_cast<Wide>(price.raw()) * volume;
+    
+    if (s.times.empty() || timestamp >= s.times.back()) {
+        const Wide area = s.times.empty() ? 0 : s.areaSum.back() + static_cast<Wide>(s.prices.back().raw()) *
+                                                                     (timestamp - s.times.back());
+        s.times.push_back(timestamp);
+        s.prices.push_back(price);
+        s.volumeSum.push_back(s.volumeSum.back() + volume);
+        s.notionalSum.push_back(s.notionalSum.back() + notional);
+        s.areaSum.push_back(area);
+        return;
+    }
+    
+    // Late trade: insert after any trades with the same time, shift the sums behind it
+    const std::size_t at = searchAfter(s.times, timestamp);
+    s.times.insert(s.times.begin() + at, timestamp);
+    s.prices.insert(s.prices.begin() + at, price);
+    s.volumeSum.insert(s.volumeSum.begin() + at + 1, s.volumeSum[at]);
+    s.notionalSum.insert(s.notionalSum.begin() + at + 1, s.notionalSum[at]);
+    for (std::size_t i = at + 1; i < s.volumeSum.size(); i++) {
+        s.volumeSum[i] += volume;
+        s.notionalSum[i] += notional;
+    }
+    s.areaSum.insert(s.areaSum.begin() + at, 0);
+    for (std::size_t i = std::max<std::size_t>(at, 1); i < s.times.size(); i++) {
+        s.areaSum[i] = s.areaSum[i - 1] + static_cast<Wide>(s.prices[i - 1].raw()) * (s.times[i] - s.times[i - 1]);
+    }
+}
+
+void TickIndex::reset() {
+    series.clear();
+    totalTicks = 0;
+    sourceGeneration = 0;
+    processed = 0;
+}
+
+void TickIndex::update(const TickStore& ticks) {
+    if (ticks.generation() != sourceGeneration || ticks.size() < processed) {
+        reset();
+        sourceGeneration = ticks.generation();
+    }
+    
+    const auto& timestamps = ticks.timestampColumn();
+    const auto& symbols = ticks.symbolColumn();
+    const auto& prices = ticks.priceColumn();
+    const auto& volumes = ticks.volumeColumn();
+    for (std::size_t row = processed; row < ticks.size(); row++) {
+        append(timestamps[row], symbols[row], prices[row], volumes[row]);
+    }
+    processed = ticks.size();
+}
+
+std::size_t TickIndex::size(SymbolId symbol) const {
+    const Series* s = find(symbol);
+    return s ? s->times.size() : 0;
+}
+
+std::size_t TickIndex::lowerBound(SymbolId symbol, std::int64_t timestamp) const {
+    const Series* s = find(symbol);
+    return s ? searchTimes(s->times, timestamp) : 0;
+}
+
+bool TickIndex::priceAt(SymbolId symbol, std::int64_t timestamp, Price& price) const {
+    const Series* s = find(symbol);
+    if (!s) return false;
+    const std::size_t after = searchAfter(s->times, timestamp);
+    if (after == 0) return false;
+    price = s->prices[after - 1];
+    return true;
+}
+
+TickIndex::Wide TickIndex::areaUntil(const Series& s, std::int64_t timestamp) {
+    const std::size_t last = searchAfter(s.times, timestamp) - 1;
+    return s.areaSum[last] + static_cast<Wide>(s.prices[last].raw()) * (timestamp - s.times[last]);
+}
+
+RangeStats TickIndex::query(SymbolId symbol, std::int64_t from, std::int64_t to) const {
+    RangeStats stats;
+    const Series* s = find(symbol);
+    if (!s || from >= to) return stats;
+    
+    const std::size_t begin = searchTimes(s->times, from);
+    const std::size_t end = searchTimes(s->times, to);
+    stats.count = end - begin;
+    stats.volume = s->volumeSum[end] - s->volumeSum[begin];
+    if (stats.count > 0) {
+        stats.first = s->prices[begin];
+        stats.last = s->prices[end - 1];
+    }
+    if (stats.volume > 0) {
+        const Wide notional = s->notionalSum[end] - s->notionalSum[begin];
+        stats.vwap = static_cast<double>(notional) / static_cast<double>(stats.volume) / Price::SCALE;
+    }
+    
+    const std::int64_t lo = std::max(from, s->times.front());
+    const std::int64_t hi = std::min(to, s->times.back());
+    if (hi > lo) {
+        const Wide area = areaUntil(*s, hi) - areaUntil(*s, lo);
+        stats.twap = static_cast<double>(area) / static_cast<double>(hi - lo) / Price::SCALE;
+    } else if (to > s->times.front()) {
+        Price held;
+        priceAt(symbol, lo, held);
+        stats.twap = held.toDouble();
+    }
+    return stats;
+}
+
+std::size_t TickIndex::count(SymbolId symbol, std::int64_t from, std::int64_t to) const {
+    const Series* s = find(symbol);
+    if (!s || from >= to) return 0;
+    return searchTimes(s->times, to) - searchTimes(s->times, from);
+}
+
+std::int64_t TickIndex::volume(SymbolId symbol, std::int64_t from, std::int64_t to) const {
+    const Series* s = find(symbol);
+    if (!s || from >= to) return 0;
+    return s->volumeSum[searchTimes(s->times, to)] - s->volumeSum[searchTimes(s->times, from)];
+}
+
+double TickIndex::vwap(SymbolId symbol, std::int64_t from, std::int64_t to) const {
+    return query(symbol, from, to).vwap;
+}
+
+double TickIndex::twap(SymbolId symbol, std::int64_t from, std::int64_t to) const {
+    return query(symbol, from, to).twap;
+}
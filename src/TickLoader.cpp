@@ -0,0 +1,354 @@
+#include "TickLoader.h"
+#include "MappedFile.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <string_view>
+
+namespace {
+
+// One CSV row split in place; the views point into the source buffer
+struct TickFields {
+    std::string_view time;
+    std::string_view symbol;
+    Price price;
+    int volume;
+};
+
+// Returns the end of the field starting at p (next ',' or lineEnd)
+const char* fieldEnd(const char* p, const char* lineEnd) {
+    const void* comma = std::memchr(p, ',', lineEnd - p);
+    return comma ? static_cast<const char*>(comma) : lineEnd;
+}
+
+bool splitRow(const char* p, const char* lineEnd, TickFields& fields) {
+    const char* timeEnd = fieldEnd(p, lineEnd);
+    if (timeEnd == lineEnd) return false;
+    const char* symbol = timeEnd + 1;
+    const char* symbolEnd = fieldEnd(symbol, lineEnd);
+    if (symbolEnd == lineEnd) return false;
+    const char* priceStr = symbolEnd + 1;
+    const char* priceEnd = fieldEnd(priceStr, lineEnd);
+    if (priceEnd == lineEnd) return false;
+    const char* volumeStr = priceEnd + 1;
+    const char* volumeEnd = fieldEnd(volumeStr, lineEnd);
+    
+    if (!parsePrice(std::string_view(priceStr, priceEnd - priceStr), fields.price)) return false;
+    auto volumeResult = std::from_chars(volumeStr, volumeEnd, fields.volume);
+    if (volumeResult.ec != std::errc() || volumeResult.ptr != volumeEnd) return false;
+    
+    fields.time = std::string_view(p, timeEnd - p);
+    fields.symbol = std::string_view(symbol, symbolEnd - symbol);
+    return true;
+}
+
+// Hand each parsed row of [begin, end) to sink; begin must start a line
+template <typename Sink>
+std::size_t forEachTickLine(const char* begin, const char* end, Sink&& sink) {
+    const char* p = begin;
+    std::size_t appended = 0;
+    TickFields fields;
+    while (p < end) {
+        const void* nl = std::memchr(p, '\n', end - p);
+        const char* lineEnd = nl ? static_cast<const char*>(nl) : end;
+        const char* next = nl ? lineEnd + 1 : end;
+        if (lineEnd > p && lineEnd[-1] == '\r') lineEnd--;
+        
+        if (lineEnd > p && splitRow(p, lineEnd, fields) && sink(fields)) {
+            appended++;
+        }
+        p = next;
+    }
+    return appended;
+}
+
+// Walk the data lines after the header and hand each parsed row to sink
+template <typename Sink>
+std::size_t forEachTickRow(const char* begin, const char* end, Sink&& sink) {
+    const void* headerEnd = std::memchr(begin, '\n', end - begin);
+    if (!headerEnd) return 0;
+    return forEachTickLine(static_cast<const char*>(headerEnd) + 1, end, sink);
+}
+
+// Below this much CSV per thread, spreading the parse costs more than it saves
+constexpr std::size_t MIN_PARALLEL_CHUNK_BYTES = 4 << 20;
+
+// Rows parsed from one chunk. Symbol IDs are chunk-local until remapped to
+// the store's table.
+struct TickChunk {
+    std::vector<std::int64_t> timestamps;
+    std::vector<SymbolId> symbolIds;
+    std::vector<Price> prices;
+    std::vector<int> volumes;
+    SymbolTable symbols;
+    
+    std::size_t size() const { return timestamps.size(); }
+    
+    void reserve(std::size_t rows) {
+        timestamps.reserve(rows);
+        symbolIds.reserve(rows);
+        prices.reserve(rows);
+        volumes.reserve(rows);
+    }
+    
+    void push(std::int64_t timestamp, SymbolId symbol, Price price, int volume) {
+        timestamps.push_back(timestamp);
+        symbolIds.push_back(symbol);
+        prices.push_back(price);
+        volumes.push_back(volume);
+    }
+};
+
+// Split [begin, end) into parts pieces that each end just after a newline
+std::vector<const char*> splitOnLines(const char* begin, const char* end, std::size_t parts) {
+    std::vector<const char*> bounds(parts + 1, end);
+    bounds[0] = begin;
+    const std::size_t bytes = end - begin;
+    for (std::size_t k = 1; k < parts; k++) {
+        const char* p = std::max(begin + bytes * k / parts, bounds[k - 1]);
+        const void* nl = std::memchr(p, '\n', end - p);
+        bounds[k] = nl ? static_cast<const char*>(nl) + 1 : end;
+    }
+    return bounds;
+}
+
+// Stable-sort one chunk's rows by timestamp (only called when out of order)
+void sortChunk(TickChunk& chunk) {
+    std::vector<std::uint32_t> order(chunk.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&chunk](std::uint32_t a, std::uint32_t b) {
+        return chunk.timestamps[a] < chunk.timestamps[b];
+    });
+    
+    TickChunk sorted;
+    sorted.reserve(chunk.size());
+    for (std::uint32_t row : order) {
+        sorted.push(chunk.timestamps[row], chunk.symbolIds[row], chunk.prices[row], chunk.volumes[row]);
+    }
+    sorted.symbols = std::move(chunk.symbols);
+    chunk = std::move(sorted);
+}
+
+void parseChunk(const char* begin, const char* end, TickChunk& chunk) {
+    chunk.reserve(countTickRows(begin, end) + 1);  // countTickRows skips a header line
+    forEachTickLine(begin, end, [&chunk](const TickFields& fields) {
+        std::int64_t nanos;
+        if (!parseTimeOfDay(fields.time, nanos)) return false;
+        chunk.push(nanos, chunk.symbols.intern(fields.symbol), fields.price, fields.volume);
+        return true;
+    });
+    if (!std::is_sorted(chunk.timestamps.begin(), chunk.timestamps.end())) {
+        sortChunk(chunk);
+    }
+}
+
+// k-way merge of sorted chunks; equal timestamps keep file order
+void mergeChunks(const std::vector<TickChunk>& chunks, std::size_t rows, TickStore& store) {
+    TickChunk merged;
+    merged.reserve(rows);
+    
+    using Cursor = std::pair<std::int64_t, std::size_t>;  // next timestamp, chunk
+    std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heads;
+    std::vector<std::size_t> positions(chunks.size(), 0);
+    for (std::size_t c = 0; c < chunks.size(); c++) {
+        if (chunks[c].size() > 0) heads.emplace(chunks[c].timestamps[0], c);
+    }
+    while (!heads.empty()) {
+        std::size_t c = heads.top().second;
+        heads.pop();
+        const TickChunk& chunk = chunks[c];
+        std::size_t& i = positions[c];
+        // Take the whole run that stays ahead of the next chunk in line
+        std::int64_t limit = heads.empty() ? INT64_MAX : heads.top().first;
+        std::size_t c2 = heads.empty() ? chunks.size() : heads.top().second;
+        do {
+            merged.push(chunk.timestamps[i], chunk.symbolIds[i], chunk.prices[i], chunk.volumes[i]);
+            i++;
+        } while (i < chunk.size() &&
+                 (chunk.timestamps[i] < limit || (chunk.timestamps[i] == limit && c < c2)));
+        if (i < chunk.size()) heads.emplace(chunk.timestamps[i], c);
+    }
+    store.appendColumns(merged.timestamps.data(), merged.symbolIds.data(), merged.prices.data(),
+                        merged.volumes.data(), merged.size());
+}
+
+} // namespace
+
+std::size_t countTickRows(const char* begin, const char* end) {
+    std::size_t lines = 0;
+    const char* p = begin;
+    while (p < end) {
+        const void* nl = std::memchr(p, '\n', end - p);
+        if (!nl) {
+            lines++; // last line without trailing newline
+            break;
+        }
+        lines++;
+        p = static_cast<const char*>(nl) + 1;
+    }
+    return lines > 0 ? lines - 1 : 0; // minus header
+}
+
+std::size_t parseTickCsv(const char* begin, const char* end, std::vector<MarketData>& data) {
+    MarketData row;
+    return forEachTickRow(begin, end, [&data, &row](const TickFields& fields) {
+        if (!parseTimeOfDay(fields.time, row.Time)) return false;
+        row.Abb = internSymbol(fields.symbol);
+        row.price = fields.price;
+        row.volume = fields.volume;
+        data.push_back(row);
+        return true;
+    });
+}
+
+std::size_t parseTickCsv(const char* begin, const char* end, TickStore& store) {
+    return forEachTickRow(begin, end, [&store](const TickFields& fields) {
+        std::int64_t nanos;
+        if (!parseTimeOfDay(fields.time, nanos)) return false;
+        store.append(nanos, fields.symbol, fields.price, fields.volume);
+        return true;
+    });
+}
+
+std::size_t parseTickCsvParallel(const char* begin, const char* end, TickStore& store, ThreadPool& pool) {
+    const void* headerEnd = std::memchr(begin, '\n', end - begin);
+    if (!headerEnd) return 0;
+    
+    const std::size_t parts = std::max<std::size_t>(1, pool.size());
+    std::vector<const char*> bounds = splitOnLines(static_cast<const char*>(headerEnd) + 1, end, parts);
+    std::vector<TickChunk> chunks(parts);
+    pool.parallelFor(parts, [&bounds, &chunks](std::size_t i) {
+        parseChunk(bounds[i], bounds[i + 1], chunks[i]);
+    });
+    
+    // Intern in chunk order so IDs come out as a sequential load assigns them
+    std::vector<std::vector<SymbolId>> remap(parts);
+    for (std::size_t c = 0; c < parts; c++) {
+        for (SymbolId local = 0; local < chunks[c].symbols.size(); local++) {
+            remap[c].push_back(store.symbolTable().intern(chunks[c].symbols.name(local)));
+        }
+    }
+    pool.parallelFor(parts, [&chunks, &remap](std::size_t c) {
+        for (SymbolId& id : chunks[c].symbolIds) id = remap[c][id];
+    });
+    
+    std::size_t rows = 0;
+    bool ordered = true;
+    std::int64_t previous = INT64_MIN;
+    for (const TickChunk& chunk : chunks) {
+        if (chunk.size() == 0) continue;
+        rows += chunk.size();
+        ordered = ordered && chunk.timestamps.front() >= previous;
+        previous = chunk.timestamps.back();
+    }
+    
+    store.reserve(store.size() + rows);
+    if (ordered) {
+        // The usual case for a session file: chunks just concatenate
+        for (const TickChunk& chunk : chunks) {
+            store.appendColumns(chunk.timestamps.data(), chunk.symbolIds.data(), chunk.prices.data(),
+                                chunk.volumes.data(), chunk.size());
+        }
+    } else {
+        mergeChunks(chunks, rows, store);
+    }
+    return rows;
+}
+
+bool loadTicksMapped(const std::string& path, std::vector<MarketData>& data) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    if (file.size() == 0) return true;
+    
+    data.reserve(data.size() + countTickRows(file.data(), file.end()));
+    parseTickCsv(file.data(), file.end(), data);
+    return true;
+}
+
+bool loadTicksMapped(const std::string& path, TickStore& store) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    if (file.size() == 0) return true;
+    
+    store.reserve(store.size() + countTickRows(file.data(), file.end()));
+    parseTickCsv(file.data(), file.end(), store);
+    return true;
+}
+
+bool loadTicksParallel(const std::string& path, TickStore& store, ThreadPool& pool) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    if (file.size() == 0) return true;
+    
+    parseTickCsvParallel(file.data(), file.end(), store, pool);
+    return true;
+}
+
+bool loadTicksParallel(const std::string& path, TickStore& store, std::size_t threads) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    if (file.size() == 0) return true;
+    
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    threads = std::min(threads, file.size() / MIN_PARALLEL_CHUNK_BYTES);
+    if (threads <= 1) {
+        // One chunk on the calling thread, sorted the same way as the parallel path
+        const void* headerEnd = std::memchr(file.data(), '\n', file.size());
+        if (!headerEnd) return true;
+        TickChunk chunk;
+        parseChunk(static_cast<const char*>(headerEnd) + 1, file.end(), chunk);
+        std::vector<SymbolId> remap;
+        for (SymbolId local = 0; local < chunk.symbols.size(); local++) {
+            remap.push_back(store.symbolTable().intern(chunk.symbols.name(local)));
+        }
+        for (SymbolId& id : chunk.symbolIds) id = remap[id];
+        store.appendColumns(chunk.timestamps.data(), chunk.symbolIds.data(), chunk.prices.data(),
+                            chunk.volumes.data(), chunk.size());
+        return true;
+    }
+    
+    ThreadPool pool(threads);
+    parseTickCsvParallel(file.data(), file.end(), store, pool);
+    return true;
+}
+
+bool generateTickCsv(const std::string& path, std::size_t rows) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) return false;
+    
+    static const char* symbols[] = {"AAPL", "MSFT", "GOOG", "AMZN", "TSLA", "NVDA", "META", "NFLX"};
+    const std::size_t symbolCount = sizeof(symbols) / sizeof(symbols[0]);
+    
+    std::string buffer;
+    buffer.reserve(1 << 20);
+    buffer += "timestamp,symbol,price,volume\n";
+    
+    char line[64];
+    for (std::size_t i = 0; i < rows; i++) {
+        // Rows spread evenly (and in order) over one 6.5h session from 09:30
+        std::uint64_t micros = static_cast<std::uint64_t>(i) * 23400000000ULL / rows;
+        std::uint64_t second = 30 * 60 + micros / 1000000;
+        int hh = 9 + static_cast<int>(second / 3600);
+        int mm = static_cast<int>((second / 60) % 60);
+        int ss = static_cast<int>(second % 60);
+        std::size_t s = i % symbolCount;
+        double price = 100.0 + s * 25.0 + static_cast<double>((i * 7919) % 1000) * 0.01;
+        int volume = 100 + static_cast<int>((i * 104729) % 5000);
+        
+        int len = std::snprintf(line, sizeof(line), "%02d:%02d:%02d.%06d,%s,%.2f,%d\n",
+                                hh, mm, ss, static_cast<int>(micros % 1000000), symbols[s], price, volume);
+        buffer.append(line, len);
+        if (buffer.size() > (1 << 20) - 64) {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), buffer.size());
+    return out.good();
+}
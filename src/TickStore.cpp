@@ -0,0 +1,130 @@
+#include "TickStore.h"
+#include <atomic>
+
+namespace {
+
+const std::vector<std::uint32_t> NO_ROWS;
+
+} // namespace
+
+std::uint64_t TickStore::nextGeneration() {
+    static std::atomic<std::uint64_t> counter{0};
+    return ++counter;
+}
+
+TickStore::TickStore() : storeGeneration(nextGeneration()) {
+}
+
+void TickStore::reserve(std::size_t rows) {
+    timestamps.reserve(rows);
+    symbolIds.reserve(rows);
+    prices.reserve(rows);
+    volumes.reserve(rows);
+}
+
+void TickStore::clear() {
+    timestamps.clear();
+    symbolIds.clear();
+    prices.clear();
+    volumes.clear();
+    symbolRows.clear();
+    history.clear();
+    storeGeneration = nextGeneration();
+}
+
+void TickStore::append(std::int64_t timestamp, SymbolId symbol, Price price, int volume) {
+    if (symbol >= symbolRows.size()) {
+        symbolRows.resize(symbol + 1);
+    }
+    symbolRows[symbol].push_back(static_cast<std::uint32_t>(prices.size()));
+    
+    timestamps.push_back(timestamp);
+    symbolIds.push_back(symbol);
+    prices.push_back(price);
+    volumes.push_back(volume);
+    history.update(symbol, price);
+}
+
+void TickStore::append(std::int64_t timestamp, std::string_view symbol, Price price, int volume) {
+    append(timestamp, internSymbol(symbol), price, volume);
+}
+
+void TickStore::append(const MarketData& md) {
+    append(md.Time, md.Abb, md.price, md.volume);
+}
+
+void TickStore::assignColumns(const std::int64_t* timestampData, const SymbolId* symbolData,
+                              const Price* priceData, const int* volumeData, std::size_t rows) {
+    timestamps.assign(timestampData, timestampData + rows);
+    symbolIds.assign(symbolData, symbolData + rows);
+    prices.assign(priceData, priceData + rows);
+    volumes.assign(volumeData, volumeData + rows);
+    symbolRows.assign(globalSymbols().size(), {});
+    history.clear();
+    storeGeneration = nextGeneration();
+}
+
+void TickStore::assignSymbolRows(SymbolId symbol, const std::uint32_t* rows, std::size_t count) {
+    if (symbol >= symbolRows.size()) {
+        symbolRows.resize(symbol + 1);
+    }
+    symbolRows[symbol].assign(rows, rows + count);
+    
+    // Seed the recent-price ring from the tail of this symbol's rows
+    std::size_t first = (count > PRICE_HISTORY_CAPACITY) ? count - PRICE_HISTORY_CAPACITY : 0;
+    for (std::size_t i = first; i < count; i++) {
+        history.update(symbol, prices[rows[i]]);
+    }
+}
+
+void TickStore::appendColumns(const std::int64_t* timestampData, const SymbolId* symbolData,
+                              const Price* priceData, const int* volumeData, std::size_t rows) {
+    const std::uint32_t firstRow = static_cast<std::uint32_t>(prices.size());
+    timestamps.insert(timestamps.end(), timestampData, timestampData + rows);
+    symbolIds.insert(symbolIds.end(), symbolData, symbolData + rows);
+    prices.insert(prices.end(), priceData, priceData + rows);
+    volumes.insert(volumes.end(), volumeData, volumeData + rows);
+    
+    if (symbolRows.size() < globalSymbols().size()) {
+        symbolRows.resize(globalSymbols().size());
+    }
+    for (std::size_t i = 0; i < rows; i++) {
+        symbolRows[symbolData[i]].push_back(firstRow + static_cast<std::uint32_t>(i));
+        history.update(symbolData[i], priceData[i]);
+    }
+}
+
+TickStore TickStore::fromRows(const std::vector<MarketData>& rows) {
+    TickStore store;
+    store.reserve(rows.size());
+    for (const auto& md : rows) {
+        store.append(md);
+    }
+    return store;
+}
+
+const std::vector<std::uint32_t>& TickStore::rowsFor(SymbolId symbol) const {
+    return (symbol < symbolRows.size()) ? symbolRows[symbol] : NO_ROWS;
+}
+
+SymbolId TickStore::findSymbol(std::string_view name) const {
+    SymbolId id = globalSymbols().find(name);
+    return rowsFor(id).empty() ? INVALID_SYMBOL : id;
+}
+
+std::size_t TickStore::symbolCount() const {
+    std::size_t count = 0;
+    for (const auto& rows : symbolRows) {
+        if (!rows.empty()) count++;
+    }
+    return count;
+}
+
+MarketData TickStore::row(std::size_t index) const {
+    MarketData md;
+    md.Time = timestamps[index];
+    md.Abb = symbolIds[index];
+    md.price = prices[index];
+    md.volume = volumes[index];
+    return md;
+}
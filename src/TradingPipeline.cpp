@@ -0,0 +1,97 @@
+#include "TradingPipeline.h"
+
+TradingPipeline::TradingPipeline(Strategy& strategy, RiskManager& risk, OrderManager& orders, ExchangeAPI& venue,
+                                 LatencyTracer& tracer)
+    : strategy(strategy), risk(risk), orders(orders), venue(venue), tracer(tracer) {
+    reports.reserve(64);
+    // Reports are queued rather than booked in the handler: the venue may
+    // report a fill before placeOrder has returned the ID to look it up by
+    venue.setFillHandler([this](const VenueFill& fill) { reports.push_back(fill); });
+}
+
+TradingPipeline::~TradingPipeline() {
+    venue.setFillHandler(nullptr);
+}
+
+void TradingPipeline::bookFills() {
+    // Fills go back to the strategy, which does not call the venue, so no report is added meanwhile
+    for (const VenueFill& report : reports) {
+        OrderId* local = working.find(report.exchangeOrderId);
+        if (local == nullptr) continue;  // not placed through this pipeline
+        const OrderId orderId = *local;
+        if (!orders.fillOrder(orderId, report.quantity)) continue;
+        
+        const Order* order = orders.findOrder(orderId);
+        Order fill(orderId, order->symbol, order->type, report.quantity, report.price);
+        fill.status = OrderStatus::FILLED;
+        fill.filledQuantity = report.quantity;
+        risk.updatePosition(fill);
+        strategy.onFill(Fill{orderId, order->symbol, order->type, static_cast<int>(report.quantity), report.price,
+                             Clock::now()});
+        counters.fills++;
+        if (order->status == OrderStatus::FILLED) {
+            counters.filled++;
+            working.erase(report.exchangeOrderId);
+        }
+    }
+    reports.clear();
+}
+
+void TradingPipeline::onTick(const Tick& tick) {
+    TraceRecord trace;
+    trace.symbol = tick.symbol;
+    trace.stamp(TraceStage::FEED_RECEIVE);
+    counters.ticks++;
+    
+    if (!reports.empty()) bookFills();
+    strategy.onTick(tick);
+    trace.stamp(TraceStage::STRATEGY_DECISION);
+    
+    const std::vector<OrderIntent>& intents = strategy.pendingIntents();
+    if (intents.empty()) {
+        tracer.submit(trace);
+        return;
+    }
+    // Fills go back to the strategy and may queue more intents; index, since the buffer can grow
+    for (std::size_t i = 0; i < intents.size(); i++) {
+        route(intents[i], trace);
+    }
+    strategy.clearIntents();
+}
+
+void TradingPipeline::route(OrderIntent intent, TraceRecord trace) {
+    counters.intents++;
+    
+    // Checked before an ID is spent on it
+    const Order candidate(INVALID_ORDER_ID, intent.symbol, intent.side, intent.quantity, intent.price);
+    const bool passed = risk.validateOrder(candidate, intent.price);
+    trace.stamp(TraceStage::RISK_CHECK);
+    if (!passed) {
+        counters.riskRejects++;
+        tracer.submit(trace);
+        return;
+    }
+    
+    const OrderId orderId = orders.placeOrder(intent.symbol, intent.side, intent.quantity, intent.price);
+    if (orderId == INVALID_ORDER_ID) {
+        counters.localRejects++;
+        tracer.submit(trace);
+        return;
+    }
+    trace.orderId = orderId;
+    trace.stamp(TraceStage::GATEWAY_SEND);
+    const OrderId venueId = venue.placeOrder(symbolName(intent.symbol), intent.side == OrderType::BUY ? "buy" : "sell",
+                                             intent.quantity, intent.price);
+    trace.stamp(TraceStage::EXCHANGE_ACK);
+    tracer.submit(trace);
+    
+    if (venueId == INVALID_ORDER_ID) {
+        counters.venueRejects++;
+        orders.applyEvent(orderId, OrderEvent::REJECT);
+        return;
+    }
+    orders.applyEvent(orderId, OrderEvent::ACK);
+    working.insert(venueId, orderId);
+    // A marketable order may have been filled before placeOrder returned
+    if (!reports.empty()) bookFills();
+}
@@ -1,20 +1,51 @@
 #include "TestFramework.h"
 #include "MarketData.h"
+#include "TickLoader.h"
+#include "TickStore.h"
+#include "BinaryTickFile.h"
+#include "TickArchive.h"
+#include "TickIndex.h"
+#include "RollingIndicators.h"
+#include "AsyncLogger.h"
+#include "LatencyTrace.h"
+#include "Clock.h"
+#include "SpscRing.h"
+#include "ThreadPool.h"
+#include "IndicatorKernels.h"
+#include "BarAggregator.h"
+#include "OrderBook.h"
+#include "L3OrderBook.h"
+#include "FlatIdMap.h"
+#include "ItchFeed.h"
+#include "MappedFile.h"
+#include "OrderJournal.h"
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <filesystem>
+#include <fstream>
 #include "Order.h"
 #include "RiskManager.h"
 #include "Strategy.h"
 #include "ExchangeManager.h"
 #include <vector>
 #include <cmath>
+#include <thread>
+#include <chrono>
 
 class UnitTests {
 public:
     static void runAllTests() {
         testMarketDataProcessing();
+        testTickStore();
+        testRollingIndicators();
+        testOrderBook();
         testOrderManagement();
         testRiskManagement();
         testStrategyEngine();
         testExchangeConnectivity();
+        testAsyncLogger();
+        testLatencyTrace();
     }
     
 private:
@@ -24,13 +55,13 @@ private:
         // Test 1: Market data structure
         suite.addTest("MarketData Structure", []() {
             MarketData data;
-            data.Time = "09:30:00";
-            data.Abb = "AAPL";
-            data.price = 150.25;
+            data.Time = 34200LL * NANOS_PER_SECOND;
+            data.Abb = internSymbol("AAPL");
+            data.price = Price::fromDouble(150.25);
             data.volume = 1000;
             
-            ASSERT_EQ("AAPL", data.Abb);
-            ASSERT_NEAR(150.25, data.price, 0.01);
+            ASSERT_EQ(std::string("AAPL"), symbolName(data.Abb));
+            ASSERT_NEAR(150.25, data.price.toDouble(), 0.01);
             ASSERT_EQ(1000, data.volume);
         });
         
@@ -41,8 +72,8 @@ private:
             // Create test data: prices 100, 101, 102, 103, 104
             for (int i = 0; i < 5; i++) {
                 MarketData data;
-                data.Abb = "TEST";
-                data.price = 100.0 + i;
+                data.Abb = internSymbol("TEST");
+                data.price = Price::fromDouble(100.0 + i);
                 testData.push_back(data);
             }
             
@@ -58,6 +89,1115 @@ private:
             ASSERT_EQ(0.0, ma);
         });
         
+        // Test 4: In-place CSV parsing
+        suite.addTest("CSV Tick Parsing", []() {
+            const std::string csv =
+                "timestamp,symbol,price,volume\r\n"
+                "09:30:00,AAPL,150.25,1000\r\n"
+                "09:30:01,AAPL,not-a-price,500\n"
+                "\n"
+                "09:30:03,MSFT,280.15,2000";  // no trailing newline
+            
+            std::vector<MarketData> data;
+            std::size_t rows = parseTickCsv(csv.data(), csv.data() + csv.size(), data);
+            
+            ASSERT_EQ(2u, rows);
+            ASSERT_EQ(4u, countTickRows(csv.data(), csv.data() + csv.size()));
+            ASSERT_EQ(34200LL * NANOS_PER_SECOND, data[0].Time);
+            ASSERT_EQ(std::string("AAPL"), symbolName(data[0].Abb));
+            ASSERT_EQ(Price::fromDouble(150.25), data[0].price);
+            ASSERT_EQ(1000, data[0].volume);
+            ASSERT_EQ(std::string("MSFT"), symbolName(data[1].Abb));
+            ASSERT_EQ(2000, data[1].volume);
+        });
+        
+        // Test 5: Fixed-point prices parse and add up exactly
+        suite.addTest("Fixed-Point Price", []() {
+            Price p;
+            ASSERT_TRUE(parsePrice("150.25", p));
+            ASSERT_EQ(1502500, p.raw());
+            ASSERT_TRUE(parsePrice("-0.00005", p));
+            ASSERT_EQ(-1, p.raw());
+            ASSERT_TRUE(parsePrice("7", p));
+            ASSERT_EQ(Price::fromDouble(7.0), p);
+            ASSERT_FALSE(parsePrice("", p));
+            ASSERT_FALSE(parsePrice("1.2.3", p));
+            ASSERT_FALSE(parsePrice("12a", p));
+            
+            // 0.1 ten times is exactly 1.0, unlike with doubles
+            Price sum;
+            for (int i = 0; i < 10; i++) sum += Price::fromDouble(0.1);
+            ASSERT_EQ(Price::fromDouble(1.0), sum);
+            
+            const Price cent = Price::fromRaw(100);
+            ASSERT_TRUE(Price::fromDouble(150.25).isOnTick(cent));
+            ASSERT_FALSE(Price::fromDouble(150.255).isOnTick(cent));
+            ASSERT_EQ(Price::fromDouble(150.26), Price::fromDouble(150.255).roundToTick(cent));
+            ASSERT_EQ(Price::fromDouble(1502.5), Price::fromDouble(150.25) * 10);
+        });
+        
+        suite.runAll();
+    }
+    
+    static void testTickStore() {
+        TestSuite suite("Columnar Tick Store");
+        
+        // Test 1: Columns and per-symbol row index
+        suite.addTest("Columns and Symbol Index", []() {
+            TickStore store;
+            store.append(34200LL * 1000000000LL, "AAPL", Price::fromDouble(150.25), 1000);
+            store.append(34201LL * 1000000000LL, "MSFT", Price::fromDouble(280.15), 2000);
+            store.append(34202LL * 1000000000LL, "AAPL", Price::fromDouble(150.30), 500);
+            
+            ASSERT_EQ(3u, store.size());
+            ASSERT_EQ(2u, store.symbolCount());
+            SymbolId aapl = store.findSymbol("AAPL");
+            ASSERT_EQ(0u, aapl);
+            ASSERT_EQ(INVALID_SYMBOL, store.findSymbol("GOOG"));
+            ASSERT_EQ(2u, store.rowsFor(aapl).size());
+            ASSERT_EQ(2u, store.rowsFor(aapl)[1]);
+            ASSERT_TRUE(store.rowsFor(INVALID_SYMBOL).empty());
+            
+            MarketData md = store.row(1);
+            ASSERT_EQ("09:30:01", formatTimeOfDay(md.Time));
+            ASSERT_EQ(knownSymbol("MSFT"), md.Abb);
+            ASSERT_EQ(2000, md.volume);
+        });
+        
+        // Test 2: Time-of-day parsing
+        suite.addTest("Time Of Day Parsing", []() {
+            std::int64_t nanos = 0;
+            ASSERT_TRUE(parseTimeOfDay("09:30:00", nanos));
+            ASSERT_EQ(34200LL * 1000000000LL, nanos);
+            ASSERT_TRUE(parseTimeOfDay("09:30:00.000250", nanos));
+            ASSERT_EQ(34200LL * 1000000000LL + 250000, nanos);
+            ASSERT_EQ("09:30:00.00025", formatTimeOfDay(nanos));
+            ASSERT_FALSE(parseTimeOfDay("9:30", nanos));
+            ASSERT_FALSE(parseTimeOfDay("25:00:00", nanos));
+        });
+        
+        // Test 3: Row and columnar consumers agree
+        suite.addTest("Columnar Consumers Match Row Consumers", []() {
+            std::vector<MarketData> rows;
+            for (int i = 0; i < 20; i++) {
+                MarketData md;
+                md.Time = 34200LL * NANOS_PER_SECOND;
+                md.Abb = knownSymbol((i % 3 == 0) ? "MSFT" : "AAPL");
+                md.price = Price::fromDouble(100.0 + i * 0.5);
+                md.volume = 100 + i;
+                rows.push_back(md);
+            }
+            TickStore store = TickStore::fromRows(rows);
+            
+            for (int periods = 1; periods <= 15; periods++) {
+                ASSERT_NEAR(calculateMovingAverage(rows, "AAPL", periods),
+                            calculateMovingAverage(store, "AAPL", periods), 1e-9);
+                ASSERT_NEAR(calculateMovingAverage(rows, "MSFT", periods),
+                            calculateMovingAverage(store, "MSFT", periods), 1e-9);
+            }
+            
+            MovingAvgStrat strategy(2, 5);
+            for (std::size_t i = 0; i < store.size(); i++) {
+                strategy.onTick(store.tick(i));
+            }
+            ASSERT_NEAR(calculateMovingAverage(rows, "AAPL", 5), strategy.longAverage(store.findSymbol("AAPL")), 1e-9);
+            
+            RiskManager riskManager(100000.0, 500000.0);
+            Order order("AAPL", OrderType::BUY, 10, 100.0);
+            order.status = OrderStatus::FILLED;
+            riskManager.updatePosition(order);
+            riskManager.updateMarketPrices(store);
+            ASSERT_EQ(rows.back().price, riskManager.getPosition("AAPL")->currentPrice);
+        });
+        
+        // Test 4: Binary tick file round trip
+        suite.addTest("Binary Tick File Round Trip", []() {
+            TickStore original;
+            original.append(34200LL * 1000000000LL, "AAPL", Price::fromDouble(150.25), 1000);
+            original.append(34201LL * 1000000000LL, "MSFT", Price::fromDouble(280.15), 2000);
+            original.append(34202LL * 1000000000LL, "AAPL", Price::fromDouble(150.30), 500);
+            
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_unit_test.ticks").string();
+            ASSERT_TRUE(writeBinaryTicks(path, original));
+            ASSERT_TRUE(isBinaryTickFile(path));
+            
+            TickStore loaded;
+            loaded.append(0, "STALE", Price::fromDouble(1.0), 1);
+            ASSERT_TRUE(loadData(loaded, path));
+            
+            ASSERT_EQ(original.size(), loaded.size());
+            ASSERT_TRUE(original.timestampColumn() == loaded.timestampColumn());
+            ASSERT_TRUE(original.priceColumn() == loaded.priceColumn());
+            ASSERT_TRUE(original.volumeColumn() == loaded.volumeColumn());
+            ASSERT_EQ(INVALID_SYMBOL, loaded.findSymbol("STALE"));
+            ASSERT_TRUE(original.rowsFor(0) == loaded.rowsFor(loaded.findSymbol("AAPL")));
+            
+            // Out-of-range symbol IDs or per-symbol rows must be rejected,
+            // leaving the store as it was
+            TickFileHeader header;
+            {
+                std::ifstream in(path, std::ios::binary);
+                in.read(reinterpret_cast<char*>(&header), sizeof(header));
+            }
+            const auto corruptAndLoad = [&](std::uint64_t offset, std::uint32_t value) {
+                std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+                std::uint32_t saved;
+                file.seekg(offset);
+                file.read(reinterpret_cast<char*>(&saved), sizeof(saved));
+                file.seekp(offset);
+                file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+                file.flush();
+                const bool accepted = loadBinaryTicks(path, loaded);
+                file.seekp(offset);
+                file.write(reinterpret_cast<const char*>(&saved), sizeof(saved));
+                return accepted;
+            };
+            static_assert(sizeof(SymbolId) == sizeof(std::uint32_t));
+            ASSERT_FALSE(corruptAndLoad(header.symbolIdOffset + sizeof(SymbolId), 1u << 30));
+            ASSERT_FALSE(corruptAndLoad(header.symbolRowsOffset, 3));
+            ASSERT_FALSE(corruptAndLoad(header.symbolRowsOffset, 1));  // in range, but an MSFT row
+            ASSERT_FALSE(corruptAndLoad(offsetof(TickFileHeader, symbolCount), 0xFFFFFFFFu));
+            ASSERT_FALSE(corruptAndLoad(offsetof(TickFileHeader, dictionaryOffset), 0));  // inside the header
+            ASSERT_EQ(original.size(), loaded.size());
+            ASSERT_TRUE(loadBinaryTicks(path, loaded));
+            
+            // A file from a future version must be rejected
+            {
+                std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+                std::uint32_t futureVersion = TICK_FILE_VERSION + 1;
+                file.seekp(offsetof(TickFileHeader, version));
+                file.write(reinterpret_cast<const char*>(&futureVersion), sizeof(futureVersion));
+            }
+            TickStore rejected;
+            ASSERT_FALSE(loadBinaryTicks(path, rejected));
+            std::filesystem::remove(path);
+        });
+        
+        // Test 5: Recent-price ring buffer
+        suite.addTest("Price Ring Wrap-Around", []() {
+            PriceRing<8> ring;
+            ASSERT_EQ(0.0, ring.average(1));
+            for (int i = 1; i <= 11; i++) {
+                ring.push(Price::fromDouble(i));  // ring now holds 4..11
+            }
+            ASSERT_EQ(8u, ring.size());
+            ASSERT_EQ(Price::fromDouble(11), ring.latest());
+            ASSERT_EQ(Price::fromDouble(4), ring.at(7));
+            ASSERT_NEAR(10.0, ring.average(3), 1e-12);   // 9, 10, 11
+            ASSERT_NEAR(7.5, ring.average(8), 1e-12);    // 4..11, crosses the wrap
+            ASSERT_EQ(0.0, ring.average(9));
+        });
+        
+        // Test 6: Ring-backed and row-backed averages agree beyond the ring capacity
+        suite.addTest("Moving Average Across Ring Capacity", []() {
+            std::vector<MarketData> rows;
+            for (int i = 0; i < 1000; i++) {
+                MarketData md;
+                md.Abb = knownSymbol((i % 2 == 0) ? "AAPL" : "MSFT");
+                md.price = Price::fromDouble(100.0 + (i % 37) * 0.25);
+                md.volume = 100;
+                rows.push_back(md);
+            }
+            TickStore store = TickStore::fromRows(rows);
+            
+            int windows[] = {1, 20, 255, 256, 257, 500, 501};
+            for (int periods : windows) {
+                ASSERT_NEAR(calculateMovingAverage(rows, "AAPL", periods),
+                            calculateMovingAverage(store, "AAPL", periods), 1e-9);
+            }
+        });
+        
+        // Test 7: Chunked parallel parse matches the sequential parser
+        suite.addTest("Parallel CSV Parse", []() {
+            const char* symbols[] = {"AAPL", "MSFT", "GOOG"};
+            std::string csv = "timestamp,symbol,price,volume\n";
+            for (int i = 0; i < 1000; i++) {
+                char line[64];
+                std::snprintf(line, sizeof(line), "09:%02d:%02d,%s,%d.%02d,%d\n",
+                              30 + i / 60 % 30, i % 60, symbols[(i * 7) % 3], 100 + i % 50, i % 100, i);
+                csv += line;
+            }
+            
+            ThreadPool pool(4);
+            TickStore sequential;
+            TickStore parallel;
+            ASSERT_EQ(1000u, parseTickCsv(csv.data(), csv.data() + csv.size(), sequential));
+            ASSERT_EQ(1000u, parseTickCsvParallel(csv.data(), csv.data() + csv.size(), parallel, pool));
+            ASSERT_TRUE(sequential.timestampColumn() == parallel.timestampColumn());
+            ASSERT_TRUE(sequential.symbolColumn() == parallel.symbolColumn());
+            ASSERT_TRUE(sequential.priceColumn() == parallel.priceColumn());
+            ASSERT_TRUE(sequential.volumeColumn() == parallel.volumeColumn());
+            ASSERT_EQ(std::string("MSFT"), parallel.symbolTable().name(1));
+            ASSERT_TRUE(sequential.rowsFor(2) == parallel.rowsFor(2));
+            
+            // Out-of-order input comes back in timestamp order, ties in file order
+            const std::string unordered =
+                "timestamp,symbol,price,volume\n"
+                "09:30:05,AAPL,1,1\n09:30:01,MSFT,2,2\n09:30:03,AAPL,3,3\n"
+                "09:30:01,GOOG,4,4\n09:30:00,AAPL,5,5\n09:30:03,MSFT,6,6\n";
+            TickStore merged;
+            ASSERT_EQ(6u, parseTickCsvParallel(unordered.data(), unordered.data() + unordered.size(), merged, pool));
+            const int expectedVolumes[] = {5, 2, 4, 3, 6, 1};
+            for (int i = 0; i < 6; i++) {
+                ASSERT_EQ(expectedVolumes[i], merged.volumeColumn()[i]);
+            }
+            ASSERT_EQ(0u, merged.findSymbol("AAPL"));
+            ASSERT_EQ(3u, merged.rowsFor(merged.findSymbol("AAPL")).size());
+            
+            // A file too small to split is parsed on the calling thread, in the same order
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_unit_test_unordered.csv").string();
+            {
+                std::ofstream out(path, std::ios::binary);
+                out << unordered;
+            }
+            TickStore small;
+            ASSERT_TRUE(loadTicksParallel(path, small));
+            ASSERT_TRUE(merged.timestampColumn() == small.timestampColumn());
+            ASSERT_TRUE(merged.volumeColumn() == small.volumeColumn());
+            ASSERT_TRUE(merged.rowsFor(merged.findSymbol("AAPL")) == small.rowsFor(small.findSymbol("AAPL")));
+            std::filesystem::remove(path);
+        });
+        
+        // Test 8: Dense IDs, the build-time universe and the global table
+        suite.addTest("Symbol Table Interning", []() {
+            static_assert(knownSymbol("TSLA") == 4);
+            for (SymbolId id = 0; id < KNOWN_SYMBOLS.size(); id++) {
+                ASSERT_EQ(id, KNOWN_SYMBOLS.find(KNOWN_SYMBOLS.name(id)));
+                ASSERT_EQ(id, findSymbolId(KNOWN_SYMBOL_NAMES[id]));
+            }
+            ASSERT_EQ(INVALID_SYMBOL, knownSymbol("AAP"));
+            ASSERT_EQ(INVALID_SYMBOL, knownSymbol("AAPLX"));
+            
+            // Enough names to force several rehashes
+            SymbolTable table;
+            for (int i = 0; i < 5000; i++) {
+                ASSERT_EQ(static_cast<SymbolId>(i), table.intern("S" + std::to_string(i)));
+            }
+            const std::string& first = table.name(0);
+            ASSERT_EQ(5000u, table.size());
+            ASSERT_EQ(4321u, table.find("S4321"));
+            ASSERT_EQ(4321u, table.intern("S4321"));
+            ASSERT_EQ(INVALID_SYMBOL, table.find("S5000"));
+            ASSERT_EQ(std::string("S0"), first);
+            ASSERT_TRUE(table.name(INVALID_SYMBOL).empty());
+            
+            // Orders, positions and ticks agree on one ID per ticker
+            SymbolId id = internSymbol("UNIT_TEST_SYM");
+            Order order("UNIT_TEST_SYM", OrderType::BUY, 10, Price::fromDouble(5.0));
+            order.status = OrderStatus::FILLED;
+            RiskManager riskManager;
+            riskManager.updatePosition(order);
+            TickStore store;
+            store.append(0, "UNIT_TEST_SYM", Price::fromDouble(5.5), 1);
+            riskManager.updateMarketPrices(store);
+            ASSERT_EQ(id, order.symbol);
+            ASSERT_EQ(id, store.findSymbol("UNIT_TEST_SYM"));
+            ASSERT_EQ(Price::fromDouble(5.5), riskManager.getPosition(id)->currentPrice);
+            ASSERT_EQ(std::string("UNIT_TEST_SYM"), symbolName(id));
+        });
+        
+        // Test 9: Compressed archive round trip, block seeks and corruption checks
+        suite.addTest("Compressed Archive Round Trip", []() {
+            TickStore original;
+            const char* symbols[] = {"AAPL", "MSFT", "ARCHIVE_TEST"};
+            std::int64_t cents[3] = {15025, 28015, 999};
+            std::int64_t timestamp = 34200LL * NANOS_PER_SECOND;
+            unsigned seed = 4242;
+            for (int i = 0; i < 10000; i++) {
+                seed = seed * 1103515245u + 12345u;
+                int s = (seed >> 16) % 3;
+                cents[s] += static_cast<int>((seed >> 8) % 21) - 10;
+                timestamp += (seed >> 4) % 3 == 0 ? 0 : (seed >> 6) % 5000000;  // repeated timestamps too
+                // Rows 3000-3999 carry sub-cent prices, so one block gets a finer price step
+                Price price = Price::fromRaw(cents[s] * 100 + ((i / 1000 == 3) ? (seed >> 3) % 100 : 0));
+                original.append(timestamp, symbols[s], price, static_cast<int>((seed >> 2) % 100000));
+            }
+            
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_unit_test.tarc").string();
+            ASSERT_TRUE(writeTickArchive(path, original, 1000));
+            ASSERT_TRUE(isTickArchive(path));
+            ASSERT_FALSE(isBinaryTickFile(path));
+            
+            TickStore loaded;
+            ASSERT_TRUE(loadData(loaded, path));
+            ASSERT_TRUE(original.timestampColumn() == loaded.timestampColumn());
+            ASSERT_TRUE(original.symbolColumn() == loaded.symbolColumn());
+            ASSERT_TRUE(original.priceColumn() == loaded.priceColumn());
+            ASSERT_TRUE(original.volumeColumn() == loaded.volumeColumn());
+            ASSERT_TRUE(original.rowsFor(knownSymbol("MSFT")) == loaded.rowsFor(knownSymbol("MSFT")));
+            
+            TickArchive archive;
+            ASSERT_TRUE(archive.open(path));
+            ASSERT_EQ(10u, archive.index().size());
+            ASSERT_EQ(1, archive.index()[3].priceTick);
+            ASSERT_TRUE(archive.index()[0].priceTick % 100 == 0);
+            ASSERT_TRUE(archive.compressedBytes() * 3 < original.size() * 24);
+            
+            // A time range decodes only the blocks it overlaps and keeps exactly its rows
+            const auto& times = original.timestampColumn();
+            const std::int64_t from = times[4500];
+            const std::int64_t to = times[6200];
+            ASSERT_EQ(4u, archive.findBlock(from));
+            TickStore range;
+            ASSERT_TRUE(archive.loadRange(from, to, range));
+            std::size_t expected = 0;
+            for (std::int64_t t : times) expected += (t >= from && t < to);
+            ASSERT_EQ(expected, range.size());
+            ASSERT_EQ(from, range.timestampColumn().front());
+            archive.close();
+            
+            // Blocks larger than the header's block size are rejected
+            {
+                std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+                std::uint32_t smallerBlocks = 999;
+                file.seekp(offsetof(TickArchiveHeader, blockRows));
+                file.write(reinterpret_cast<const char*>(&smallerBlocks), sizeof(smallerBlocks));
+            }
+            ASSERT_FALSE(archive.open(path));
+            
+            // A truncated file fails validation instead of decoding garbage
+            ASSERT_TRUE(writeTickArchive(path, original, 1000));
+            std::filesystem::resize_file(path, std::filesystem::file_size(path) - 100);
+            ASSERT_FALSE(archive.open(path));
+            
+            // Out of time order, block seeks fall back to a scan
+            TickStore unordered;
+            for (std::int64_t t : {20, 200, 10, 400}) unordered.append(t, "AAPL", Price::fromDouble(1.0), 1);
+            ASSERT_TRUE(writeTickArchive(path, unordered, 1));
+            ASSERT_TRUE(archive.open(path));
+            ASSERT_EQ(1u, archive.findBlock(100));
+            ASSERT_EQ(4u, archive.findBlock(500));
+            archive.close();
+            std::filesystem::remove(path);
+        });
+        
+        // Test 10: Indexed range queries agree with a scan, late trades included
+        suite.addTest("Time Range Queries Match Scan", []() {
+            TickStore store;
+            unsigned seed = 4242;
+            std::int64_t clock = 34200LL * NANOS_PER_SECOND;
+            for (int i = 0; i < 3000; i++) {
+                seed = seed * 1103515245u + 12345u;
+                clock += (seed >> 8) % 50000000;
+                // Every 10th trade arrives up to 0.5s late; every 7th repeats the previous time
+                std::int64_t timestamp = (i % 10 == 9) ? clock - (seed >> 4) % 500000000 : clock;
+                if (i % 7 == 6) timestamp = store.timestampColumn().back();
+                store.append(timestamp, static_cast<SymbolId>((seed >> 16) % 3), Price::fromRaw(1000000 + (seed >> 4) % 5000),
+                             1 + static_cast<int>((seed >> 12) % 400));
+            }
+            TickIndex index;
+            index.update(store);
+            ASSERT_EQ(store.size(), index.size());
+            
+            for (SymbolId symbol = 0; symbol < 3; symbol++) {
+                // Reference: the symbol's trades stably sorted by time
+                std::vector<std::size_t> rows;
+                for (std::uint32_t row : store.rowsFor(symbol)) rows.push_back(row);
+                const auto& times = store.timestampColumn();
+                std::stable_sort(rows.begin(), rows.end(), [&](std::size_t a, std::size_t b) { return times[a] < times[b]; });
+                ASSERT_EQ(rows.size(), index.size(symbol));
+                
+                for (int q = 0; q < 200; q++) {
+                    seed = seed * 1103515245u + 12345u;
+                    std::int64_t from = times[rows.front()] - NANOS_PER_SECOND + (seed >> 4) % (60 * NANOS_PER_SECOND);
+                    std::int64_t to = from + (seed >> 9) % (30 * NANOS_PER_SECOND);
+                    if (q % 20 == 0) to = from;  // empty range
+                    
+                    std::size_t count = 0;
+                    std::int64_t volume = 0;
+                    double notional = 0.0;
+                    Price first, last;
+                    for (std::size_t row : rows) {
+                        if (times[row] < from || times[row] >= to) continue;
+                        if (count++ == 0) first = store.priceColumn()[row];
+                        last = store.priceColumn()[row];
+                        volume += store.volumeColumn()[row];
+                        notional += store.priceColumn()[row].toDouble() * store.volumeColumn()[row];
+                    }
+                    // Price held from each trade to the next, inside [from, to) and the trading span
+                    const std::int64_t lo = std::max(from, times[rows.front()]);
+                    const std::int64_t hi = std::min(to, times[rows.back()]);
+                    double twap = 0.0;
+                    if (from >= to) {
+                        // nothing in force over an empty range
+                    } else if (hi > lo) {
+                        for (std::size_t i = 0; i + 1 < rows.size(); i++) {
+                            std::int64_t held = std::min(hi, times[rows[i + 1]]) - std::max(lo, times[rows[i]]);
+                            if (held > 0) twap += store.priceColumn()[rows[i]].toDouble() * held;
+                        }
+                        twap /= hi - lo;
+                    } else if (to > times[rows.front()]) {
+                        Price held;
+                        ASSERT_TRUE(index.priceAt(symbol, lo, held));
+                        twap = held.toDouble();
+                    }
+                    
+                    RangeStats stats = index.query(symbol, from, to);
+                    ASSERT_EQ(count, stats.count);
+                    ASSERT_EQ(count, index.count(symbol, from, to));
+                    ASSERT_EQ(volume, stats.volume);
+                    ASSERT_EQ(volume, index.volume(symbol, from, to));
+                    ASSERT_NEAR(volume > 0 ? notional / volume : 0.0, stats.vwap, 1e-9);
+                    ASSERT_NEAR(twap, stats.twap, 1e-9);
+                    if (count > 0) {
+                        ASSERT_EQ(first, stats.first);
+                        ASSERT_EQ(last, stats.last);
+                    }
+                }
+                
+                Price price;
+                ASSERT_FALSE(index.priceAt(symbol, times[rows.front()] - 1, price));
+                ASSERT_TRUE(index.priceAt(symbol, times[rows.back()] + NANOS_PER_SECOND, price));
+                ASSERT_EQ(store.priceColumn()[rows.back()], price);
+                ASSERT_EQ(rows.size(), index.lowerBound(symbol, times[rows.back()] + 1));
+            }
+            
+            // Appends are picked up incrementally; a replaced store starts over
+            store.append(store.timestampColumn().back() + 1, "NFLX", Price::fromDouble(400.0), 10);
+            index.update(store);
+            ASSERT_EQ(1u, index.size(knownSymbol("NFLX")));
+            ASSERT_NEAR(400.0, index.vwap(knownSymbol("NFLX"), 0, INT64_MAX), 1e-9);
+            store.clear();
+            index.update(store);
+            ASSERT_EQ(0u, index.size());
+            ASSERT_EQ(0, index.volume(0, 0, INT64_MAX));
+        });
+        
+        suite.runAll();
+    }
+    
+    static void testRollingIndicators() {
+        TestSuite suite("Rolling Indicators");
+        
+        // Test 1: Incremental SMA agrees with the batch calculation at every step
+        suite.addTest("SMA Matches Batch Calculation", []() {
+            const char* symbols[] = {"AAPL", "MSFT", "GOOG", "AMZN", "TSLA", "NVDA", "META"};
+            const std::size_t windows[] = {2, 3, 20, 100};
+            RollingIndicatorEngine engine({2, 3, 20, 100});
+            
+            std::vector<MarketData> rows;
+            rows.reserve(20000);
+            double price[7] = {150, 280, 120, 130, 250, 450, 300};
+            unsigned seed = 12345;
+            for (int i = 0; i < 20000; i++) {
+                seed = seed * 1103515245u + 12345u;
+                int s = (seed >> 16) % 7;
+                price[s] += (static_cast<int>((seed >> 8) % 201) - 100) * 0.01;
+                
+                MarketData md;
+                md.Abb = internSymbol(symbols[s]);
+                md.price = Price::fromDouble(price[s]);
+                rows.push_back(md);
+                engine.update(rows);
+                
+                if (i % 97 == 0) {
+                    SymbolId id = findSymbolId(symbols[s]);
+                    for (std::size_t w : windows) {
+                        ASSERT_NEAR(calculateMovingAverage(rows, symbols[s], static_cast<int>(w)), engine.sma(id, w), 1e-9);
+                    }
+                }
+            }
+        });
+        
+        // Test 2: Sliding variance and EMA agree with direct computation
+        suite.addTest("Variance And EMA Match Batch", []() {
+            const std::size_t window = 50;
+            RollingWindow rolling(window);
+            std::vector<double> prices;
+            double ema = 0.0;
+            const double alpha = 2.0 / (window + 1.0);
+            
+            for (int i = 0; i < 5000; i++) {
+                double p = 1000.0 + 5.0 * std::sin(i * 0.1) + (i % 7) * 0.01;
+                prices.push_back(p);
+                rolling.update(p);
+                ema = (i == 0) ? p : ema + alpha * (p - ema);
+                
+                std::size_t n = std::min(window, prices.size());
+                double mean = 0.0;
+                for (std::size_t k = prices.size() - n; k < prices.size(); k++) mean += prices[k];
+                mean /= n;
+                double var = 0.0;
+                for (std::size_t k = prices.size() - n; k < prices.size(); k++) var += (prices[k] - mean) * (prices[k] - mean);
+                var /= n;
+                
+                ASSERT_NEAR(var, rolling.variance(), 1e-8);
+                ASSERT_NEAR(ema, rolling.ema(), 1e-9);
+            }
+            ASSERT_TRUE(rolling.ready());
+        });
+        
+        // Test 3: Engine catches up on a growing store and restarts on a new one
+        suite.addTest("Incremental Catch-Up", []() {
+            RollingIndicatorEngine engine({3});
+            TickStore store;
+            store.append(0, "AAPL", Price::fromDouble(100.0), 1);
+            store.append(1, "AAPL", Price::fromDouble(101.0), 1);
+            engine.update(store);
+            ASSERT_EQ(0.0, engine.sma(0, 3));
+            
+            store.append(2, "AAPL", Price::fromDouble(105.0), 1);
+            engine.update(store);
+            ASSERT_NEAR(102.0, engine.sma(0, 3), 1e-12);
+            ASSERT_EQ(nullptr, engine.window(0, 4));
+            
+            store.clear();
+            store.append(0, "AAPL", Price::fromDouble(50.0), 1);
+            engine.update(store);
+            ASSERT_EQ(0.0, engine.sma(0, 3));
+            ASSERT_NEAR(50.0, engine.ema(0, 3), 1e-12);
+        });
+        
+        // Test 4: Every supported SIMD level agrees with the scalar kernels, tails included
+        suite.addTest("SIMD Kernels Match Scalar", []() {
+            const IndicatorKernels& scalar = indicatorKernels(SimdLevel::SCALAR);
+            const SimdLevel levels[] = {SimdLevel::AVX2, SimdLevel::AVX512};
+            
+            for (std::size_t n : {1u, 7u, 13u, 31u, 1003u, 10007u}) {
+                std::vector<std::int64_t> raw(n);
+                std::vector<double> prices(n);
+                std::vector<int> volumes(n);
+                unsigned seed = 777 + static_cast<unsigned>(n);
+                std::int64_t units = 1500000;
+                for (std::size_t i = 0; i < n; i++) {
+                    seed = seed * 1103515245u + 12345u;
+                    units += static_cast<int>((seed >> 16) % 201) - 100;
+                    raw[i] = units;
+                    prices[i] = Price::fromRaw(units).toDouble();
+                    volumes[i] = 1 + static_cast<int>((seed >> 8) % 5000);
+                }
+                const std::size_t window = std::min<std::size_t>(20, n);
+                
+                std::vector<double> expected(n), actual(n);
+                for (SimdLevel level : levels) {
+                    if (!simdLevelSupported(level)) continue;
+                    const IndicatorKernels& simd = indicatorKernels(level);
+                    ASSERT_TRUE(simd.level == level);
+                    
+                    ASSERT_NEAR(scalar.sum(prices.data(), n), simd.sum(prices.data(), n), 1e-6);
+                    ASSERT_EQ(scalar.sumFixed(raw.data(), n), simd.sumFixed(raw.data(), n));
+                    
+                    double lo1, hi1, lo2, hi2;
+                    scalar.minMax(prices.data(), n, lo1, hi1);
+                    simd.minMax(prices.data(), n, lo2, hi2);
+                    ASSERT_EQ(lo1, lo2);
+                    ASSERT_EQ(hi1, hi2);
+                    std::int64_t rlo1, rhi1, rlo2, rhi2;
+                    scalar.minMaxFixed(raw.data(), n, rlo1, rhi1);
+                    simd.minMaxFixed(raw.data(), n, rlo2, rhi2);
+                    ASSERT_EQ(rlo1, rlo2);
+                    ASSERT_EQ(rhi1, rhi2);
+                    
+                    ASSERT_NEAR(scalar.vwap(prices.data(), volumes.data(), n), simd.vwap(prices.data(), volumes.data(), n), 1e-9);
+                    ASSERT_NEAR(scalar.vwapFixed(raw.data(), volumes.data(), n), simd.vwapFixed(raw.data(), volumes.data(), n), 1e-9);
+                    
+                    scalar.toDouble(raw.data(), n, expected.data());
+                    simd.toDouble(raw.data(), n, actual.data());
+                    for (std::size_t i = 0; i < n; i++) ASSERT_EQ(expected[i], actual[i]);
+                    
+                    if (n > 1) {
+                        scalar.returns(prices.data(), n, expected.data());
+                        simd.returns(prices.data(), n, actual.data());
+                        for (std::size_t i = 0; i + 1 < n; i++) ASSERT_NEAR(expected[i], actual[i], 1e-15);
+                    }
+                    
+                    scalar.rollingMean(prices.data(), n, window, expected.data());
+                    simd.rollingMean(prices.data(), n, window, actual.data());
+                    for (std::size_t i = 0; i < n; i++) ASSERT_NEAR(expected[i], actual[i], 1e-9);
+                    
+                    scalar.rollingStddev(prices.data(), n, window, expected.data());
+                    simd.rollingStddev(prices.data(), n, window, actual.data());
+                    for (std::size_t i = 0; i < n; i++) ASSERT_NEAR(expected[i], actual[i], 1e-6);
+                    
+                    scalar.ema(prices.data(), n, 2.0 / 21.0, expected.data());
+                    simd.ema(prices.data(), n, 2.0 / 21.0, actual.data());
+                    for (std::size_t i = 0; i < n; i++) ASSERT_NEAR(expected[i], actual[i], 1e-9);
+                }
+            }
+            
+            // PriceHistory windows sum through the kernels and stay exact
+            std::vector<Price> column = {Price::fromDouble(1.25), Price::fromDouble(2.50), Price::fromDouble(-0.75)};
+            ASSERT_EQ(Price::fromDouble(3.00), sumPrices(column.data(), column.size()));
+        });
+        
+        // Test 5: Streaming bars agree with a batch rebuild from the whole tape
+        suite.addTest("OHLCV Bars Match Batch Rebuild", []() {
+            const std::vector<BarSpec> specs = {BarSpec::seconds(1), BarSpec::ticks(5), BarSpec::volume(1000)};
+            BarAggregator bars(specs, 1024);
+            std::vector<std::vector<Bar>> streamed(3 * specs.size());
+            bars.subscribe([&](const Bar& bar, std::size_t series) {
+                streamed[bar.symbol * specs.size() + series].push_back(bar);
+            });
+            
+            std::vector<Tick> tape;
+            unsigned seed = 777;
+            std::int64_t timestamp = 34200LL * NANOS_PER_SECOND;
+            for (int i = 0; i < 5000; i++) {
+                seed = seed * 1103515245u + 12345u;
+                timestamp += (seed >> 8) % 200000000;  // up to 0.2s apart, so some seconds are empty
+                Tick tick{timestamp, (seed >> 16) % 3, Price::fromRaw(1000000 + (seed >> 4) % 5000), 1 + static_cast<int>((seed >> 12) % 400)};
+                tape.push_back(tick);
+                bars.onTick(tick);
+            }
+            
+            auto sameBar = [](const Bar& a, const Bar& b) {
+                return a.start == b.start && a.end == b.end && a.symbol == b.symbol && a.ticks == b.ticks &&
+                       a.open == b.open && a.high == b.high && a.low == b.low && a.close == b.close && a.volume == b.volume;
+            };
+            for (SymbolId symbol = 0; symbol < 3; symbol++) {
+                for (std::size_t series = 0; series < specs.size(); series++) {
+                    const BarSpec spec = specs[series];
+                    std::vector<Bar> closed;
+                    Bar open{};
+                    for (const Tick& t : tape) {
+                        if (t.symbol != symbol) continue;
+                        const std::int64_t bucket = t.timestamp / spec.size;
+                        if (spec.type == BarType::TIME && open.ticks != 0 && bucket != open.start / spec.size) {
+                            closed.push_back(open);
+                            open = Bar{};
+                        }
+                        if (open.ticks == 0) {
+                            open = {spec.type == BarType::TIME ? bucket * spec.size : t.timestamp, t.timestamp, symbol, 0,
+                                    t.price, t.price, t.price, t.price, 0};
+                        }
+                        open.high = std::max(open.high, t.price);
+                        open.low = std::min(open.low, t.price);
+                        open.close = t.price;
+                        open.end = t.timestamp;
+                        open.volume += t.volume;
+                        open.ticks++;
+                        if ((spec.type == BarType::TICK && open.ticks >= spec.size) ||
+                            (spec.type == BarType::VOLUME && open.volume >= spec.size)) {
+                            closed.push_back(open);
+                            open = Bar{};
+                        }
+                    }
+                    
+                    const auto& actual = streamed[symbol * specs.size() + series];
+                    ASSERT_EQ(closed.size(), actual.size());
+                    for (std::size_t i = 0; i < closed.size(); i++) ASSERT_TRUE(sameBar(closed[i], actual[i]));
+                    ASSERT_EQ(std::min<std::size_t>(closed.size(), 1024), bars.barCount(symbol, series));
+                    ASSERT_TRUE(sameBar(closed.back(), bars.bar(symbol, series)));
+                    const Bar* building = bars.current(symbol, series);
+                    ASSERT_EQ(open.ticks != 0, building != nullptr);
+                    if (building != nullptr) ASSERT_TRUE(sameBar(open, *building));
+                }
+            }
+        });
+        
+        // Test 6: Bounded history, timer closes, strategies and store catch-up
+        suite.addTest("Bar Rings And Subscribers", []() {
+            struct BarCounter : Strategy {
+                int bars = 0;
+                void onTick(const Tick&) override {}
+                void onBar(const Bar&, std::size_t) override { bars++; }
+                std::string getStratName() const override { return "Bar Counter"; }
+            } counter;
+            
+            BarAggregator bars({BarSpec::ticks(2), BarSpec::minutes(1)}, 3);  // rounded up to 4
+            bars.subscribe(counter);
+            ASSERT_EQ(4u, bars.historyPerSeries());
+            
+            TickStore store;
+            const std::int64_t open = 34200LL * NANOS_PER_SECOND;
+            for (int i = 0; i < 20; i++) {
+                store.append(open + i * NANOS_PER_SECOND, "AAPL", Price::fromDouble(100.0 + i), 10);
+            }
+            bars.update(store);
+            bars.update(store);  // nothing new
+            const SymbolId aapl = store.findSymbol("AAPL");
+            ASSERT_EQ(10u, bars.completedBars());
+            ASSERT_EQ(4u, bars.barCount(aapl, 0));
+            ASSERT_EQ(Price::fromDouble(119.0), bars.bar(aapl, 0).close);
+            ASSERT_EQ(Price::fromDouble(112.0), bars.bar(aapl, 0, 3).open);
+            ASSERT_EQ(0u, bars.barCount(aapl, 1));
+            
+            // A quiet minute is closed by the timer, not by the next trade
+            bars.closeElapsed(open + 59 * NANOS_PER_SECOND);
+            ASSERT_EQ(0u, bars.barCount(aapl, 1));
+            bars.closeElapsed(open + 60 * NANOS_PER_SECOND);
+            ASSERT_EQ(1u, bars.barCount(aapl, 1));
+            ASSERT_EQ(200, bars.bar(aapl, 1).volume);
+            ASSERT_EQ(20u, bars.bar(aapl, 1).ticks);
+            ASSERT_TRUE(bars.current(aapl, 1) == nullptr);
+            ASSERT_EQ(11, counter.bars);
+            
+            // A replaced store starts the bars over
+            store.clear();
+            store.append(open, "MSFT", Price::fromDouble(50.0), 5);
+            bars.update(store);
+            ASSERT_EQ(0u, bars.barCount(aapl, 0));
+            ASSERT_TRUE(bars.current(store.findSymbol("MSFT"), 0) != nullptr);
+            
+            // Zero-size specs are refused up front
+            bool rejected = false;
+            try {
+                BarAggregator broken({BarSpec::ticks(5), BarSpec::seconds(0)});
+            } catch (const std::invalid_argument&) {
+                rejected = true;
+            }
+            ASSERT_TRUE(rejected);
+        });
+        
+        suite.runAll();
+    }
+    
+    static void testOrderBook() {
+        TestSuite suite("Order Book");
+        
+        // Test 1: Touch tracking, level removal across bitmap words and top-N depth
+        suite.addTest("Best Bid/Ask And Depth", []() {
+            OrderBook book;
+            ASSERT_FALSE(book.hasBid());
+            ASSERT_TRUE(book.update(BookSide::BID, Price::fromDouble(100.00), 500));
+            ASSERT_TRUE(book.update(BookSide::BID, Price::fromDouble(99.20), 300));   // 80 ticks deeper
+            ASSERT_TRUE(book.update(BookSide::BID, Price::fromDouble(99.99), 200));
+            ASSERT_TRUE(book.update(BookSide::ASK, Price::fromDouble(100.02), 100));
+            ASSERT_TRUE(book.update(BookSide::ASK, Price::fromDouble(101.00), 700));
+            ASSERT_FALSE(book.update(BookSide::ASK, Price::fromDouble(100.015), 100)); // off tick
+            
+            ASSERT_EQ(Price::fromDouble(100.00), book.bestBid());
+            ASSERT_EQ(Price::fromDouble(100.02), book.bestAsk());
+            ASSERT_EQ(Price::fromDouble(100.01), book.mid());
+            ASSERT_EQ(Price::fromDouble(0.02), book.spread());
+            ASSERT_EQ(500, book.bestBidQuantity());
+            
+            // Removing the touch falls back to the next level, even 80 ticks away
+            ASSERT_TRUE(book.update(BookSide::BID, Price::fromDouble(100.00), 0));
+            ASSERT_TRUE(book.update(BookSide::BID, Price::fromDouble(99.99), 0));
+            ASSERT_EQ(Price::fromDouble(99.20), book.bestBid());
+            ASSERT_TRUE(book.adjust(BookSide::BID, Price::fromDouble(99.20), -300));
+            ASSERT_FALSE(book.hasBid());
+            ASSERT_TRUE(book.update(BookSide::BID, Price::fromDouble(99.50), 10));
+            
+            std::vector<BookLevel> asks = book.depth(BookSide::ASK, 5);
+            ASSERT_EQ(2u, asks.size());
+            ASSERT_EQ(Price::fromDouble(100.02), asks[0].price);
+            ASSERT_EQ(Price::fromDouble(101.00), asks[1].price);
+            ASSERT_EQ(700, asks[1].quantity);
+            ASSERT_EQ(700, book.quantityAt(BookSide::ASK, Price::fromDouble(101.00)));
+            ASSERT_EQ(1u, book.levelCount(BookSide::BID));
+        });
+        
+        // Test 2: A touch beyond the window re-centres it; deeper levels are not kept
+        suite.addTest("Window Re-Centring", []() {
+            OrderBook book(Price::fromDouble(0.01), 128);
+            ASSERT_EQ(128u, book.windowLevels());
+            book.update(BookSide::BID, Price::fromDouble(50.00), 100);
+            book.update(BookSide::ASK, Price::fromDouble(50.01), 100);
+            book.update(BookSide::BID, Price::fromDouble(49.90), 100);
+            
+            // Far below the window and not a new touch: dropped
+            ASSERT_FALSE(book.update(BookSide::BID, Price::fromDouble(45.00), 100));
+            ASSERT_EQ(1u, book.droppedUpdates());
+            
+            // The ask lifts past the window: it re-centres between both touches
+            ASSERT_TRUE(book.update(BookSide::ASK, Price::fromDouble(50.01), 0));
+            ASSERT_TRUE(book.update(BookSide::ASK, Price::fromDouble(50.70), 50));
+            ASSERT_EQ(Price::fromDouble(50.70), book.bestAsk());
+            ASSERT_EQ(Price::fromDouble(50.00), book.bestBid());
+            ASSERT_EQ(100, book.quantityAt(BookSide::BID, Price::fromDouble(49.90)));
+            ASSERT_TRUE(book.update(BookSide::BID, Price::fromDouble(50.65), 100));
+            ASSERT_EQ(Price::fromDouble(50.65), book.bestBid());
+            ASSERT_FALSE(book.update(BookSide::ASK, Price::fromDouble(60.00), 10));
+            ASSERT_EQ(2u, book.droppedUpdates());
+            
+            // A large jump keeps the new touch and forgets what fell off the window
+            ASSERT_TRUE(book.update(BookSide::BID, Price::fromDouble(80.00), 10));
+            ASSERT_EQ(Price::fromDouble(80.00), book.bestBid());
+            ASSERT_EQ(1u, book.levelCount(BookSide::BID));
+            ASSERT_FALSE(book.hasAsk());
+            ASSERT_EQ(0, book.quantityAt(BookSide::BID, Price::fromDouble(50.65)));
+        });
+        
+        // Test 3: Open-addressing map survives growth and backward-shift deletes
+        suite.addTest("Flat ID Map", []() {
+            FlatIdMap<std::uint64_t> map(16);
+            std::map<std::uint64_t, std::uint64_t> reference;
+            unsigned seed = 5;
+            for (int i = 0; i < 20000; i++) {
+                seed = seed * 1103515245u + 12345u;
+                std::uint64_t key = (seed >> 8) % 3000;
+                if ((seed >> 4) % 3 == 0) {
+                    ASSERT_EQ(reference.erase(key) == 1, map.erase(key));
+                } else {
+                    ASSERT_EQ(reference.emplace(key, i).second, map.insert(key, i));
+                }
+            }
+            ASSERT_EQ(reference.size(), map.size());
+            for (const auto& entry : reference) {
+                const std::uint64_t* value = map.find(entry.first);
+                ASSERT_TRUE(value != nullptr);
+                ASSERT_EQ(entry.second, *value);
+            }
+            ASSERT_TRUE(map.find(5000) == nullptr);
+        });
+        
+        // Test 4: L3 queues keep time priority and drive the L2 levels
+        suite.addTest("L3 FIFO Priority And Aggregates", []() {
+            L3OrderBook book;
+            const Price bid = Price::fromDouble(100.00);
+            ASSERT_TRUE(book.add(1, BookSide::BID, bid, 100));
+            ASSERT_TRUE(book.add(2, BookSide::BID, bid, 200));
+            ASSERT_TRUE(book.add(3, BookSide::BID, bid, 300));
+            ASSERT_TRUE(book.add(4, BookSide::ASK, Price::fromDouble(100.05), 50));
+            ASSERT_FALSE(book.add(2, BookSide::BID, bid, 10));                      // duplicate ID
+            ASSERT_FALSE(book.add(9, BookSide::BID, Price::fromDouble(99.995), 10)); // off tick
+            
+            ASSERT_EQ(600, book.levels().bestBidQuantity());
+            ASSERT_EQ(300, book.queueAhead(3));
+            ASSERT_EQ(1u, book.level(BookSide::BID, bid)->head->id);
+            
+            // Execution eats the front of the queue
+            ASSERT_TRUE(book.execute(1, 100));
+            ASSERT_TRUE(book.find(1) == nullptr);
+            ASSERT_EQ(200, book.queueAhead(3));
+            
+            // Shrinking in place keeps priority, growing loses it
+            ASSERT_TRUE(book.modify(2, bid, 150));
+            ASSERT_EQ(2u, book.level(BookSide::BID, bid)->head->id);
+            ASSERT_TRUE(book.modify(2, bid, 400));
+            ASSERT_EQ(3u, book.level(BookSide::BID, bid)->head->id);
+            ASSERT_EQ(300, book.queueAhead(2));
+            ASSERT_EQ(700, book.levels().bestBidQuantity());
+            
+            // Replace moves the order to a new ID and price
+            ASSERT_TRUE(book.replace(3, 7, Price::fromDouble(100.01), 300));
+            ASSERT_EQ(Price::fromDouble(100.01), book.levels().bestBid());
+            ASSERT_EQ(400, book.levels().quantityAt(BookSide::BID, bid));
+            // A replace that cannot take its new ID leaves the old order alone
+            ASSERT_FALSE(book.replace(7, FlatIdMap<L3Order*>::EMPTY_KEY, Price::fromDouble(100.02), 300));
+            ASSERT_EQ(300, book.find(7)->quantity);
+            ASSERT_EQ(Price::fromDouble(100.01), book.levels().bestBid());
+            ASSERT_TRUE(book.cancel(7, 100));
+            ASSERT_EQ(200, book.find(7)->quantity);
+            ASSERT_TRUE(book.remove(7));
+            ASSERT_FALSE(book.remove(7));
+            ASSERT_EQ(bid, book.levels().bestBid());
+            
+            ASSERT_TRUE(book.remove(2));
+            ASSERT_TRUE(book.level(BookSide::BID, bid) == nullptr);
+            ASSERT_FALSE(book.levels().hasBid());
+            ASSERT_EQ(1u, book.orderCount());
+            ASSERT_EQ(100u, book.sharesExecuted());
+        });
+        
+        // Test 5: After a long random replay, L2 totals equal the live orders summed per level
+        suite.addTest("L3 Replay Matches Rebuilt Levels", []() {
+            std::vector<OrderBookEvent> feed;
+            synthesizeOrderFlow(200000, feed, 0, 2000, 11);
+            L3OrderBook book;
+            for (const OrderBookEvent& event : feed) {
+                ASSERT_TRUE(book.apply(event));
+            }
+            
+            std::map<std::pair<int, std::int64_t>, std::int64_t> totals;
+            std::size_t orders = 0;
+            for (BookSide side : {BookSide::BID, BookSide::ASK}) {
+                for (const BookLevel& lvl : book.levels().depth(side, 1000)) {
+                    const L3Level* level = book.level(side, lvl.price);
+                    ASSERT_TRUE(level != nullptr);
+                    std::int64_t sum = 0;
+                    std::uint32_t count = 0;
+                    for (const L3Order* o = level->head; o != nullptr; o = o->next) {
+                        sum += o->quantity;
+                        count++;
+                        ASSERT_TRUE(o->next == nullptr || o->next->prev == o);
+                    }
+                    ASSERT_EQ(lvl.quantity, sum);
+                    ASSERT_EQ(level->orders, count);
+                    orders += count;
+                }
+            }
+            ASSERT_EQ(book.orderCount(), orders);
+        });
+        
+        // Test 6: Big-endian views decode hand-built messages; truncation is reported
+        suite.addTest("ITCH Message Decoding", []() {
+            // 'A' add order: locate 3, ts 09:30:00.000000001, ref 0x0102030405060708, buy 300 MSFT @ 280.1500
+            const unsigned char add[] = {
+                0x00, 0x24, 'A', 0x00, 0x03, 0x00, 0x00,
+                0x1F, 0x1A, 0xCE, 0xD9, 0xF0, 0x01,
+                0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 'B', 0x00, 0x00, 0x01, 0x2C,
+                'M', 'S', 'F', 'T', ' ', ' ', ' ', ' ', 0x00, 0x2A, 0xBF, 0x5C};
+            const char* bytes = reinterpret_cast<const char*>(add);
+            
+            struct Capture : itch::Handler {
+                int adds = 0;
+                std::uint64_t ref = 0;
+                std::int64_t timestamp = 0;
+                std::string stock;
+                std::uint32_t shares = 0, price = 0;
+                bool buy = false;
+                void onAddOrder(const itch::AddOrder& m) {
+                    adds++;
+                    ref = m.orderRef();
+                    timestamp = m.timestamp();
+                    stock = std::string(m.stock());
+                    shares = m.shares();
+                    price = m.price();
+                    buy = m.isBuy();
+                    ASSERT_EQ(3, m.stockLocate());
+                }
+            } capture;
+            
+            itch::DecodeResult result = itch::decode(bytes, bytes + sizeof(add), capture);
+            ASSERT_TRUE(result.complete);
+            ASSERT_EQ(1u, result.messages);
+            ASSERT_EQ(1, capture.adds);
+            ASSERT_EQ(0x0102030405060708ULL, capture.ref);
+            ASSERT_EQ(34200LL * NANOS_PER_SECOND + 1, capture.timestamp);
+            ASSERT_EQ(std::string("MSFT"), capture.stock);
+            ASSERT_EQ(300u, capture.shares);
+            ASSERT_EQ(Price::fromDouble(280.15), Price::fromRaw(capture.price));
+            ASSERT_TRUE(capture.buy);
+            
+            result = itch::decode(bytes, bytes + sizeof(add) - 1, capture);
+            ASSERT_FALSE(result.complete);
+            ASSERT_EQ(0u, result.messages);
+        });
+        
+        // Test 7: A generated capture rebuilds consistent books and a trade tape
+        suite.addTest("ITCH Capture Into Books And Ticks", []() {
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_itch_unit.itch").string();
+            ASSERT_TRUE(generateItchFile(path, 200000, 3, 7));
+            ASSERT_TRUE(isItchFile(path));
+            
+            struct Counter : itch::Handler {
+                std::size_t bytes = 0, printed = 0;
+                void count(std::size_t length) { bytes += 2 + length; }
+                void onSystemEvent(const itch::SystemEvent&) { count(itch::SystemEvent::LENGTH); }
+                void onStockDirectory(const itch::StockDirectory&) { count(itch::StockDirectory::LENGTH); }
+                void onAddOrder(const itch::AddOrder&) { count(itch::AddOrder::LENGTH); }
+                void onAddOrderMpid(const itch::AddOrderMpid&) { count(itch::AddOrderMpid::LENGTH); }
+                void onOrderExecuted(const itch::OrderExecuted&) { count(itch::OrderExecuted::LENGTH); printed++; }
+                void onOrderExecutedWithPrice(const itch::OrderExecutedWithPrice& m) {
+                    count(itch::OrderExecutedWithPrice::LENGTH);
+                    printed += m.printable();
+                }
+                void onOrderCancel(const itch::OrderCancel&) { count(itch::OrderCancel::LENGTH); }
+                void onOrderDelete(const itch::OrderDelete&) { count(itch::OrderDelete::LENGTH); }
+                void onOrderReplace(const itch::OrderReplace&) { count(itch::OrderReplace::LENGTH); }
+            } counter;
+            
+            MappedFile file(path);
+            itch::DecodeResult result = itch::decode(file.data(), file.end(), counter);
+            ASSERT_TRUE(result.complete);
+            ASSERT_EQ(0u, result.unknown + result.malformed);
+            ASSERT_EQ(200000u + 4u, result.messages);
+            ASSERT_EQ(file.size(), counter.bytes);  // every message has exactly its spec length
+            
+            TickStore ticks;
+            ItchBookBuilder builder(ticks);
+            ASSERT_TRUE(loadItchFile(path, builder));
+            ASSERT_EQ(0u, builder.rejectedEvents());
+            ASSERT_EQ(counter.printed, ticks.size());
+            ASSERT_EQ(3u, ticks.symbolCount());
+            for (const char* symbol : {"AAPL", "MSFT", "GOOG"}) {
+                const L3OrderBook* book = builder.book(symbol);
+                ASSERT_TRUE(book != nullptr);
+                ASSERT_TRUE(book->orderCount() > 0);
+                ASSERT_TRUE(book->levels().bestBid() < book->levels().bestAsk());
+            }
+            ASSERT_TRUE(builder.book("MSFT")->levels().mid() > Price::fromDouble(120.0));
+            
+            // A stock with resting orders but no executions still has a book by name
+            char add[itch::AddOrder::LENGTH] = {'A', 0, 42};
+            add[19] = 'B';
+            add[23] = 100;                                         // shares
+            std::memcpy(add + 24, "ZZZQ    ", 8);
+            const std::uint32_t price = __builtin_bswap32(100000);  // $10.00
+            std::memcpy(add + 32, &price, sizeof(price));
+            add[18] = 1;                                           // order ref
+            builder.onAddOrder(itch::AddOrder(add));
+            ASSERT_TRUE(ticks.findSymbol("ZZZQ") == INVALID_SYMBOL);
+            ASSERT_TRUE(builder.book("ZZZQ") != nullptr);
+            ASSERT_EQ(1u, builder.book("ZZZQ")->orderCount());
+            
+            TickStore loaded;
+            ASSERT_TRUE(loadData(loaded, path));
+            ASSERT_EQ(ticks.size(), loaded.size());
+            
+            // Loading with books keeps the capture's own books, not synthesized depth
+            TickStore withBooks;
+            OrderBookManager books(withBooks.symbolTable());
+            ASSERT_TRUE(loadData(withBooks, books, path));
+            ASSERT_EQ(ticks.size(), withBooks.size());
+            for (const char* symbol : {"AAPL", "MSFT", "GOOG"}) {
+                const OrderBook& expected = builder.book(symbol)->levels();
+                ASSERT_TRUE(books.find(symbol) != nullptr);
+                ASSERT_EQ(expected.bestBid(), books.find(symbol)->bestBid());
+                ASSERT_EQ(expected.bestAskQuantity(), books.find(symbol)->bestAskQuantity());
+                ASSERT_EQ(expected.levelCount(BookSide::BID), books.find(symbol)->levelCount(BookSide::BID));
+            }
+            file.close();
+            std::filesystem::remove(path);
+        });
+        
+        // Test 8: Depth synthesized from the tape feeds risk checks and strategies
+        suite.addTest("Books Feed Risk And Strategies", []() {
+            TickStore ticks;
+            ticks.append(0, "AAPL", Price::fromDouble(150.00), 100);
+            ticks.append(1, "MSFT", Price::fromDouble(280.00), 100);
+            ticks.append(2, "AAPL", Price::fromDouble(150.03), 100);
+            ticks.append(3, "AAPL", Price::fromDouble(149.90), 100);
+            
+            std::vector<BookUpdate> feed;
+            synthesizeDepth(ticks, feed, 3);
+            
+            struct BookWatcher : Strategy {
+                int updates = 0;
+                Price lastMid;
+                void onTick(const Tick&) override {}
+                void onBook(const BookUpdate&, const OrderBook& book) override { updates++; lastMid = book.mid(); }
+                std::string getStratName() const override { return "Book Watcher"; }
+            } watcher;
+            
+            OrderBookManager books(ticks.symbolTable());
+            for (const BookUpdate& update : feed) {
+                ASSERT_TRUE(books.apply(update));
+                watcher.onBook(update, books.book(update.symbol));
+            }
+            ASSERT_EQ(static_cast<int>(feed.size()), watcher.updates);
+            
+            const OrderBook* aapl = books.find("AAPL");
+            ASSERT_TRUE(aapl != nullptr);
+            ASSERT_EQ(Price::fromDouble(149.89), aapl->bestBid());
+            ASSERT_EQ(Price::fromDouble(149.91), aapl->bestAsk());
+            ASSERT_EQ(3u, aapl->levelCount(BookSide::BID));
+            ASSERT_EQ(3u, aapl->levelCount(BookSide::ASK));
+            ASSERT_EQ(Price::fromDouble(149.90), watcher.lastMid);
+            ASSERT_TRUE(books.find("GOOG") == nullptr);
+            
+            // Seeding the manager directly leaves the same books as the whole feed
+            OrderBookManager seeded(ticks.symbolTable());
+            synthesizeDepth(ticks, seeded, 3);
+            for (const char* symbol : {"AAPL", "MSFT"}) {
+                for (BookSide side : {BookSide::BID, BookSide::ASK}) {
+                    const std::vector<BookLevel> expected = books.find(symbol)->depth(side, 10);
+                    const std::vector<BookLevel> actual = seeded.find(symbol)->depth(side, 10);
+                    ASSERT_EQ(expected.size(), actual.size());
+                    for (std::size_t i = 0; i < expected.size(); i++) {
+                        ASSERT_EQ(expected[i].price, actual[i].price);
+                        ASSERT_EQ(expected[i].quantity, actual[i].quantity);
+                    }
+                }
+            }
+            ASSERT_TRUE(seeded.find("GOOG") == nullptr);
+            
+            RiskManager riskManager(100000.0, 500000.0);
+            riskManager.attachOrderBooks(&books, 0.05);
+            Order nearMid("AAPL", OrderType::BUY, 10, 150.00);
+            Order farFromMid("AAPL", OrderType::BUY, 10, 170.00);
+            ASSERT_TRUE(riskManager.validateOrder(nearMid, nearMid.price));
+            ASSERT_FALSE(riskManager.validateOrder(farFromMid, farFromMid.price));
+            
+            nearMid.status = OrderStatus::FILLED;
+            riskManager.updatePosition(nearMid);
+            riskManager.updateMarketPrices(books);
+            ASSERT_EQ(Price::fromDouble(149.90), riskManager.getPosition("AAPL")->currentPrice);
+        });
+        
         suite.runAll();
     }
     
@@ -68,14 +1208,38 @@ private:
         suite.addTest("Order Creation", []() {
             Order order("AAPL", OrderType::BUY, 100, 150.0);
             
-            ASSERT_EQ("AAPL", order.symbol);
+            ASSERT_EQ(knownSymbol("AAPL"), order.symbol);
             ASSERT_EQ(OrderType::BUY, order.type);
             ASSERT_EQ(100, order.quantity);
-            ASSERT_NEAR(150.0, order.price, 0.01);
-            ASSERT_EQ(OrderStatus::PENDING, order.status);
+            ASSERT_EQ(Price::fromDouble(150.0), order.price);
+            ASSERT_EQ(OrderStatus::NEW, order.status);
+        });
+        
+        // Test 2: Nanosecond timestamps from the calibrated clock
+        suite.addTest("Order Timestamps", []() {
+            timespec wall;
+            clock_gettime(CLOCK_REALTIME, &wall);
+            std::int64_t wallNanos = wall.tv_sec * NANOS_PER_SECOND + wall.tv_nsec;
+            
+            Order first("AAPL", OrderType::BUY, 100, 150.0);
+            Order second("AAPL", OrderType::SELL, 100, 150.0);
+            ASSERT_TRUE(second.timestamp >= first.timestamp);
+            // Same timeline as the wall clock, to well within a second
+            ASSERT_TRUE(std::llabs(first.timestamp - wallNanos) < NANOS_PER_SECOND);
+            
+            std::int64_t previous = Clock::now();
+            for (int i = 0; i < 100000; i++) {
+                std::int64_t next = Clock::now();
+                ASSERT_TRUE(next >= previous);
+                previous = next;
+            }
+            
+            std::string text = formatTimestamp(first.timestamp);
+            ASSERT_EQ(29u, text.size());  // YYYY-MM-DD HH:MM:SS.nnnnnnnnn
+            ASSERT_EQ('.', text[19]);
         });
         
-        // Test 2: Order ID generation
+        // Test 3: Order ID generation
         suite.addTest("Order ID Generation", []() {
             Order order1("AAPL", OrderType::BUY, 100, 150.0);
             Order order2("MSFT", OrderType::SELL, 50, 280.0);
@@ -84,16 +1248,370 @@ private:
             ASSERT_TRUE(order2.orderId > order1.orderId);
         });
         
-        // Test 3: Order manager functionality
+        // Test 4: Order manager functionality
         suite.addTest("Order Manager", []() {
             OrderManager manager;
             
             // Place an order
-            manager.placeOrder("AAPL", OrderType::BUY, 100, 150.0);
+            OrderId id = manager.placeOrder("AAPL", OrderType::BUY, 100, Price::fromDouble(150.0));
+            const Order* placed = manager.findOrder(id);
+            ASSERT_TRUE(placed != nullptr);
+            ASSERT_EQ(100, placed->quantity);
+            ASSERT_EQ(OrderStatus::NEW, placed->status);
+            ASSERT_EQ(1u, manager.liveCount());
+        });
+        
+        // Test 5: Live lists per symbol and retirement to the archive
+        suite.addTest("Order Index And Archive", []() {
+            std::ostringstream sink;
+            AsyncLogger::instance().setOutput(sink);
+            OrderManager manager;
+            std::vector<OrderId> ids;
+            for (int i = 0; i < 3000; i++) {
+                ids.push_back(manager.placeOrder(static_cast<SymbolId>(i % 3), OrderType::SELL, 1 + i, Price::fromDouble(10.0)));
+            }
+            AsyncLogger::instance().setOutput(std::cout);  // flushes the placement lines into the sink
+            ASSERT_EQ(3000u, manager.liveCount());
+            ASSERT_EQ(1000u, manager.liveCount(0));
+            
+            // Retire every other order; a few are cancelled, the rest filled
+            for (std::size_t i = 0; i < ids.size(); i += 2) {
+                bool done = (i % 1000 == 2) ? manager.cancelOrder(ids[i]) : manager.fillOrder(ids[i]);
+                ASSERT_TRUE(done);
+            }
+            ASSERT_FALSE(manager.fillOrder(ids[0]));  // already terminal
+            ASSERT_FALSE(manager.fillOrder(INVALID_ORDER_ID));
+            ASSERT_FALSE(manager.fillOrder(FlatIdMap<Order*>::EMPTY_KEY));
+            ASSERT_EQ(1500u, manager.liveCount());
+            ASSERT_EQ(1500u, manager.archivedOrders().size());
+            
+            // Survivors keep placement order within their symbol
+            OrderId previous = INVALID_ORDER_ID;
+            std::size_t seen = 0;
+            manager.forEachLive(1, [&](const Order& order) {
+                ASSERT_EQ(1u, order.symbol);
+                ASSERT_EQ(OrderStatus::NEW, order.status);
+                ASSERT_TRUE(order.orderId > previous);
+                previous = order.orderId;
+                seen++;
+            });
+            ASSERT_EQ(manager.liveCount(1), seen);
             
-            // This test mainly checks that no exceptions are thrown
-            // In a real system, we'd verify the order was stored correctly
-            ASSERT_TRUE(true); // Placeholder assertion
+            // Archived orders are still found by ID with their final status
+            ASSERT_EQ(OrderStatus::FILLED, manager.findOrder(ids[0])->status);
+            ASSERT_EQ(OrderStatus::CANCELLED, manager.findOrder(ids[2])->status);
+            ASSERT_EQ(OrderStatus::NEW, manager.findOrder(ids[1])->status);
+            ASSERT_EQ(4, manager.findOrder(ids[3])->quantity);
+            
+            // Freed slots are reused by new orders
+            OrderId reused = manager.placeOrder(knownSymbol("AAPL"), OrderType::BUY, 7, Price::fromDouble(1.0));
+            ASSERT_EQ(7, manager.findOrder(reused)->quantity);
+            ASSERT_EQ(1501u, manager.liveCount());
+        });
+        
+        // Test 6: Block-reserved IDs are unique across threads and carry venue/thread bits
+        suite.addTest("Order ID Allocator", []() {
+            const int threads = 4;
+            const std::size_t perThread = 3 * OrderIdAllocator::BLOCK_SIZE + 17;  // crosses block boundaries
+            std::vector<std::vector<OrderId>> issued(threads);
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; t++) {
+                workers.emplace_back([&issued, t, perThread]() {
+                    issued[t].reserve(perThread);
+                    for (std::size_t i = 0; i < perThread; i++) {
+                        issued[t].push_back(nextOrderId(Venue::SIMULATED));
+                    }
+                });
+            }
+            for (auto& worker : workers) worker.join();
+            
+            std::vector<OrderId> all;
+            std::vector<OrderId> sequences;
+            for (const auto& ids : issued) {
+                for (std::size_t i = 0; i < ids.size(); i++) {
+                    ASSERT_TRUE(OrderIdAllocator::venueOf(ids[i]) == Venue::SIMULATED);
+                    ASSERT_EQ(OrderIdAllocator::threadOf(ids[0]), OrderIdAllocator::threadOf(ids[i]));
+                    if (i > 0) ASSERT_TRUE(ids[i] > ids[i - 1]);
+                    all.push_back(ids[i]);
+                    sequences.push_back(OrderIdAllocator::sequenceOf(ids[i]));
+                }
+            }
+            // Sequences alone are unique per venue, whatever the thread bits say
+            std::sort(sequences.begin(), sequences.end());
+            ASSERT_TRUE(std::adjacent_find(sequences.begin(), sequences.end()) == sequences.end());
+            ASSERT_TRUE(sequences.front() > 0);
+            
+            // A local ID never collides with an exchange ID of the same sequence
+            OrderId local = nextOrderId();
+            ASSERT_TRUE(OrderIdAllocator::venueOf(local) == Venue::LOCAL);
+            ASSERT_TRUE(OrderIdAllocator::make(Venue::SIMULATED, OrderIdAllocator::threadOf(local),
+                                               OrderIdAllocator::sequenceOf(local)) != local);
+            ASSERT_EQ(threads * perThread, all.size());
+        });
+        
+        // Test 7: Table-driven lifecycle with partial fills, cancel races and in-place amends
+        suite.addTest("Order State Machine", []() {
+            Order order("AAPL", OrderType::BUY, 100, 150.0);
+            ASSERT_EQ(OrderStatus::NEW, order.status);
+            ASSERT_FALSE(order.onEvent(OrderEvent::CANCEL_ACK));       // nothing to acknowledge
+            ASSERT_FALSE(order.amend(50, order.price));                // not working yet
+            ASSERT_TRUE(order.onEvent(OrderEvent::ACK));
+            ASSERT_FALSE(order.onEvent(OrderEvent::REJECT));
+            
+            // Cumulative and leaves quantity across partial fills
+            ASSERT_TRUE(order.onFill(30));
+            ASSERT_EQ(OrderStatus::PARTIALLY_FILLED, order.status);
+            ASSERT_EQ(30, order.filledQuantity);
+            ASSERT_EQ(70, order.leaves());
+            ASSERT_FALSE(order.onFill(71));  // overfill
+            ASSERT_FALSE(order.onFill(0));
+            
+            // Shrinking in place keeps ID and time priority; a price change loses priority
+            const OrderId id = order.orderId;
+            const std::int64_t placedAt = order.timestamp;
+            ASSERT_TRUE(order.amend(80, order.price));
+            ASSERT_EQ(OrderStatus::PARTIALLY_FILLED, order.status);
+            ASSERT_EQ(id, order.orderId);
+            ASSERT_EQ(placedAt, order.timestamp);
+            ASSERT_EQ(50, order.leaves());
+            ASSERT_FALSE(order.amend(30, order.price));  // at or below what already filled
+            ASSERT_EQ(OrderStatus::PARTIALLY_FILLED, order.status);
+            ASSERT_TRUE(order.amend(80, Price::fromDouble(149.5)));
+            ASSERT_TRUE(order.timestamp >= placedAt);
+            ASSERT_TRUE(order.price == Price::fromDouble(149.5));
+            
+            // Fills racing a cancel: partial stays pending, the last one wins over the cancel
+            ASSERT_TRUE(order.onEvent(OrderEvent::CANCEL_REQUEST));
+            ASSERT_FALSE(order.onEvent(OrderEvent::REPLACE_REQUEST));  // one request in flight
+            ASSERT_TRUE(order.onFill(20));
+            ASSERT_EQ(OrderStatus::PENDING_CANCEL, order.status);
+            ASSERT_TRUE(order.onEvent(OrderEvent::CANCEL_REJECT));
+            ASSERT_EQ(OrderStatus::PARTIALLY_FILLED, order.status);
+            ASSERT_TRUE(order.onEvent(OrderEvent::CANCEL_REQUEST));
+            ASSERT_TRUE(order.onFill(30));
+            ASSERT_EQ(OrderStatus::FILLED, order.status);
+            ASSERT_EQ(80, order.filledQuantity);
+            ASSERT_FALSE(order.onEvent(OrderEvent::CANCEL_ACK));  // too late, terminal
+            
+            // The manager drives the same table and archives terminal orders
+            std::ostringstream sink;
+            AsyncLogger::instance().setOutput(sink);
+            OrderManager manager;
+            OrderId first = manager.placeOrder("MSFT", OrderType::SELL, 10, Price::fromDouble(280.0));
+            OrderId second = manager.placeOrder("MSFT", OrderType::SELL, 10, Price::fromDouble(281.0));
+            OrderId third = manager.placeOrder("MSFT", OrderType::SELL, 10, Price::fromDouble(282.0));
+            AsyncLogger::instance().setOutput(std::cout);
+            ASSERT_TRUE(manager.applyEvent(first, OrderEvent::ACK));
+            ASSERT_TRUE(manager.fillOrder(first, 4));
+            ASSERT_EQ(OrderStatus::PARTIALLY_FILLED, manager.findOrder(first)->status);
+            ASSERT_TRUE(manager.amendOrder(first, 6, Price::fromDouble(280.0)));
+            ASSERT_TRUE(manager.applyEvent(second, OrderEvent::REJECT));
+            ASSERT_EQ(OrderStatus::REJECTED, manager.findOrder(second)->status);
+            ASSERT_FALSE(manager.applyEvent(second, OrderEvent::ACK));
+            ASSERT_TRUE(manager.fillOrder(first));  // the remaining 2
+            ASSERT_EQ(OrderStatus::FILLED, manager.findOrder(first)->status);
+            ASSERT_EQ(6, manager.findOrder(first)->filledQuantity);
+            ASSERT_EQ(1u, manager.liveCount());
+            ASSERT_EQ(third, manager.findOrder(third)->orderId);
+            ASSERT_EQ(2u, manager.archivedOrders().size());
+        });
+        
+        // Test 8: Replaying the journal rebuilds orders, their states and positions
+        suite.addTest("Journal Replay Rebuilds State", []() {
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_journal_test.bin").string();
+            std::filesystem::remove(path);
+            
+            std::ostringstream sink;
+            AsyncLogger::instance().setOutput(sink);
+            OrderId resting, cancelled, filled;
+            std::int64_t amendedAt = 0;
+            {
+                OrderJournal journal;
+                ASSERT_TRUE(journal.open(path, 4));
+                OrderManager manager;
+                RiskManager risk(1e6, 1e9);
+                manager.attachJournal(&journal);
+                risk.attachJournal(&journal);
+                
+                resting = manager.placeOrder("JRNA", OrderType::BUY, 100, Price::fromDouble(10.0));
+                cancelled = manager.placeOrder("JRNB", OrderType::SELL, 50, Price::fromDouble(20.0));
+                filled = manager.placeOrder("JRNB", OrderType::BUY, 30, Price::fromDouble(19.5));
+                ASSERT_TRUE(manager.applyEvent(resting, OrderEvent::ACK));
+                ASSERT_TRUE(manager.fillOrder(resting, 40));
+                ASSERT_TRUE(manager.amendOrder(resting, 90, Price::fromDouble(10.25)));
+                amendedAt = manager.findOrder(resting)->timestamp;
+                ASSERT_TRUE(manager.cancelOrder(cancelled));
+                ASSERT_TRUE(manager.fillOrder(filled));
+                risk.updatePosition(*manager.findOrder(filled));
+                ASSERT_FALSE(manager.fillOrder(filled));  // refused, so not journaled
+                
+                ASSERT_TRUE(journal.capacity() >= journal.recordCount());
+                ASSERT_EQ(12u, journal.recordCount());  // 2 symbols, 3 places, ack, 2 fills, amend, 2 cancel events, position
+            }
+            AsyncLogger::instance().flush();
+            AsyncLogger::instance().setOutput(std::cout);
+            
+            OrderJournal journal;
+            ASSERT_TRUE(journal.open(path));
+            ASSERT_EQ(12u, journal.recordCount());
+            OrderManager manager;
+            RiskManager risk(1e6, 1e9);
+            JournalReplayStats stats = journal.replay(manager, risk);
+            ASSERT_EQ(12u, stats.records);
+            ASSERT_EQ(3u, stats.orders);
+            ASSERT_EQ(0u, stats.rejected);
+            
+            const Order* order = manager.findOrder(resting);
+            ASSERT_TRUE(order != nullptr);
+            ASSERT_EQ(OrderStatus::PARTIALLY_FILLED, order->status);
+            ASSERT_EQ(90, order->quantity);
+            ASSERT_EQ(40, order->filledQuantity);
+            ASSERT_TRUE(order->price == Price::fromDouble(10.25));
+            ASSERT_EQ(amendedAt, order->timestamp);
+            ASSERT_EQ(std::string("JRNA"), symbolName(order->symbol));
+            ASSERT_EQ(OrderStatus::CANCELLED, manager.findOrder(cancelled)->status);
+            ASSERT_EQ(OrderStatus::FILLED, manager.findOrder(filled)->status);
+            ASSERT_EQ(1u, manager.liveCount());
+            
+            Position* position = risk.getPosition("JRNB");
+            ASSERT_TRUE(position != nullptr);
+            ASSERT_EQ(30, position->quantity);
+            ASSERT_TRUE(position->avgPrice == Price::fromDouble(19.5));
+            ASSERT_TRUE(risk.getPosition("JRNA") == nullptr);
+            
+            // New IDs never collide with recovered ones
+            OrderIdAllocator::reserveThrough(Venue::LOCAL, OrderIdAllocator::sequenceOf(resting) + 100000);
+            ASSERT_TRUE(OrderIdAllocator::sequenceOf(nextOrderId()) > OrderIdAllocator::sequenceOf(resting) + 100000);
+            journal.close();
+            std::filesystem::remove(path);
+        });
+        
+        // Test 9: A record torn by a crash ends the journal; appends carry on after it
+        suite.addTest("Journal Torn Tail Recovery", []() {
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_journal_torn.bin").string();
+            std::filesystem::remove(path);
+            {
+                OrderJournal journal;
+                ASSERT_TRUE(journal.open(path, 64));
+                for (OrderId id = 1; id <= 10; id++) {
+                    journal.recordFill(id, 5);
+                }
+                journal.sync();
+            }
+            {
+                // Half-written 10th record
+                std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+                file.seekp(OrderJournal::HEADER_SIZE + 9 * sizeof(JournalRecord) + 40);
+                file.write("\x7f\x7f\x7f\x7f", 4);
+            }
+            {
+                OrderJournal journal;
+                ASSERT_TRUE(journal.open(path));
+                ASSERT_EQ(9u, journal.recordCount());
+                journal.recordEvent(42, OrderEvent::ACK);
+            }
+            OrderJournal journal;
+            ASSERT_TRUE(journal.open(path));
+            ASSERT_EQ(10u, journal.recordCount());
+            
+            // Fills for orders the manager never saw are counted, not applied
+            OrderManager manager;
+            RiskManager risk;
+            JournalReplayStats stats = journal.replay(manager, risk);
+            ASSERT_EQ(10u, stats.records);
+            ASSERT_EQ(9u, stats.fills);
+            ASSERT_EQ(10u, stats.rejected);
+            journal.close();
+            
+            // Pages that reached the disk out of order: a zero hole before
+            // records 12 to 20. They are cleared, and a later session that
+            // stops just short of the hole does not chain into them.
+            {
+                OrderJournal writer;
+                ASSERT_TRUE(writer.open(path));
+                for (OrderId id = 11; id <= 20; id++) {
+                    writer.recordFill(id, 5);
+                }
+                writer.sync();
+            }
+            {
+                const char zeros[sizeof(JournalRecord)] = {};
+                std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+                file.seekp(OrderJournal::HEADER_SIZE + 10 * sizeof(JournalRecord));
+                file.write(zeros, sizeof(zeros));
+            }
+            {
+                OrderJournal journal;
+                ASSERT_TRUE(journal.open(path));
+                ASSERT_EQ(10u, journal.recordCount());
+            }
+            {
+                // The hole itself, written again by the next session
+                OrderJournal journal;
+                ASSERT_TRUE(journal.open(path));
+                journal.recordFill(11, 5);
+            }
+            ASSERT_TRUE(journal.open(path));
+            ASSERT_EQ(11u, journal.recordCount());
+            journal.close();
+            
+            // Somebody else's file is left alone
+            {
+                std::ofstream other(path, std::ios::binary | std::ios::trunc);
+                other << "not a journal, but long enough to have a header of its own............";
+            }
+            ASSERT_FALSE(journal.open(path));
+            std::filesystem::remove(path);
+        });
+        
+        // Test 10: The flusher grows the file ahead of the writer; a full journal refuses changes
+        suite.addTest("Journal Growth And Full Journal", []() {
+            const std::string path = (std::filesystem::temp_directory_path() / "hft_journal_full.bin").string();
+            std::filesystem::remove(path);
+            {
+                OrderJournal journal;
+                ASSERT_TRUE(journal.open(path, 1, std::chrono::microseconds(100)));
+                const std::size_t initial = journal.capacity();  // one page
+                for (std::size_t i = 0; i <= initial / 2; i++) {
+                    ASSERT_TRUE(journal.recordFill(i + 1, 1));
+                }
+                for (int wait = 0; wait < 2000 && journal.capacity() == initial; wait++) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                ASSERT_TRUE(journal.capacity() > initial);
+                ASSERT_FALSE(journal.failed());
+            }
+            std::filesystem::remove(path);
+            
+            // A flusher that never gets to run: the writer must stop at the end, not grow
+            OrderJournal journal;
+            ASSERT_TRUE(journal.open(path, 1, std::chrono::hours(1)));
+            const std::size_t capacity = journal.capacity();
+            for (std::size_t i = 0; i + 1 < capacity; i++) {
+                ASSERT_TRUE(journal.recordFill(i + 1, 1));
+            }
+            ASSERT_TRUE(journal.canAppend(1));
+            ASSERT_FALSE(journal.canAppend(2));
+            
+            std::ostringstream sink;
+            AsyncLogger::instance().setOutput(sink);
+            OrderManager manager;
+            manager.attachJournal(&journal);
+            // The symbol record fits, the order does not: refused, nothing live
+            ASSERT_EQ(INVALID_ORDER_ID, manager.placeOrder("JRNF", OrderType::BUY, 1, Price::fromDouble(1.0)));
+            AsyncLogger::instance().flush();
+            AsyncLogger::instance().setOutput(std::cout);
+            ASSERT_EQ(0u, manager.liveCount());
+            ASSERT_TRUE(journal.failed());
+            ASSERT_EQ(1u, journal.droppedCount());
+            ASSERT_EQ(static_cast<std::uint64_t>(capacity), journal.recordCount());
+            journal.close();
+            
+            ASSERT_TRUE(journal.open(path));
+            ASSERT_EQ(static_cast<std::uint64_t>(capacity), journal.recordCount());
+            ASSERT_FALSE(journal.failed());
+            journal.close();
+            std::filesystem::remove(path);
         });
         
         suite.runAll();
@@ -107,13 +1625,13 @@ private:
             RiskManager riskManager(1000.0, 5000.0); // $1K max position, $5K max exposure
             
             // Create a large order that should fail risk check
-            Order largeOrder("AAPL", OrderType::BUY, 100, 50.0); // $5000 order
-            bool shouldFail = !riskManager.validateOrder(largeOrder, 50.0);
+            Order largeOrder("AAPL", OrderType::BUY, 100, Price::fromDouble(50.0)); // $5000 order
+            bool shouldFail = !riskManager.validateOrder(largeOrder, Price::fromDouble(50.0));
             ASSERT_TRUE(shouldFail);
             
             // Create a small order that should pass
-            Order smallOrder("AAPL", OrderType::BUY, 10, 50.0); // $500 order
-            bool shouldPass = riskManager.validateOrder(smallOrder, 50.0);
+            Order smallOrder("AAPL", OrderType::BUY, 10, Price::fromDouble(50.0)); // $500 order
+            bool shouldPass = riskManager.validateOrder(smallOrder, Price::fromDouble(50.0));
             ASSERT_TRUE(shouldPass);
         });
         
@@ -122,7 +1640,7 @@ private:
             RiskManager riskManager(10000.0, 50000.0);
             
             // Simulate a filled buy order
-            Order buyOrder("AAPL", OrderType::BUY, 100, 150.0);
+            Order buyOrder("AAPL", OrderType::BUY, 100, Price::fromDouble(150.0));
             buyOrder.status = OrderStatus::FILLED;
             riskManager.updatePosition(buyOrder);
             
@@ -131,7 +1649,7 @@ private:
             ASSERT_TRUE(position != nullptr);
             if (position) {
                 ASSERT_EQ(100, position->quantity);
-                ASSERT_NEAR(150.0, position->avgPrice, 0.01);
+                ASSERT_EQ(Price::fromDouble(150.0), position->avgPrice);
             }
         });
         
@@ -145,23 +1663,45 @@ private:
         suite.addTest("Moving Average Strategy", []() {
             MovingAvgStrat strategy(2, 3);
             
-            // Create test data with upward trend
-            std::vector<MarketData> trendData;
+            // Feed an upward trend tick by tick
             double prices[] = {100, 101, 102, 103, 104}; // Increasing prices
-            
             for (int i = 0; i < 5; i++) {
-                MarketData data;
-                data.Abb = "TEST";
-                data.price = prices[i];
-                trendData.push_back(data);
+                strategy.onTick(Tick{i, 0, Price::fromDouble(prices[i]), 100});
             }
             
             // With increasing prices, short MA should be > long MA = BUY signal
-            int signal = strategy.generateSignal(trendData, "TEST");
-            ASSERT_EQ(1, signal); // Should be BUY signal
+            ASSERT_EQ(1, strategy.signal(0)); // Should be BUY signal
+            
+            // The crossover produced exactly one buy intent
+            ASSERT_EQ(1u, strategy.pendingIntents().size());
+            ASSERT_EQ(OrderType::BUY, strategy.pendingIntents()[0].side);
+            ASSERT_EQ(100, strategy.pendingIntents()[0].quantity);
+        });
+        
+        // Test 2: Fills drive the size of later intents
+        suite.addTest("Strategy Fill Handling", []() {
+            MovingAvgStrat strategy(2, 3, 50);
+            double prices[] = {100, 101, 102, 103, 95, 90};
+            
+            for (int i = 0; i < 4; i++) {
+                strategy.onTick(Tick{i, 7, Price::fromDouble(prices[i]), 100});
+            }
+            ASSERT_EQ(1u, strategy.pendingIntents().size());
+            OrderIntent buy = strategy.pendingIntents()[0];
+            strategy.clearIntents();
+            strategy.onFill(Fill{1, buy.symbol, buy.side, buy.quantity, buy.price, 4});
+            ASSERT_EQ(50, strategy.position(7));
+            
+            // Trend reverses: flip from +50 to -50 in one intent
+            strategy.onTick(Tick{4, 7, Price::fromDouble(prices[4]), 100});
+            strategy.onTick(Tick{5, 7, Price::fromDouble(prices[5]), 100});
+            ASSERT_EQ(-1, strategy.signal(7));
+            ASSERT_EQ(1u, strategy.pendingIntents().size());
+            ASSERT_EQ(OrderType::SELL, strategy.pendingIntents()[0].side);
+            ASSERT_EQ(100, strategy.pendingIntents()[0].quantity);
         });
         
-        // Test 2: Strategy name
+        // Test 3: Strategy name
         suite.addTest("Strategy Name", []() {
             MovingAvgStrat strategy(5, 10);
             std::string name = strategy.getStratName();
@@ -195,10 +1735,10 @@ private:
             creds.apiKey = "test";
             exchange.authenticate(creds);
             
-            double price;
+            Price price;
             bool priceSuccess = exchange.getMarketPrice("AAPL", price);
             ASSERT_TRUE(priceSuccess);
-            ASSERT_TRUE(price > 0);
+            ASSERT_TRUE(price > Price());
         });
         
         // Test 3: Order placement
@@ -209,8 +1749,206 @@ private:
             creds.apiKey = "test";
             exchange.authenticate(creds);
             
-            std::string orderId = exchange.placeOrder("AAPL", "buy", 10, 150.0);
-            ASSERT_FALSE(orderId.empty());
+            OrderId orderId = exchange.placeOrder("AAPL", "buy", 10, Price::fromDouble(150.0));
+            ASSERT_TRUE(orderId != INVALID_ORDER_ID);
+            ASSERT_TRUE(OrderIdAllocator::venueOf(orderId) == Venue::SIMULATED);
+        });
+        
+        // Test 4: Pooled exchange orders close on fill; only whole shares are accepted
+        suite.addTest("Exchange Order Lifecycle", []() {
+            SimulatedExchange exchange;
+            ExchangeCredentials creds;
+            creds.apiKey = "test";
+            exchange.authenticate(creds);
+            
+            std::map<std::string, double> before, after;
+            exchange.getAccountBalance(before);
+            OrderId orderId = exchange.placeOrder("MSFT", "buy", 3, Price::fromDouble(280.0));
+            ASSERT_TRUE(orderId != INVALID_ORDER_ID);
+            exchange.getAccountBalance(after);
+            ASSERT_EQ(before["MSFT"] + 3.0, after["MSFT"]);
+            ASSERT_EQ(before["USD"] - 840.0, after["USD"]);
+            
+            // Filled on placement: nothing open, nothing left to cancel
+            ASSERT_TRUE(exchange.getOpenOrders().empty());
+            ASSERT_FALSE(exchange.cancelOrder(orderId));
+            ASSERT_FALSE(exchange.cancelOrder(INVALID_ORDER_ID));
+            ASSERT_EQ(INVALID_ORDER_ID, exchange.placeOrder("MSFT", "buy", 1.5, Price::fromDouble(280.0)));
+            
+            // Cash is exact: a balance a hundredth of a cent short is still short
+            exchange.setCash(Price::fromDouble(280.0) * 2 - Price::fromRaw(1));
+            ASSERT_EQ(INVALID_ORDER_ID, exchange.placeOrder("MSFT", "buy", 2, Price::fromDouble(280.0)));
+            exchange.setCash(Price::fromDouble(280.0) * 2);
+            ASSERT_TRUE(exchange.placeOrder("MSFT", "buy", 2, Price::fromDouble(280.0)) != INVALID_ORDER_ID);
+            exchange.getAccountBalance(after);
+            ASSERT_EQ(0.0, after["USD"]);
+            ASSERT_EQ(INVALID_ORDER_ID, exchange.placeOrder("MSFT", "sell", 1e30, Price::fromDouble(280.0)));
+            
+            ASSERT_EQ(64u, sizeof(Order));
+            ASSERT_EQ(64u, alignof(Order));
+        });
+        
+        // Test 5: Resting orders take partial fills and are amended without losing their ID
+        suite.addTest("Exchange Partial Fills And Amend", []() {
+            SimulatedExchange exchange;
+            ExchangeCredentials creds;
+            creds.apiKey = "test";
+            exchange.authenticate(creds);
+            exchange.setImmediateFills(false);
+            
+            std::map<std::string, double> before, after;
+            exchange.getAccountBalance(before);
+            OrderId early = exchange.placeOrder("MSFT", "buy", 10, Price::fromDouble(280.0));
+            OrderId late = exchange.placeOrder("MSFT", "buy", 10, Price::fromDouble(280.0));
+            ASSERT_TRUE(exchange.simulateOrderFill(early, 4));
+            
+            auto open = exchange.getOpenOrders();
+            ASSERT_EQ(2u, open.size());
+            ASSERT_EQ(early, open[0].exchangeOrderId);
+            ASSERT_EQ("PARTIALLY_FILLED", open[0].status);
+            ASSERT_NEAR(4.0, open[0].filledQuantity, 1e-9);
+            ASSERT_EQ("ACKED", open[1].status);
+            
+            // Shrinking in place keeps the early order ahead of the late one
+            ASSERT_TRUE(exchange.amendOrder(early, 6, Price::fromDouble(280.0)));
+            open = exchange.getOpenOrders();
+            ASSERT_EQ(early, open[0].exchangeOrderId);
+            ASSERT_NEAR(6.0, open[0].quantity, 1e-9);
+            ASSERT_FALSE(exchange.amendOrder(early, 4, Price::fromDouble(280.0)));   // already 4 filled
+            ASSERT_FALSE(exchange.amendOrder(early, 6, Price::fromDouble(280.005))); // off tick
+            
+            // Filling the rest closes it; balances moved by exactly the executed 6 shares
+            ASSERT_TRUE(exchange.simulateOrderFill(early));
+            ASSERT_FALSE(exchange.simulateOrderFill(early));
+            ASSERT_TRUE(exchange.cancelOrder(late));
+            ASSERT_TRUE(exchange.getOpenOrders().empty());
+            exchange.getAccountBalance(after);
+            ASSERT_EQ(before["MSFT"] + 6.0, after["MSFT"]);
+            ASSERT_EQ(before["USD"] - 1680.0, after["USD"]);
+        });
+        
+        suite.runAll();
+    }
+    
+    static void testAsyncLogger() {
+        TestSuite suite("Async Logger");
+        
+        // Test 1: Ring buffer capacity and ordering
+        suite.addTest("SPSC Ring Full And Empty", []() {
+            SpscRing<int, 4> ring;
+            int out = 0;
+            ASSERT_FALSE(ring.tryPop(out));
+            for (int i = 0; i < 4; i++) {
+                ASSERT_TRUE(ring.tryPush(i));
+            }
+            ASSERT_FALSE(ring.tryPush(99));  // full
+            ASSERT_TRUE(ring.tryPop(out));
+            ASSERT_EQ(0, out);
+            ASSERT_TRUE(ring.tryPush(4));    // wraps around
+            
+            int expected = 1;
+            std::size_t consumed = ring.consume([&expected](const int& v) {
+                if (v != expected++) throw std::runtime_error("out of order");
+            });
+            ASSERT_EQ(4u, consumed);
+            ASSERT_TRUE(ring.empty());
+        });
+        
+        // Test 2: Records are formatted on the background thread
+        suite.addTest("Background Formatting", []() {
+            std::ostringstream captured;
+            AsyncLogger& logger = AsyncLogger::instance();
+            logger.setOutput(captured);
+            
+            std::string symbol = "AAPL";
+            logger.log("Order #{} | {} {} @ ${:.2f}", 42, symbol, "BUY", 150.5);
+            logger.log("ratio={} count={} missing={}", 0.25, 7u);
+            logger.flush();
+            logger.setOutput(std::cout);
+            
+            ASSERT_EQ(std::string("Order #42 | AAPL BUY @ $150.50\nratio=0.25 count=7 missing=\n"), captured.str());
+        });
+        
+        suite.runAll();
+    }
+    
+    static void testLatencyTrace() {
+        TestSuite suite("Latency Tracing");
+        
+        // Test 1: Histogram buckets are exact at the bottom and within ~3% above
+        suite.addTest("Histogram Percentiles", []() {
+            LatencyHistogram histogram;
+            ASSERT_EQ(0, histogram.percentile(0.5));
+            for (int i = 1; i <= 63; i++) {
+                histogram.record(i);
+            }
+            ASSERT_EQ(32, histogram.percentile(0.5));
+            ASSERT_EQ(63, histogram.percentile(1.0));
+            
+            histogram.clear();
+            for (int i = 1; i <= 1000; i++) {
+                histogram.record(i * 1000);  // 1us .. 1ms
+            }
+            ASSERT_EQ(1000u, histogram.count());
+            ASSERT_EQ(1000, histogram.min());
+            ASSERT_EQ(1000000, histogram.max());
+            ASSERT_NEAR(500500.0, histogram.mean(), 1e-6);
+            ASSERT_NEAR(500000.0, static_cast<double>(histogram.percentile(0.50)), 500000.0 * 0.032);
+            ASSERT_NEAR(990000.0, static_cast<double>(histogram.percentile(0.99)), 990000.0 * 0.032);
+            ASSERT_EQ(1000000, histogram.percentile(1.0));  // capped at the maximum
+            
+            // Buckets tile the range without gaps and hold every sample
+            std::int64_t nextLow = -1;
+            std::uint64_t seen = 0;
+            histogram.forEachBucket([&](std::int64_t low, std::int64_t high, std::uint64_t count) {
+                if (low <= nextLow || high < low) throw std::runtime_error("buckets overlap");
+                nextLow = high;
+                seen += count;
+            });
+            ASSERT_EQ(1000u, seen);
+            
+            LatencyHistogram other;
+            other.record(5);
+            histogram.merge(other);
+            ASSERT_EQ(1001u, histogram.count());
+            ASSERT_EQ(5, histogram.min());
+        });
+        
+        // Test 2: Records land in the spans they cover; a full ring drops and counts
+        suite.addTest("Tracer Spans And Drops", []() {
+            LatencyTracer& tracer = LatencyTracer::instance();
+            tracer.reset();
+            
+            TraceRecord tickOnly;
+            tickOnly.stamp(TraceStage::FEED_RECEIVE);
+            tickOnly.stamp(TraceStage::STRATEGY_DECISION);
+            ASSERT_TRUE(tracer.submit(tickOnly));
+            
+            TraceRecord order = tickOnly;
+            order.orderId = 7;
+            order.stamp(TraceStage::RISK_CHECK);
+            order.stamp(TraceStage::GATEWAY_SEND);
+            order.stamp(TraceStage::EXCHANGE_ACK);
+            ASSERT_TRUE(tracer.submit(order));
+            ASSERT_EQ(2u, tracer.collect());
+            
+            ASSERT_EQ(2u, tracer.span(0).count());  // feed_to_decision
+            for (std::size_t i = 1; i < TRACE_SPAN_COUNT; i++) {
+                ASSERT_EQ(1u, tracer.span(i).count());
+            }
+            
+            for (std::size_t i = 0; i < LatencyTracer::RING_CAPACITY; i++) {
+                tracer.submit(order);
+            }
+            ASSERT_FALSE(tracer.submit(order));
+            ASSERT_EQ(1u, tracer.droppedCount());
+            ASSERT_EQ(LatencyTracer::RING_CAPACITY, tracer.collect());
+            
+            std::ostringstream json;
+            tracer.dump(json);
+            ASSERT_TRUE(json.str().find("\"name\":\"tick_to_ack\",\"count\":4097") != std::string::npos);
+            tracer.reset();
+            ASSERT_EQ(0u, tracer.span(0).count());
         });
         
         suite.runAll();
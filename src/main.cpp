@@ -5,8 +5,17 @@
 #include <vector>
 #include <algorithm>
 #include "MarketData.h"
+#include "TickStore.h"
+#include "BinaryTickFile.h"
+#include "TickArchive.h"
+#include "RollingIndicators.h"
+#include "TickIndex.h"
+#include "OrderBook.h"
+#include "AsyncLogger.h"
+#include <thread>
 #include "Order.h"
 #include "RiskManager.h"
+#include "OrderJournal.h"
 #include "PerformanceMonitor.h"
 #include "ExchangeManager.h"
 #include "TestRunner.cpp"
@@ -21,26 +30,47 @@ int getValidChoice() {
         try {
             choice = std::stoi(input);
             
-            if (choice >= 1 && choice <= 19) {
+            if (choice >= 1 && choice <= 21) {
                 return choice;
             } else {
-                std::cout << "Please enter a number between 1-19: ";
+                std::cout << "Please enter a number between 1-21: ";
             }
         }
         catch (std::invalid_argument&) {
-            std::cout << "Invalid input! Please enter a number (1-19): ";
+            std::cout << "Invalid input! Please enter a number (1-21): ";
         }
         catch (std::out_of_range&) {
-            std::cout << "Number too large! Please enter a number (1-19): ";
+            std::cout << "Number too large! Please enter a number (1-21): ";
         }
     }
 }
 
+void queryTimeRange(TickIndex& index, const TickStore& marketData) {
+    std::string symbol, fromInput, toInput;
+    std::int64_t from, to;
+    std::cout << "Enter symbol (AAPL/MSFT): ";
+    std::getline(std::cin, symbol);
+    std::cout << "Enter start time (HH:MM:SS): ";
+    std::getline(std::cin, fromInput);
+    std::cout << "Enter end time (HH:MM:SS, exclusive): ";
+    std::getline(std::cin, toInput);
+    
+    if (!parseTimeOfDay(fromInput, from) || !parseTimeOfDay(toInput, to)) {
+        std::cout << "❌ Invalid time! Use HH:MM:SS[.fraction]" << std::endl;
+        return;
+    }
+    if (marketData.findSymbol(symbol) == INVALID_SYMBOL) {
+        std::cout << "❌ No market data for " << symbol << std::endl;
+        return;
+    }
+    showRangeStats(index, marketData, symbol, from, to);
+}
+
 void placeOrderWithRiskCheck(OrderManager& orderManager, RiskManager& riskManager, 
-                           const std::vector<MarketData>& marketData) {
+                           const TickStore& marketData) {
     std::string symbol;
     int typeChoice, quantity;
-    double price;
+    double priceInput;
     
     std::cout << "\n=== Place New Order ===" << std::endl;
     std::cout << "Enter symbol (AAPL/MSFT): ";
@@ -53,17 +83,23 @@ void placeOrderWithRiskCheck(OrderManager& orderManager, RiskManager& riskManage
     std::cin >> quantity;
     
     std::cout << "Price: $";
-    std::cin >> price;
+    std::cin >> priceInput;
+    const Price price = Price::fromDouble(priceInput);
     
     OrderType type = (typeChoice == 1) ? OrderType::BUY : OrderType::SELL;
     
     Order testOrder(symbol, type, quantity, price);
     
     if (riskManager.validateOrder(testOrder, price)) {
-        orderManager.placeOrder(symbol, type, quantity, price);
-        testOrder.status = OrderStatus::FILLED;
-        riskManager.updatePosition(testOrder);
-        std::cout << "✅ Order passed risk checks and executed!" << std::endl;
+        const OrderId orderId = orderManager.placeOrder(symbol, type, quantity, price);
+        if (orderId != INVALID_ORDER_ID && orderManager.fillOrder(orderId)) {
+            testOrder.orderId = orderId;
+            testOrder.status = OrderStatus::FILLED;
+            riskManager.updatePosition(testOrder);
+            std::cout << "✅ Order passed risk checks and executed!" << std::endl;
+        } else {
+            std::cout << "❌ Order could not be recorded!" << std::endl;
+        }
     } else {
         std::cout << "❌ Order rejected due to risk limits!" << std::endl;
     }
@@ -91,12 +127,12 @@ void connectToExchange(ExchangeManager& exchangeManager) {
 
 void placeLiveOrder(ExchangeManager& exchangeManager, RiskManager& riskManager) {
     if (!exchangeManager.isConnected()) {
-        std::cout << "❌ Not connected to exchange. Use option 14 to connect first." << std::endl;
+        std::cout << "❌ Not connected to exchange. Use option 16 to connect first." << std::endl;
         return;
     }
     
     std::string symbol, side;
-    double quantity, price;
+    double quantity, priceInput;
     
     std::cout << "\n=== Place LIVE Order ===" << std::endl;
     std::cout << "⚠️  WARNING: This will place a REAL order with REAL money!" << std::endl;
@@ -110,8 +146,9 @@ void placeLiveOrder(ExchangeManager& exchangeManager, RiskManager& riskManager)
     std::cin >> quantity;
     
     std::cout << "Price: $";
-    std::cin >> price;
+    std::cin >> priceInput;
     std::cin.ignore();
+    const Price price = Price::fromDouble(priceInput);
     
     OrderType orderType = (side == "buy") ? OrderType::BUY : OrderType::SELL;
     Order testOrder(symbol, orderType, quantity, price);
@@ -130,8 +167,8 @@ void placeLiveOrder(ExchangeManager& exchangeManager, RiskManager& riskManager)
     std::getline(std::cin, confirmation);
     
     if (confirmation == "CONFIRM") {
-        std::string orderId = exchangeManager.executeLiveOrder(symbol, side, quantity, price);
-        if (!orderId.empty()) {
+        const OrderId orderId = exchangeManager.executeLiveOrder(symbol, side, quantity, price);
+        if (orderId != INVALID_ORDER_ID) {
             testOrder.status = OrderStatus::FILLED;
             riskManager.updatePosition(testOrder);
         }
@@ -142,7 +179,7 @@ void placeLiveOrder(ExchangeManager& exchangeManager, RiskManager& riskManager)
 
 void getLiveMarketPrice(ExchangeManager& exchangeManager) {
     if (!exchangeManager.isConnected()) {
-        std::cout << "❌ Not connected to exchange. Use option 14 to connect first." << std::endl;
+        std::cout << "❌ Not connected to exchange. Use option 16 to connect first." << std::endl;
         return;
     }
     
@@ -150,28 +187,88 @@ void getLiveMarketPrice(ExchangeManager& exchangeManager) {
     std::cout << "Enter symbol for live price (AAPL/MSFT): ";
     std::getline(std::cin, symbol);
     
-    double price;
+    Price price;
     exchangeManager.getLivePrice(symbol, price);
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    std::string dataPath = DEFAULT_MARKET_DATA_PATH;
+    std::string journalPath = DEFAULT_JOURNAL_PATH;
+    
+    if (argc == 4 && std::string(argv[1]) == "--convert-ticks") {
+        if (!convertCsvToBinary(argv[2], argv[3])) {
+            std::cout << "Error: Could not convert " << argv[2] << " to " << argv[3] << std::endl;
+            return 1;
+        }
+        std::cout << "Converted " << argv[2] << " -> " << argv[3] << std::endl;
+        return 0;
+    }
+    if (argc == 4 && std::string(argv[1]) == "--archive-ticks") {
+        if (!archiveTicks(argv[2], argv[3])) {
+            std::cout << "Error: Could not archive " << argv[2] << " to " << argv[3] << std::endl;
+            return 1;
+        }
+        std::cout << "Archived " << argv[2] << " -> " << argv[3] << std::endl;
+        return 0;
+    }
+    // --data and --journal combine, in any order
+    for (int i = 1; i < argc; i += 2) {
+        const std::string flag = argv[i];
+        if (i + 1 >= argc || (flag != "--data" && flag != "--journal")) {
+            std::cout << "Usage: " << argv[0] << " [--data <ticks>] [--journal <file>]\n"
+                      << "       " << argv[0] << " --convert-ticks <csv> <ticks>\n"
+                      << "       " << argv[0] << " --archive-ticks <ticks> <archive>" << std::endl;
+            return 1;
+        }
+        if (flag == "--data") {
+            dataPath = argv[i + 1];  // CSV, binary tick file, archive or ITCH capture
+        } else {
+            journalPath = argv[i + 1];
+        }
+    }
+    
+    // Keep log formatting and terminal I/O on the last core, away from the trading path
+    const int loggerCore = static_cast<int>(std::max(1u, std::thread::hardware_concurrency())) - 1;
+    if (!AsyncLogger::instance().pinWorker(loggerCore)) {
+        std::cout << "Warning: Could not pin the logger to core " << loggerCore << ", it will share cores" << std::endl;
+    }
+    
     std::cout << "🚀 HFT Trading Platform - PRODUCTION READY" << std::endl;
     std::cout << "Loading market data..." << std::endl;
     
-    std::vector<MarketData> marketData;
+    TickStore marketData;
+    RollingIndicatorEngine signalIndicators({2, 3});
+    TickIndex rangeIndex;
     OrderManager orderManager;
     RiskManager riskManager(5000.0, 25000.0);
     ExchangeManager exchangeManager;
     
-    if (!loadData(marketData)) {
+    // Orders and positions from earlier sessions come back from the journal
+    OrderJournal journal;
+    if (journal.open(journalPath)) {
+        JournalReplayStats recovered = journal.replay(orderManager, riskManager);
+        orderManager.attachJournal(&journal);
+        riskManager.attachJournal(&journal);
+        std::cout << "Recovered " << recovered.orders << " orders and " << recovered.positions
+                  << " position updates from " << journalPath << " in " << recovered.nanos / 1000 << "us" << std::endl;
+    } else {
+        std::cout << "Warning: Could not open order journal " << journalPath << ", orders will not survive a restart"
+                  << std::endl;
+    }
+    
+    // An ITCH capture brings its own books; trade-only files get the depth their trades imply
+    OrderBookManager orderBooks(marketData.symbolTable());
+    if (!loadData(marketData, orderBooks, dataPath)) {
         std::cout << "Error: Could not load market data!" << std::endl;
         return 1;
     }
     
     std::cout << "Loaded " << marketData.size() << " records successfully!" << std::endl;
     riskManager.updateMarketPrices(marketData);
+    riskManager.attachOrderBooks(&orderBooks);
     
     while (true) {
+        AsyncLogger::instance().flush();  // finish pending log lines before redrawing the menu
         std::cout << "\n======= HFT Trading Platform =======" << std::endl;
         std::cout << exchangeManager.getStatus() << std::endl;
         std::cout << "\n--- MARKET ANALYSIS ---" << std::endl;
@@ -179,30 +276,32 @@ int main() {
         std::cout << "2. View MSFT price data" << std::endl;
         std::cout << "3. Get AAPL trading signal" << std::endl;
         std::cout << "4. Get MSFT trading signal" << std::endl;
+        std::cout << "5. Query symbol time range (VWAP/TWAP)" << std::endl;
         
         std::cout << "\n--- SIMULATED TRADING ---" << std::endl;
-        std::cout << "5. Place simulated order (with risk check)" << std::endl;
-        std::cout << "6. View all simulated orders" << std::endl;
-        std::cout << "7. View orders by symbol" << std::endl;
-        std::cout << "8. View current positions & P&L" << std::endl;
-        std::cout << "9. View risk exposure" << std::endl;
+        std::cout << "6. Place simulated order (with risk check)" << std::endl;
+        std::cout << "7. View all simulated orders" << std::endl;
+        std::cout << "8. View orders by symbol" << std::endl;
+        std::cout << "9. View current positions & P&L" << std::endl;
+        std::cout << "10. View risk exposure" << std::endl;
         
         std::cout << "\n--- PERFORMANCE ---" << std::endl;
-        std::cout << "10. Run basic performance benchmarks" << std::endl;
-        std::cout << "11. Run advanced HFT optimizations" << std::endl;
-        std::cout << "12. 🔍 VERIFY Multi-Core Threading" << std::endl;
+        std::cout << "11. Run basic performance benchmarks" << std::endl;
+        std::cout << "12. ⏱️ Trace tick-to-trade latency" << std::endl;
+        std::cout << "13. Run advanced HFT optimizations" << std::endl;
+        std::cout << "14. 🔍 VERIFY Multi-Core Threading" << std::endl;
         
         std::cout << "\n--- LIVE TRADING ---" << std::endl;
-        std::cout << "13. Get live market price" << std::endl;
-        std::cout << "14. Connect to exchange" << std::endl;
-        std::cout << "15. View live account balance" << std::endl;
-        std::cout << "16. Place LIVE order (REAL MONEY)" << std::endl;
+        std::cout << "15. Get live market price" << std::endl;
+        std::cout << "16. Connect to exchange" << std::endl;
+        std::cout << "17. View live account balance" << std::endl;
+        std::cout << "18. Place LIVE order (REAL MONEY)" << std::endl;
         
         std::cout << "\n--- TESTING & DEPLOYMENT ---" << std::endl;
-        std::cout << "17. 🧪 Run quick system tests" << std::endl;
-        std::cout << "18. 🧪 Run full test suite" << std::endl;
-        std::cout << "19. Exit" << std::endl;
-        std::cout << "Choose option (1-19): ";
+        std::cout << "19. 🧪 Run quick system tests" << std::endl;
+        std::cout << "20. 🧪 Run full test suite" << std::endl;
+        std::cout << "21. Exit" << std::endl;
+        std::cout << "Choose option (1-21): ";
         
         int choice = getValidChoice();
         
@@ -214,66 +313,86 @@ int main() {
                 showPriceData(marketData, "MSFT");
                 break;
             case 3:
-                generateSignal(marketData, "AAPL");
+                generateSignal(signalIndicators, marketData, "AAPL");
                 break;
             case 4:
-                generateSignal(marketData, "MSFT");
+                generateSignal(signalIndicators, marketData, "MSFT");
                 break;
             case 5:
-                placeOrderWithRiskCheck(orderManager, riskManager, marketData);
+                queryTimeRange(rangeIndex, marketData);
                 break;
             case 6:
+                placeOrderWithRiskCheck(orderManager, riskManager, marketData);
+                break;
+            case 7:
                 orderManager.showAllOrders();
                 break;
-            case 7: {
+            case 8: {
                 std::string symbol;
                 std::cout << "Enter symbol (AAPL/MSFT): ";
                 std::getline(std::cin, symbol);
                 orderManager.showOrdersForSymbol(symbol);
                 break;
             }
-            case 8:
+            case 9:
                 riskManager.updateMarketPrices(marketData);
                 riskManager.showPositions();
                 break;
-            case 9: {
-                double exposure = riskManager.getTotalExposure();
+            case 10: {
+                double exposure = riskManager.getTotalExposure().toDouble();
                 std::cout << "\n💰 Total Portfolio Exposure: $" << exposure << std::endl;
                 break;
             }
-            case 10:
+            case 11:
                 std::cout << "\n🚀 Running Basic Performance Benchmarks..." << std::endl;
                 PerformanceMonitor::measureDataLoad();
                 PerformanceMonitor::measureSignalGeneration();
                 PerformanceMonitor::measureOrderPlacement();
                 break;
-            case 11:
+            case 12:
+                PerformanceMonitor::traceTickToTrade();
+                break;
+            case 13:
                 std::cout << "\n⚡ Running Advanced HFT Optimizations..." << std::endl;
                 PerformanceMonitor::measureCPUAffinity();
                 PerformanceMonitor::measureCacheOptimization();
+                PerformanceMonitor::measureIndicatorKernels();
+                PerformanceMonitor::measureOrderBook();
+                PerformanceMonitor::measureL3Replay();
+                PerformanceMonitor::measureOrderManager();
+                PerformanceMonitor::measureOrderIds();
+                PerformanceMonitor::measureOrderJournal();
+                PerformanceMonitor::measureItchDecode();
+                PerformanceMonitor::measureReplayJitter();
+                PerformanceMonitor::measureBarAggregation();
+                PerformanceMonitor::measureRangeQueries();
+                PerformanceMonitor::measureTickLoader();
+                PerformanceMonitor::measureBinaryTickLoad();
+                PerformanceMonitor::measureTickArchive();
+                PerformanceMonitor::measureParallelTickLoad();
                 break;
-            case 12:
+            case 14:
                 PerformanceMonitor::verifyMultiThreading();
                 break;
-            case 13:
+            case 15:
                 getLiveMarketPrice(exchangeManager);
                 break;
-            case 14:
+            case 16:
                 connectToExchange(exchangeManager);
                 break;
-            case 15:
+            case 17:
                 exchangeManager.showAccountBalance();
                 break;
-            case 16:
+            case 18:
                 placeLiveOrder(exchangeManager, riskManager);
                 break;
-            case 17:
+            case 19:
                 TestRunner::runQuickTests();
                 break;
-            case 18:
+            case 20:
                 TestRunner::runAllTests();
                 break;
-            case 19:
+            case 21:
                 std::cout << "Goodbye!" << std::endl;
                 return 0;
             default: